@@ -268,8 +268,9 @@
 #define PROCESS_CHECK_BUTTONS 11
 #define PROCESS_MISC_ADMIN 12
 #define PROCESS_DEBUG 13
+#define PROCESS_SATELLITE_CALC 14
 
-#define PROCESS_TABLE_SIZE 14
+#define PROCESS_TABLE_SIZE 15
 
 #define COORDINATE_PLANE_NORMAL 0
 #define COORDINATE_PLANE_UPPER_LEFT_ORIGIN 1
@@ -288,6 +289,23 @@
 // #define UPDATE_CURRENT_SAT_JUST_AZ_EL 3  //****
 #define UPDATE_SAT_ARRAY_SLOT_AZ_EL_NEXT_AOS_LOS 4
 #define UPDATE_SAT_ARRAY_SLOT_JUST_AZ_EL 5
+#define UPDATE_SAT_ARRAY_SLOT_NEXT_PASS 6
+
+#define SATELLITE_VISIBILITY_PASSES 0
+#define SATELLITE_VISIBILITY_NEVER 1
+#define SATELLITE_VISIBILITY_ALWAYS 2
+
+#define EPHEMERIS_CACHE_SPAN_SECS (86400L + EPHEMERIS_CACHE_OVERLAP_SECS)
+#define OBSERVER_MOVED_TOLERANCE_DEGREES 0.01  // about 1 km; the sun and moon move well under a thousandth of a degree for that
+
+#define SUN_MOON_EVENT_NONE 0
+#define SUN_MOON_EVENT_RISE 1
+#define SUN_MOON_EVENT_SET 2
+#define SUN_MOON_EVENT_TRANSIT 3
+
+// smoothing factor (percent) as a fraction of 2^23, for the integer heading pipeline
+#define AZIMUTH_SMOOTHING_WEIGHT ((long)((AZIMUTH_SMOOTHING_FACTOR * 83886.08) + 0.5))
+#define ELEVATION_SMOOTHING_WEIGHT ((long)((ELEVATION_SMOOTHING_FACTOR * 83886.08) + 0.5))
 
 #define DO_NOT_INCLUDE_RESPONSE_CODE 0
 #define INCLUDE_RESPONSE_CODE 1
@@ -337,4 +355,26 @@
 #define MASTER_REMOTE_LINK_DOWN 0
 #define MASTER_REMOTE_LINK_UP 1
 
+#define CORRECTION_TABLE_AZIMUTH 0
+#define CORRECTION_TABLE_ELEVATION 1
+
+#define CORRECTION_TABLE_EEPROM_MAGIC 0xC5
+#define CORRECTION_TABLE_EEPROM_HEADER_SIZE 3       // magic, point count, checksum
+#define CORRECTION_TABLE_EEPROM_POINT_SIZE 8        // from and to, centidegrees, 4 bytes each
+
+#define KEEP_EEPROM_CORRECTION_TABLE 0
+#define REVERT_TO_COMPILED_CORRECTION_TABLE 1
+
+#define POTENTIOMETER_SAMPLER_AZIMUTH 0
+#define POTENTIOMETER_SAMPLER_ELEVATION 1
+
+#define HEADING_ESTIMATE_MIN_INTERVAL_MS 50          // update_heading_estimate() skips readings closer together than this
+#define HEADING_ESTIMATE_MAX_INTERVAL_MS 2000        // and starts over from the reading when they're further apart
+
+#define INCREMENTAL_ENCODER_PHASE_A 2
+#define INCREMENTAL_ENCODER_PHASE_B 1
+#define INCREMENTAL_ENCODER_PHASE_Z 4
+#define INCREMENTAL_ENCODER_PHASES_AB 3
+#define INCREMENTAL_ENCODER_MISSED_TRANSITION 2     // in incremental_encoder_transition[]
+
 /* ------end of macros ------- */
\ No newline at end of file
@@ -43,6 +43,7 @@
 // #define DEBUG_EL_POSITION_INCREMENTAL_ENCODER
 // #define DEBUG_MOON_TRACKING
 // #define DEBUG_SUN_TRACKING
+// #define DEBUG_TRACKING_LEAD
 // #define DEBUG_GPS
 // #define DEBUG_GPS_SERIAL
 // #define DEBUG_OFFSET
@@ -71,8 +72,7 @@
 // #define DEBUG_SATELLITE_TRACKING
 // #define DEBUG_SATELLITE_TRACKING_LOAD
 // #define DEBUG_SATELLITE_TRACKING_CALC
-// #define DEBUG_SATELLITE_TRACKING_CALC_STAGE_2
-// #define DEBUG_SATELLITE_TRACKING_CALC_STAGE_3
+// #define DEBUG_SATELLITE_TRACKING_CALC_SEARCH
 // #define DEBUG_SATELLITE_SERVICE
 // #define DEBUG_SATELLITE_TLE_EEPROM
 // #define DEBUG_SATELLITE_ARRAY_ORDER
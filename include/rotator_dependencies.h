@@ -146,6 +146,10 @@
   #error "FEATURE_SATELLITE_TRACKING requires FEATURE_CLOCK"
 #endif
 
+#if defined(FEATURE_SATELLITE_TLE_CATALOG_SD) && !defined(FEATURE_SATELLITE_TRACKING)
+  #error "FEATURE_SATELLITE_TLE_CATALOG_SD requires FEATURE_SATELLITE_TRACKING"
+#endif
+
 #if defined(FEATURE_GPS) && !defined(OPTION_GPS_USE_TINY_GPS_LIBRARY) && !defined(OPTION_GPS_USE_SPARKFUN_U_BLOX_GNSS_LIBRARY)
   #error "FEATURE_GPS requires either OPTION_GPS_USE_TINY_GPS_LIBRARY or OPTION_GPS_USE_SPARKFUN_U_BLOX_GNSS_LIBRARY"
 #endif
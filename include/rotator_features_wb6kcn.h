@@ -23,6 +23,7 @@
 // #define FEATURE_TEST_DISPLAY_AT_STARTUP  
 
 // #define FEATURE_SATELLITE_TRACKING  // https://github.com/k3ng/k3ng_rotator_controller/wiki/707-Satellite-Tracking
+// #define FEATURE_SATELLITE_TLE_CATALOG_SD  // keep the TLE file on an SD card rather than in EEPROM (requires SD library); catalog can be far larger than SATELLITE_LIST_LENGTH
 
 #define LANGUAGE_ENGLISH         // all languages customized in rotator_language.h
 // #define LANGUAGE_SPANISH
@@ -41,6 +42,7 @@
 // #define FEATURE_MASTER_WITH_ETHERNET_SLAVE     // [master]<-------------------ethernet--------------------->[slave]
 
 //#define FEATURE_ADC_RESOLUTION12   // 12 bit ADC resolution for Teensy 3.x, Arduino Due Zero MKR families 
+//#define FEATURE_ADC_RESOLUTION14   // 14 bit ADC resolution for Arduino UNO R4
 
 /* position sensors - pick one for azimuth and one for elevation if using an az/el rotator */
 // #define FEATURE_AZ_POSITION_POTENTIOMETER   //this is used for both a voltage from a rotator control or a homebrew rotator with a potentiometer
@@ -159,6 +161,7 @@
 
 // #define FEATURE_POWER_SWITCH
 // #define OPTION_EXTERNAL_ANALOG_REFERENCE  //Activate external analog voltage reference (needed for RemoteQTH.com unit)
+// #define OPTION_POTENTIOMETER_ADC_OVERSAMPLING  // potentiometer position sensors: sample continuously in the background, oversample, and median filter (settings POTENTIOMETER_OVERSAMPLING_SAMPLES, POTENTIOMETER_MEDIAN_LENGTH)
 // #define OPTION_SYNC_MASTER_CLOCK_TO_SLAVE        // use when GPS unit is connected to slave unit and you want to synchronize the master unit clock to the slave unit GPS clock
 // #define OPTION_SYNC_MASTER_COORDINATES_TO_SLAVE  // use when GPS unit is connected to slave unit and you want to synchronize the master unit coordinates to the slave unit GPS
 // #define OPTION_DISABLE_HMC5883L_ERROR_CHECKING
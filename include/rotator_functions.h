@@ -5,11 +5,13 @@ void initialize_serial();
 
 void initialize_peripherals();
 
+unsigned int eeprom_end();
 void read_settings_from_eeprom();
 
 void initialize_pins();
 
 void read_azimuth(byte force_read);
+void update_heading_estimate(struct heading_estimate &estimate, float measurement, unsigned long measurement_time);
 
 #if defined(FEATURE_ELEVATION_CONTROL)
 void read_elevation(byte force_read);
@@ -68,6 +70,7 @@ int analogReadEnhanced(uint8_t pin);
 int digitalReadEnhanced(uint8_t pin);
 
 void submit_request(byte axis, byte request, float parm, byte called_by);
+float slow_down_distance(byte axis);
 
 void initialize_eeprom_with_defaults();
 
@@ -112,11 +115,43 @@ char* coordinates_to_maidenhead(float latitude, float longitude);
 #if defined(FEATURE_MOON_TRACKING)
 void service_moon_tracking();
 void update_moon_position();
+#if !defined(OPTION_USE_OLD_TIME_CODE)
+byte moon_position_at(time_t when, double &position_azimuth, double &position_elevation);
+byte moon_position_calculated_at(time_t when, double &position_azimuth, double &position_elevation);
+#endif
 #endif
 
 #if defined(FEATURE_SUN_TRACKING)
 void service_sun_tracking();
 void update_sun_position();
+#if !defined(OPTION_USE_OLD_TIME_CODE)
+byte sun_position_at(time_t when, double &position_azimuth, double &position_elevation);
+byte sun_position_calculated_at(time_t when, double &position_azimuth, double &position_elevation);
+#endif
+#endif
+
+#if (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING) || defined(FEATURE_SATELLITE_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
+void set_astro_time(astro_time &time_to_set, time_t when);
+void update_astro_time();
+astro_time& astro_time_at(time_t when);
+#endif
+
+#if (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
+byte ephemeris_cache_position(ephemeris_cache &cache, byte (*position_calculated_at)(time_t, double&, double&), time_t when, double &position_azimuth, double &position_elevation);
+void fit_ephemeris_cache(ephemeris_cache &cache, byte (*position_calculated_at)(time_t, double&, double&), time_t start);
+double chebyshev_sum(float coefficients[], double x);
+byte observer_moved_from(double fit_latitude, double fit_longitude);
+void service_sun_moon_events(sun_moon_events &events, byte (*position_calculated_at)(time_t, double&, double&), float elevation_minimum);
+byte sun_moon_waiting_for_rise(sun_moon_events &events, double elevation_now, float elevation_minimum);
+char* sun_moon_event_string(time_t event_time);
+void sun_moon_event_not_found_string(char * return_string, sun_moon_events &events);
+void sun_moon_events_string(char * return_string, sun_moon_events &events);
+#endif
+
+#if (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING) || defined(FEATURE_SATELLITE_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
+void measure_tracking_lead_axis(tracking_lead_axis &axis, byte rotating, byte at_speed, struct heading_estimate &estimate);
+void service_tracking_lead();
+byte tracking_lead_position(byte (*position_at)(time_t, double&, double&), double &target_azimuth, double &target_elevation);
 #endif
 
 #if defined(FEATURE_ETHERNET)
@@ -174,11 +209,62 @@ void check_limit_sense();
 #endif
 
 #if defined(FEATURE_AZIMUTH_CORRECTION)
-float correct_azimuth(float azimuth_in);
+long correct_azimuth_centidegrees(long raw_centidegrees);
 #endif
 
 #if defined(FEATURE_ELEVATION_CORRECTION)
-float correct_elevation(float elevation_in);
+long correct_elevation_centidegrees(long centidegrees);
+#endif
+
+#if defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+unsigned int correction_table_eeprom_address(byte table);
+byte correction_table_eeprom_max_points(byte table);
+long correction_table_eeprom_read_long(unsigned int address);
+void correction_table_eeprom_write_byte(unsigned int address, byte byte_to_write);
+void correction_table_eeprom_write_long(unsigned int address, long value);
+byte correction_table_eeprom_checksum(byte table, byte points);
+byte correction_table_eeprom_valid(byte table);
+byte correction_table_points(byte table, byte in_eeprom);
+void correction_table_point(byte table, byte in_eeprom, byte point, long * from_centidegrees, long * to_centidegrees);
+void build_correction_lut(byte table);
+void initialize_correction_tables();
+long correct_centidegrees(struct correction_lut_state * lut, long lut_to[], long centidegrees);
+byte add_correction_table_point(byte table, long from_centidegrees, long to_centidegrees);
+void clear_correction_table(byte table, byte revert_to_compiled_table);
+void print_correction_table(byte table);
+byte parse_correction_table_point(byte input_buffer[], int input_buffer_index, long * from_centidegrees, long * to_centidegrees);
+#endif
+
+#if defined(OPTION_POTENTIOMETER_ADC_OVERSAMPLING) && (defined(FEATURE_AZ_POSITION_POTENTIOMETER) || defined(FEATURE_EL_POSITION_POTENTIOMETER))
+void initialize_potentiometer_sampler();
+void potentiometer_sampler_add(byte sampler, int sample);
+int read_potentiometer_sampler(byte sampler);
+#if defined(__AVR__)
+void potentiometer_sampler_start_conversion();
+#else
+void service_potentiometer_sampler();
+#endif
+#endif
+
+#if defined(FEATURE_AZ_POSITION_INCREMENTAL_ENCODER) || defined(FEATURE_EL_POSITION_INCREMENTAL_ENCODER)
+void initialize_incremental_encoder_pins(struct incremental_encoder_pins &pins, uint8_t phase_a_pin, uint8_t phase_b_pin, uint8_t phase_z_pin);
+byte read_incremental_encoder_phases(struct incremental_encoder_pins &pins);
+#endif
+#if defined(FEATURE_AZ_POSITION_INCREMENTAL_ENCODER)
+void az_position_incremental_encoder_interrupt_handler();
+#endif
+#if defined(FEATURE_EL_POSITION_INCREMENTAL_ENCODER) && defined(FEATURE_ELEVATION_CONTROL)
+void el_position_incremental_encoder_interrupt_handler();
+#endif
+
+void convert_raw_azimuth_centidegrees_to_real_azimuth(long raw_centidegrees);
+
+#if !defined(FEATURE_CALIBRATION)
+long apply_azimuth_offset_centidegrees(long raw_centidegrees);
+#endif
+
+#if defined(FEATURE_ELEVATION_CONTROL)
+long apply_elevation_offset_centidegrees(long centidegrees);
 #endif
 
 #if (defined(OPTION_SERIAL_HELP_TEXT) || defined(FEATURE_TIMED_BUFFER)) && (defined(FEATURE_REMOTE_UNIT_SLAVE) || defined(FEATURE_YAESU_EMULATION) || defined(FEATURE_EASYCOM_EMULATION))
@@ -188,12 +274,65 @@ void print_to_port(char* string_to_print, byte port_to_print);
 #if defined(FEATURE_SATELLITE_TRACKING)
 void service_satellite_tracking(byte initialize_satellite_tracking, byte initialize);
 byte service_calc_satellite_data(byte sat_array_element, byte number_of_days_to_scan, byte command, byte print_header, byte service_calc_service_or_initialize, byte print_done, byte simulate_az_el);
+void service_calc_satellite_data_within_budget();
 void initialize_tle_file_area_eeprom(byte initialize_type);
-void load_satellite_tle_into_P13(const char* sat_name, const char* tle_line1, const char* tle_line2, byte load_hardcoded_tle, byte make_it_the_current_satellite);
+void load_satellite_tle_into_P13(const char* sat_name, const SatElements* elements, byte load_hardcoded_tle, byte make_it_the_current_satellite);
 void print_aos_los_satellite_status();
 void print_current_satellite_status();
 void warm_initialize_satellite_array();
 void clear_satellite_array();
+void invalidate_satellite_element_cache();
+void populate_satellite_element_cache();
+byte load_satellite_from_element_cache(byte satellite_array_position);
+void update_satellite_array_slot_position(int satellite_array_position,double calc_satellite_elevation,double calc_satellite_azimuth,double calc_satellite_latitude,double calc_satellite_longitude);
+void refresh_satellite_array_positions();
+byte tle_lines_valid(char* tle_line1, char* tle_line2);
+void invalidate_tle_file_directory();
+#if !defined(FEATURE_SATELLITE_TLE_CATALOG_SD)
+byte tle_file_ends_before(unsigned long limit);
+void check_tle_file_eeprom_layout();
+#endif
+byte load_tle_file_directory();
+void write_tle_file_directory();
+void seek_tle_file_eeprom(unsigned int directory_entry);
+unsigned long tle_catalog_read_packed(unsigned long location, byte bytes);
+byte get_elements_from_tle_file_eeprom(SatElements &elements);
+byte tle_name_hash(char* satellite_name);
+byte satellite_visibility(double elevation_now);
+long satellite_calc_search_step(double max_angular_rate, byte in_pass);
+void refresh_satellite_array_slot_position(int cache_entry,double calc_satellite_elevation,double calc_satellite_azimuth,double calc_satellite_latitude,double calc_satellite_longitude);
+byte satellite_element_cache_entry(byte satellite_array_position, byte* pinned_entries);
+void forget_satellite_element_cache_slot(byte satellite_array_position);
+unsigned int tle_file_directory_find(char* satellite_name);
+byte put_satellite_in_array(char* satellite_name);
+byte tle_catalog_read(unsigned long location);
+void tle_catalog_write(unsigned long location, byte byte_to_write);
+unsigned long tle_catalog_size();
+byte tle_catalog_directory_read(unsigned long location);
+void tle_catalog_directory_write(unsigned long location, byte byte_to_write);
+void tle_catalog_flush();
+#if defined(FEATURE_SATELLITE_TLE_CATALOG_SD)
+void initialize_tle_catalog();
+#endif
+#if !defined(OPTION_USE_OLD_TIME_CODE)
+void clear_satellite_passes(byte satellite_array_position);
+void expire_satellite_passes(byte satellite_array_position);
+satellite_pass* get_satellite_pass(byte satellite_array_position, byte pass_number);
+void add_satellite_pass(byte satellite_array_position, time_t aos, long los_seconds, long max_el_seconds, double aos_az, double los_az, double max_el);
+void print_satellite_pass_event(time_t event_time, int event_az);
+void clear_satellite_track();
+byte service_satellite_track();
+double catmull_rom(int p0, int p1, int p2, int p3, double u);
+byte satellite_track_position(double seconds_ahead, double &track_azimuth, double &track_elevation);
+byte satellite_position_at(time_t when, double &position_azimuth, double &position_elevation);
+void print_satellite_passes(byte satellite_array_position, byte number_of_passes);
+byte satellite_array_slot_refresh_ticks(byte satellite_array_position, double degrees_moved);
+void clear_satellite_refresh_schedule(byte satellite_array_position);
+byte next_satellite_array_slot_to_calc(byte &calc_task, byte include_timed_out);
+void update_satellite_array_order();
+byte satellite_goes_before(byte satellite_a, byte satellite_b);
+void place_satellite_in_order(byte satellite_array_position);
+#endif
 char* satellite_aos_los_string(byte satellite_array_position);
 void send_vt100_code(char* code);
 #endif
@@ -208,12 +347,12 @@ long difftime(tm* time1, tm* time2, int* days, int* hours, int* minutes, int* se
 #endif
 
 #if defined(FEATURE_CLOCK) && !defined(OPTION_USE_OLD_TIME_CODE)
-void cleartime(tmElements_t* time_struct);
-char* tm_date_string(tmElements_t* time_struct);
-char* tm_month_and_day_string(tmElements_t* time_struct);
-char* tm_time_string_short(tmElements_t* time_struct);
-char* tm_time_string_long(tmElements_t* time_struct);
-long difftime(tmElements_t* time1, tmElements_t* time2, int* days, int* hours, int* minutes, int* seconds);
+void cleartime(time_t* time_struct);
+char* tm_date_string(time_t* time_struct);
+char* tm_month_and_day_string(time_t* time_struct);
+char* tm_time_string_short(time_t* time_struct);
+char* tm_time_string_long(time_t* time_struct);
+long difftime(time_t* time1, time_t* time2, int* days, int* hours, int* minutes, int* seconds);
 #endif
 
 #endif //ROTATOR_FUNCTIONS_H
\ No newline at end of file
@@ -235,3 +235,6 @@
 #define satellite_tracking_activate_line 0
 #define satellite_tracking_button 0        // use with a normally open momentary switch to ground
 
+// Added 2026.10.17.12
+#define satellite_tle_catalog_sd_cs_pin 0  // FEATURE_SATELLITE_TLE_CATALOG_SD: SD card chip select, must be set (4 on most Ethernet shields, move lcd_4_bit_d5_pin if so)
+
@@ -257,6 +257,9 @@ You can tweak these, but read the online documentation!
  * Azimuth and Elevation calibraton tables - use with FEATURE_AZIMUTH_CORRECTION and/or FEATURE_ELEVATION_CORRECTION
  *
  * You must have the same number of entries in the _FROM_ and _TO_ arrays!
+ * The _FROM_ entries must go in increasing order.
+ *
+ * A table loaded into EEPROM with \>A and \>E is used instead of these.
  *
  */
 
@@ -351,8 +354,8 @@ You can tweak these, but read the online documentation!
 #define OPTION_SEND_STRING_OUT_CONTROL_PORT_WHEN_INITIALIZING_STRING ("test\n\r")
 
 // Added in 2020.07.19.02
-#define SUN_UPDATE_POSITION_INTERVAL_MS 5000
-#define MOON_UPDATE_POSITION_INTERVAL_MS 5000
+#define SUN_UPDATE_POSITION_INTERVAL_MS 100
+#define MOON_UPDATE_POSITION_INTERVAL_MS 100
 
 // Added in 2020.07.22.02
 #define DEFAULT_ALTITUDE_M 50
@@ -381,9 +384,80 @@ You can tweak these, but read the online documentation!
 // Added / Updated in 2020.08.29.01
 #define SATELLITE_CALC_TIMEOUT_MS 10000
 #define SATELLITE_AOS_ELEVATION_MIN 0.0
-#define SATELLITE_CALC_STAGE_1_RESOLUTION_SECS 120
-#define SATELLITE_CALC_STAGE_2_RESOLUTION_SECS 10
-#define SATELLITE_CALC_STAGE_3_RESOLUTION_SECS 1
+
+// Added in 2026.10.17.03
+#define SATELLITE_CALC_SEARCH_MAX_STEP_SECS 3600      // AOS/LOS search: longest step ahead when the satellite is far from the horizon
+#define SATELLITE_CALC_IN_PASS_MAX_STEP_SECS 120      // AOS/LOS search: longest step ahead during a pass (pass max elevation resolution)
+#define SATELLITE_CALC_SEARCH_MIN_STEP_SECS 1         // AOS/LOS search: shortest step ahead; worst case, a pass shorter than this is missed (at 1, one that rises and sets inside a second)
+#define SATELLITE_CALC_RESOLUTION_SECS 1              // AOS/LOS search: crossings are refined down to this
+
+// Added in 2026.10.17.04
+#define SATELLITE_PASS_TABLE_LENGTH 2                 // upcoming passes kept for each satellite (\% report, Nextion); 13 bytes of RAM each per satellite
+
+// Added in 2026.10.17.05
+// P13_SINGLE_PRECISION is a build flag rather than a setting here, as lib/P13 is compiled on its own: build with -D P13_SINGLE_PRECISION
+// (pio run -e uno_r4_minima_fast) to work the satellite orbit in float.  Faster on boards with only a single precision FPU, like the
+// UNO R4; pointing stays within 0.1 degree of the default double build for LEO with a week old TLE (test/native/test_p13_precision).
+
+// Added in 2026.10.17.06
+#define SATELLITE_ARRAY_AZ_EL_REFRESH_MS 1000         // az, el, lat and long of the satellites in the array that are due are recalculated together this often
+
+// Added in 2026.10.17.07
+#define SATELLITE_TRACK_KNOT_INTERVAL_SECS 10         // satellite tracking: the pass is precomputed at this interval and interpolated in between
+#define SATELLITE_TRACK_KNOTS 64                      // satellite tracking: how much of the pass is precomputed ahead (max 255); 6 bytes of RAM each
+
+// Added in 2026.10.17.08
+#define TRACKING_LEAD_MAX_SECS 30                     // moon, sun, and satellite tracking: aim up to this far ahead to make up for rotator travel time; 0 = aim at where it is now
+#define TRACKING_LEAD_SAMPLE_MS 250                   // how often the heading is sampled to measure the rotator slew rate
+#define TRACKING_LEAD_SMOOTHING 0.2                   // weight of each new slew rate / start up latency measurement (0 - 1)
+
+// Added in 2026.10.17.09
+#define SATELLITE_ARRAY_AZ_EL_REFRESH_MAX_MS 60000    // longest a satellite in the array goes between az / el refreshes when it's nowhere near AOS or LOS (max 255 x SATELLITE_ARRAY_AZ_EL_REFRESH_MS)
+#define SATELLITE_ARRAY_AZ_EL_REFRESH_DEGREES 2       // a satellite that's up is refreshed before it can move about this far
+
+// Added in 2026.10.17.12
+#if defined(FEATURE_SATELLITE_TLE_CATALOG_SD)
+#define SATELLITE_ELEMENT_CACHE_LENGTH 16             // parsed TLEs kept in RAM (64 bytes each on AVR), least recently used ones are re-read from the TLE file as needed; max 254
+#else
+#define SATELLITE_ELEMENT_CACHE_LENGTH SATELLITE_LIST_LENGTH  // one per satellite array slot so array refreshes never re-read the TLE file; smaller saves RAM but re-reads it every pass
+#endif
+#define SATELLITE_TLE_CATALOG_SD_FILE "TLE.TXT"       // FEATURE_SATELLITE_TLE_CATALOG_SD: the TLE file on the SD card
+#define SATELLITE_TLE_CATALOG_SD_DIRECTORY_FILE "TLE.DIR"   // FEATURE_SATELLITE_TLE_CATALOG_SD: its directory
+#define SATELLITE_TLE_CATALOG_SD_MAX_BYTES 4000000    // FEATURE_SATELLITE_TLE_CATALOG_SD: largest TLE file (max 16777215)
+#define SATELLITE_TLE_CATALOG_SD_DIRECTORY_LENGTH 5000  // FEATURE_SATELLITE_TLE_CATALOG_SD: most satellites in the TLE file that can be looked up (max 65534)
+
+// Added in 2026.10.17.14
+#define SATELLITE_TLE_UPLOAD_XOFF_LEVEL 1500          // \# and \* TLE file uploads: send XOFF when this many bytes are waiting to be stored (the buffer holds 2000)
+#define SATELLITE_TLE_UPLOAD_XON_LEVEL 500            // and send XON once it's down to this many
+
+// Added in 2026.10.17.16
+#define SATELLITE_CALC_BUDGET_US 4000                 // while the rotator is idle, keep stepping the AOS / LOS calculations for up to this long each time through loop() (\= changes it)
+
+// Added in 2026.10.17.17
+#define EPHEMERIS_CACHE_TERMS 12                      // Chebyshev terms per axis in the daily sun and moon position fits
+#define EPHEMERIS_CACHE_OVERLAP_SECS 3600             // each daily fit runs this far into the next day so looking ahead across midnight doesn't refit
+
+// Added in 2026.10.17.18
+#define SUN_MOON_EVENT_SEARCH_HOURS 36                // how far ahead to look for the next sun and moon rise, set, and transit (\ME, \UE); more than 24
+#define SUN_MOON_EVENT_SEARCH_STEP_SECS 600           // elevation steps in that search; a rise and set closer together than this can be missed
+#define SUN_MOON_EVENT_TRANSIT_RESOLUTION_SECS 60
+
+// Added in 2026.10.17.22
+#define AZIMUTH_CORRECTION_LUT_SIZE 96                // FEATURE_AZIMUTH_CORRECTION: the calibration table is resampled into up to this many evenly spaced points (max 255, 4 bytes of RAM each)
+#define ELEVATION_CORRECTION_LUT_SIZE 48              // FEATURE_ELEVATION_CORRECTION: same for elevation
+#define AZIMUTH_CORRECTION_EEPROM_POINTS 36           // most points in a calibration table loaded with \>A (max 255, 8 bytes of EEPROM each, taken from the end of the TLE file area)
+#define ELEVATION_CORRECTION_EEPROM_POINTS 18         // most points in a calibration table loaded with \>E
+
+// Added in 2026.10.17.23
+#define POTENTIOMETER_OVERSAMPLING_SAMPLES 16         // OPTION_POTENTIOMETER_ADC_OVERSAMPLING: ADC samples added up into each reading (4, 16, or 64; each 4x is another bit of resolution)
+#define POTENTIOMETER_MEDIAN_LENGTH 5                 // OPTION_POTENTIOMETER_ADC_OVERSAMPLING: running median of this many readings (odd, max 9) takes out spikes; AZIMUTH_SMOOTHING_FACTOR and ELEVATION_SMOOTHING_FACTOR can usually go to 0
+#define POTENTIOMETER_SAMPLE_INTERVAL_MS 2            // OPTION_POTENTIOMETER_ADC_OVERSAMPLING: boards other than AVR sample each pot at most this often, each sample is a blocking analogRead()
+
+// Added in 2026.10.17.24
+#define HEADING_ESTIMATE_ALPHA 0.35                   // position gain of the azimuth and elevation alpha-beta filters (0 to 1, higher follows the sensor more closely)
+#define HEADING_ESTIMATE_BETA 0.05                    // velocity gain (0 to 1, higher reacts faster to speed changes but passes more sensor noise into the velocity)
+#define SLOW_DOWN_BEFORE_TARGET_SECS_AZ 0             // if > 0, start slow down this many seconds out at the measured velocity, if that's further out than SLOW_DOWN_BEFORE_TARGET_AZ
+#define SLOW_DOWN_BEFORE_TARGET_SECS_EL 0             // if > 0, start slow down this many seconds out at the measured velocity, if that's further out than SLOW_DOWN_BEFORE_TARGET_EL
 
 #define NEXTION_GSC_STARTUP_DELAY 0
 
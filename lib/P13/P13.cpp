@@ -62,8 +62,40 @@ official policies, either expressed or implied, of Mark VandeWettering
 
 // Modification by Anthony Good, K3NG 2022-02-20: Added Observer.update_location function
 
+// Modification 2026-10-17: Added SatElements, Satellite.elements and Satellite.get_elements functions
+
+// Modification 2026-10-17: Satellite.predict, LL and altaz work in P13Real; greenwich hour angle at epoch worked out once in Satellite.elements
+
+// Modification 2026-10-17: Added Satellite.predict_all to predict a list of satellites for one moment
+//
+// Modification 2026-10-17: Added SatElements.packed
+//
+// Modification 2026-10-17: derive() moved to SatElements, so the derived terms are kept with the elements; Satellite.predict_all is static
+//
+// Modification 2026-10-17: Added Satellite.max_ground_rate, horizon_step and crossing_probe for the AOS / LOS search
+
 #include "P13.h"
 
+// math for the P13Real parts, so the float build doesn't get promoted back to double
+
+#if defined(P13_SINGLE_PRECISION)
+  #define P13_SIN sinf
+  #define P13_COS cosf
+  #define P13_SQRT sqrtf
+  #define P13_ASIN asinf
+  #define P13_ATAN2 atan2f
+  #define P13_FABS fabsf
+#else
+  #define P13_SIN sin
+  #define P13_COS cos
+  #define P13_SQRT sqrt
+  #define P13_ASIN asin
+  #define P13_ATAN2 atan2
+  #define P13_FABS fabs
+#endif
+
+static const P13Real P13_DEGREES = 180. / M_PI ;
+
 double
 RADIANS(double deg)
 {
@@ -111,6 +143,17 @@ fndate(int &y, int &m, int &d, long dt)
     d = dt ;
 }
 
+// greenwich hour angle (0 - 2*pi) at day number dn, fraction of day tn.  The
+// whole days are put in as WW, since WE * days = whole turns + WW * days,
+// which keeps it good even where double is only float.
+
+static P13Real
+fngha(long dn, double tn)
+{
+    double gha = radians(G0) + (dn - fnday(YG, 1, 0)) * WW + tn * WE ;
+    return fmod(gha, 2. * M_PI) ;
+}
+
 SatDateTime::SatDateTime(int year, int month, int day, int h, int m, int s) 
 {
     settime(year, month, day, h, m, s) ;
@@ -151,6 +194,17 @@ SatDateTime::settime(int year, int month, int day, int h, int m, int s)
     TN = ((double) h + m / 60. + s / 3600.) / 24. ;
 }
 
+// julian_day is the Julian day number of the UTC date (the one whose noon it is),
+// day_fraction the part of the day since 00:00 UTC.  fnday() runs 1721410 days
+// behind the Julian day number.
+
+void
+SatDateTime::setjulian(long julian_day, double day_fraction) 
+{
+    DN = julian_day - 1721410L ;
+    TN = day_fraction ;
+}
+
 void
 SatDateTime::ascii(char *buf)
 {
@@ -301,14 +355,11 @@ Satellite::~Satellite()
 }
 
 void
-Satellite::tle(const char *nm, const char *l1, const char *l2)
+SatElements::tle(const char *l1, const char *l2)
 {
-    name = nm ;
-
     // direct quantities from the orbital elements
 
-    N = getlong(l2, 2, 7) ;
-    YE = getlong(l1, 18, 20) ;
+    long YE = getlong(l1, 18, 20) ;
     if (YE < 58)
 	YE += 2000 ;
     else
@@ -325,79 +376,327 @@ Satellite::tle(const char *nm, const char *l1, const char *l2)
     MM = 2.0f * M_PI * getdouble(l2, 52, 63) ;
     RV = getlong(l2, 63, 68) ;
 
-    // derived quantities from the orbital elements 
-
     // convert TE to DE and TE 
     DE = fnday(YE, 1, 0) + (long) TE ;
     TE -= (long) TE ;
+
+    derive() ;
+}
+
+void
+Satellite::tle(const char *nm, const char *l1, const char *l2)
+{
+    SatElements el ;
+
+    N = getlong(l2, 2, 7) ;
+    YE = getlong(l1, 18, 20) ;
+    if (YE < 58)
+	YE += 2000 ;
+    else
+	YE += 1900 ;
+
+    el.tle(l1, l2) ;
+    elements(nm, el) ;
+}
+
+// START - 2026-10-17 Added
+
+void
+Satellite::elements(const char *nm, const SatElements &el)
+{
+    name = nm ;
+    load(el) ;
+
+    // greenwich hour angle at the epoch, reduced to one turn here so that predict()
+    // only has to add on the rotation since the epoch
+
+    GHAE = fngha(DE, TE) ;
+}
+
+void
+Satellite::load(const SatElements &el)
+{
+    DE = el.DE ;
+    TE = el.TE ;
+    IN = el.IN ;
+    RA = el.RA ;
+    EC = el.EC ;
+    WP = el.WP ;
+    MA = el.MA ;
+    MM = el.MM ;
+    M2 = el.M2 ;
+    RV = el.RV ;
+
+    N0 = el.N0 ;
+    A_0 = el.A_0 ;
+    B_0 = el.B_0 ;
+    QD = el.QD ;
+    WD = el.WD ;
+    DC = el.DC ;
+}
+
+void
+Satellite::get_elements(SatElements &el)
+{
+    el.DE = DE ;
+    el.TE = TE ;
+    el.IN = IN ;
+    el.RA = RA ;
+    el.EC = EC ;
+    el.WP = WP ;
+    el.MA = MA ;
+    el.MM = MM ;
+    el.M2 = M2 ;
+    el.RV = RV ;
+
+    el.N0 = N0 ;
+    el.A_0 = A_0 ;
+    el.B_0 = B_0 ;
+    el.QD = QD ;
+    el.WD = WD ;
+    el.DC = DC ;
+}
+
+static unsigned long
+getpacked(const unsigned char *p, int bytes)
+{
+    unsigned long v = 0 ;
+    while (bytes--)
+	v = (v << 8) | *p++ ;
+    return v ;
+}
+
+void
+SatElements::packed(const unsigned char *p)
+{
+    long YE = p[0] ;
+    if (YE < 58)
+	YE += 2000 ;
+    else
+	YE += 1900 ;
+
+    // day and fraction are kept apart so the fraction doesn't lose precision
+    // to the day number in single precision
+
+    DE = fnday(YE, 1, 0) + (long) getpacked(p+1, 2) ;
+    TE = getpacked(p+3, 4) / 1e8 ;
+    M2 = RADIANS(((int32_t) getpacked(p+26, 4)) / 1e8) ;
+
+    IN = RADIANS(getpacked(p+7, 3) / 1e4) ;
+    RA = RADIANS(getpacked(p+10, 3) / 1e4) ;
+    EC = getpacked(p+13, 3) / 1e7 ;
+    WP = RADIANS(getpacked(p+16, 3) / 1e4) ;
+    MA = RADIANS(getpacked(p+19, 3) / 1e4) ;
+    MM = 2.0f * M_PI * (getpacked(p+22, 4) / 1e8) ;
+    RV = getpacked(p+30, 3) ;
+
+    derive() ;
+}
+
+// END - 2026-10-17 Added
+
+void
+SatElements::derive()
+{
+    // derived quantities from the orbital elements 
+
     N0 = MM/86400 ;
     A_0 = pow(GM/(N0*N0), 1./3.) ;
     B_0 = A_0*sqrt(1.-EC*EC) ;
-    PC = RE*A_0/(B_0*B_0) ;
+    P13Real PC = RE*A_0/(B_0*B_0) ;
     PC = 1.5f*J2*PC*PC*MM ;
     double CI = cos(IN) ;
     QD = -PC*CI ;
     WD =  PC*(5*CI*CI-1)/2 ;
     DC = -2*M2/(3*MM) ;
 }
+
 void
 Satellite::predict(const SatDateTime &dt)
 {
-    long DN = dt.DN ;
-    double TN = dt.TN ;
+    // the time since epoch and the mean anomaly stay double: a LEO is good for
+    // 15 turns a day, and float runs out of bits for them within a few days
+
+    double TD = (double) (dt.DN - DE) + (dt.TN-TE) ;
+
+    propagate(TD, GHAE + (P13Real) WE * (P13Real) TD) ;
+}
+
+void
+Satellite::predict_all(const SatDateTime &dt, const Observer &obs, const SatElements *el, const unsigned char *use, int count, SatResultFunction result)
+{
+    // the greenwich hour angle depends only on the time, so it's done once
+    // here rather than from each satellite's epoch, and the derived terms come
+    // ready made with the elements, so each satellite is just load() and propagate()
+
+    Satellite work ;
+    P13Real GHAA = fngha(dt.DN, dt.TN) ;
+    double alt, az, lat, lng ;
+
+    work.name = "" ;
+
+    for (int i = 0 ; i < count ; i++) {
+	if ((use != NULL) && (!use[i]))
+	    continue ;
+	work.load(el[i]) ;
+	work.propagate((double) (dt.DN - work.DE) + (dt.TN - work.TE), GHAA) ;
+	work.altaz(obs, alt, az) ;
+	work.LL(lat, lng) ;
+	result(i, alt, az, lat, lng) ;
+    }
+}
+
+// The AOS / LOS search: step ahead with horizon_step() until a step lands on the far side of a
+// horizon crossing, then close in on it with crossing_probe().  Both only need the last predict(),
+// so the search costs one prediction per step.
 
-    float TEG = DE - fnday(YG, 1, 0) + TE ;
+double
+Satellite::max_ground_rate()
+{
+    // the fastest (radians / second) the sub-satellite point can move across the ground: the orbital
+    // angular rate at perigee plus the earth turning underneath it
+
+    double mean_motion = MM / 86400.0 ;
+    double eccentricity = EC ;
+
+    return ((mean_motion * (1.0 + eccentricity) * (1.0 + eccentricity)) / pow(1.0 - (eccentricity * eccentricity), 1.5)) + W0 ;
+}
 
-    float GHAE = radians(G0) + TEG * WE ;
-    float MRSE = radians(G0) + TEG * WW + M_PI ;
-    float MASE = radians(MAS0 + TEG * MASD) ;
+double
+Satellite::horizon_step(const Observer &obs, double max_rate, double elevation_min, int in_pass)
+{
+    // How many seconds on from the last predict() can be stepped without jumping over a horizon
+    // crossing (elevation_min, degrees) for obs, as far as the geometry goes; the caller sets its own
+    // limits on top.  max_rate is max_ground_rate().
+    //
+    // The satellite is above the horizon when the central angle between it and the observer (the
+    // angle at the earth's center) is inside the visibility circle, and that angle can't change faster
+    // than max_rate.  Within 90 degrees of the observer the central angle is convex in time, so its
+    // current rate of change is a bound as well: heading in, stepping to where the current rate would
+    // reach the circle won't overshoot it; heading out, it has to get past 90 degrees and all the way
+    // back before there can be another pass.  Inside a pass, stepping to where the current rate reaches
+    // the circle lands at or just past LOS, and heading in there's nothing to go on, so that's a day.
+
+    double satellite_radius = sqrt(S[0]*S[0] + S[1]*S[1] + S[2]*S[2]) ;
+    double cos_central_angle = (S[0]*obs.U[0] + S[1]*obs.U[1] + S[2]*obs.U[2]) / satellite_radius ;
+    double central_angle ;
+    double central_angle_rate = 0 ;
+    double visibility_circle_radius ;
+    double observer_height ;
+    double observer_offset ;
+    double escape_time ;
+    double step ;
+
+    if (cos_central_angle > 1.0)
+	cos_central_angle = 1.0 ;
+    if (cos_central_angle < -1.0)
+	cos_central_angle = -1.0 ;
+    central_angle = acos(cos_central_angle) ;
+    if (sin(central_angle) > 0.001) {
+	// d/dt of cos_central_angle, using the satellite velocity relative to the rotating earth
+	central_angle_rate = ((V[0] + W0*S[1])*obs.U[0] + (V[1] - W0*S[0])*obs.U[1] + V[2]*obs.U[2]) / satellite_radius ;
+	central_angle_rate -= cos_central_angle * (S[0]*V[0] + S[1]*V[1] + S[2]*V[2]) / (satellite_radius * satellite_radius) ;
+	central_angle_rate = -central_angle_rate / sin(central_angle) ;
+    }
+    // altaz() measures from obs.O, which is on the ellipsoid and not RE from the center along obs.U, so
+    // take the circle around the point on obs.U level with it; for elevation_min 0 that's the same
+    // horizon plane, above it the elevation can be off by the angle obs.O is off the obs.U axis as seen
+    // from the satellite, so widen the circle by that at the slant range to the circle
+    observer_height = obs.O[0]*obs.U[0] + obs.O[1]*obs.U[1] + obs.O[2]*obs.U[2] ;
+    visibility_circle_radius = acos((observer_height / satellite_radius) * cos(RADIANS(elevation_min))) - RADIANS(elevation_min) ;
+    if (elevation_min > 0) {
+	observer_offset = sqrt(fabs((obs.O[0]*obs.O[0] + obs.O[1]*obs.O[1] + obs.O[2]*obs.O[2]) - (observer_height * observer_height))) ;
+	visibility_circle_radius += (observer_offset * cos(RADIANS(elevation_min))) / (satellite_radius * sin(visibility_circle_radius)) ;
+    }
+
+    if (in_pass) {
+	if (central_angle_rate > 0)
+	    step = (visibility_circle_radius - central_angle) / central_angle_rate ;
+	else
+	    step = 86400 ;
+    } else if (central_angle < (M_PI / 2.0)) {
+	escape_time = (M_PI - central_angle - visibility_circle_radius) / max_rate ;
+	step = escape_time ;
+	if ((central_angle_rate < 0) && (((central_angle - visibility_circle_radius) / -central_angle_rate) < escape_time))
+	    step = (central_angle - visibility_circle_radius) / -central_angle_rate ;
+    } else {
+	step = (central_angle - visibility_circle_radius) / max_rate ;
+    }
+
+    return step ;
+}
+
+long
+Satellite::crossing_probe(long low, double low_elevation, long high, double high_elevation, double elevation_min, int iteration)
+{
+    // the next time (seconds) to predict inside a bracket around a horizon crossing, low on the near
+    // side and high on the far side: secant and bisection steps in turn, so it closes in fast where the
+    // elevation is near enough a straight line and at least halves the bracket every other step.
+    // Always strictly inside the bracket, so call it while high - low > 1.
 
-    double T = (double) (DN - DE) + (TN-TE) ;
-    double DT = DC * T / 2. ;
-    double KD = 1. + 4. * DT ;
-    double KDP = 1. - 7. * DT ;
+    long probe ;
+
+    if (iteration & 1)
+	probe = low + ((high - low) / 2) ;
+    else
+	probe = low + (long) ((((double) (high - low)) * ((low_elevation - elevation_min) / (low_elevation - high_elevation))) + 0.5) ;
+    if (probe <= low)
+	probe = low + 1 ;
+    if (probe >= high)
+	probe = high - 1 ;
+    return probe ;
+}
+
+void
+Satellite::propagate(double TD, P13Real GHAA)
+{
+    P13Real T = TD ;
+    P13Real DT = DC * T / 2 ;
+    P13Real KD = 1 + 4 * DT ;
+    P13Real KDP = 1 - 7 * DT ;
   
-    double M = MA + MM * T * (1. - 3. * DT) ;
-    double DR = (long) (M / (2. * M_PI)) ;
-    M -= DR * 2. * M_PI ;
-    double RN = RV + DR ;
-    double EA = M ;
+    double MD = MA + MM * TD * (1. - 3. * DT) ;
+    long DR = (long) (MD / (2. * M_PI)) ;
+    MD -= DR * 2. * M_PI ;
+    P13Real M = MD ;
+    P13Real RN = RV + DR ;
+    P13Real EA = M ;
 
-    double DNOM, C_EA, S_EA ;
+    P13Real DNOM, C_EA, S_EA ;
 
     for (;;) {
-	C_EA = cos(EA) ;
-	S_EA = sin(EA) ;
-	DNOM = 1. - EC * C_EA ;
-	double D = (EA-EC*S_EA-M)/DNOM ;
+	C_EA = P13_COS(EA) ;
+	S_EA = P13_SIN(EA) ;
+	DNOM = 1 - EC * C_EA ;
+	P13Real D = (EA-EC*S_EA-M)/DNOM ;
 	EA -= D ;
-	if (fabs(D) < 1e-5)
+	if (P13_FABS(D) < (P13Real) 1e-5)
 	    break ;
     }
 
-    double A = A_0 * KD ;
-    double B = B_0 * KD ;
+    P13Real A = A_0 * KD ;
+    P13Real B = B_0 * KD ;
     RS = A * DNOM ;
 
-    double Vx, Vy ;
-    double Sx, Sy ;
+    P13Real Vx, Vy ;
+    P13Real Sx, Sy ;
     Sx = A * (C_EA - EC) ;
     Sy = B * S_EA ;
 
     Vx = -A * S_EA / DNOM * N0 ;
     Vy =  B * C_EA / DNOM * N0 ;
 
-    double AP = WP + WD * T * KDP ;
-    double CW = cos(AP) ;
-    double SW = sin(AP) ;
+    P13Real AP = WP + WD * T * KDP ;
+    P13Real CW = P13_COS(AP) ;
+    P13Real SW = P13_SIN(AP) ;
 
-    double RAAN = RA + QD * T * KDP ;
+    P13Real RAAN = RA + QD * T * KDP ;
  
-    double CQ = cos(RAAN) ;
-    double SQ = sin(RAAN) ;
+    P13Real CQ = P13_COS(RAAN) ;
+    P13Real SQ = P13_SIN(RAAN) ;
 
-    double CI = cos(IN) ;
-    double SI = sin(IN) ;
+    P13Real CI = P13_COS(IN) ;
+    P13Real SI = P13_SIN(IN) ;
 
     // CX, CY, and CZ form a 3x3 matrix
     // that converts between orbit coordinates,
@@ -429,9 +728,8 @@ Satellite::predict(const SatDateTime &dt)
 
     // and in geocentric coordinates
 
-    double GHAA = (GHAE + WE * T) ;
-    double CG = cos(-GHAA) ;
-    double SG = sin(-GHAA) ;
+    P13Real CG = P13_COS(-GHAA) ;
+    P13Real SG = P13_SIN(-GHAA) ;
 
     S[0] = SAT[0] * CG - SAT[1] * SG ;
     S[1] = SAT[0] * SG + SAT[1] * CG ;
@@ -445,8 +743,8 @@ Satellite::predict(const SatDateTime &dt)
 void
 Satellite::LL(double &lat, double &lng)
 {
-    lat = DEGREES(asin(S[2]/RS)) ;
-    lng = DEGREES(atan2(S[1], S[0])) ;
+    lat = P13_ASIN(S[2]/RS) * P13_DEGREES ;
+    lng = P13_ATAN2(S[1], S[0]) * P13_DEGREES ;
 }
 
 void
@@ -456,18 +754,19 @@ Satellite::altaz(const Observer &obs, double &alt, double &az)
     R[0] = S[0] - obs.O[0] ;
     R[1] = S[1] - obs.O[1] ;
     R[2] = S[2] - obs.O[2] ;
-    double r = sqrt(R[0]*R[0]+R[1]*R[1]+R[2]*R[2]) ;
+    P13Real r = P13_SQRT(R[0]*R[0]+R[1]*R[1]+R[2]*R[2]) ;
     R[0] /= r ;
     R[1] /= r ;
     R[2] /= r ;
 
-    double u = R[0] * obs.U[0] + R[1] * obs.U[1] + R[2] * obs.U[2] ;
-    double e = R[0] * obs.E[0] + R[1] * obs.E[1] + R[2] * obs.E[2] ;
-    double n = R[0] * obs.N[0] + R[1] * obs.N[1] + R[2] * obs.N[2] ;
+    P13Real u = R[0] * obs.U[0] + R[1] * obs.U[1] + R[2] * obs.U[2] ;
+    P13Real e = R[0] * obs.E[0] + R[1] * obs.E[1] + R[2] * obs.E[2] ;
+    P13Real n = R[0] * obs.N[0] + R[1] * obs.N[1] + R[2] * obs.N[2] ;
 
-    az = DEGREES(atan2(e, n)) ;
-    if (az < 0.) az += 360. ;
-    alt = DEGREES(asin(u)) ;
+    P13Real a = P13_ATAN2(e, n) * P13_DEGREES ;
+    if (a < 0) a += 360 ;
+    az = a ;
+    alt = P13_ASIN(u) * P13_DEGREES ;
 }
 
 //----------------------------------------------------------------------
@@ -62,6 +62,16 @@ official policies, either expressed or implied, of Mark VandeWettering
 
 // Modification by Anthony Good, K3NG 2022-02-20: Added Observer.update_location function
 
+// Modification 2026-10-17: Added SatElements so parsed TLE elements can be cached and loaded into a Satellite without re-parsing
+
+// Modification 2026-10-17: Added P13Real so the Satellite propagation can be built single precision (P13_SINGLE_PRECISION)
+
+// Modification 2026-10-17: Added Satellite.predict_all to predict a list of satellites for one moment
+//
+// Modification 2026-10-17: Added SatElements.packed to load elements from a pre-parsed binary record
+//
+// Modification 2026-10-17: Added SatDateTime.setjulian to set the time from a Julian day number and fraction of a day
+
 //----------------------------------------------------------------------
 
 #if defined(ARDUINO) && ARDUINO >= 100
@@ -105,12 +115,27 @@ static const double SNS = sin(INS) ;
 
 //----------------------------------------------------------------------
 
+// The working precision of Satellite::predict(), LL() and altaz().  Build with
+// -D P13_SINGLE_PRECISION on processors that have a single precision FPU and
+// emulate double in software (i.e. Cortex-M4F); the orbit is then worked in
+// float, apart from the time since epoch and the mean anomaly.  Stays within a
+// few hundredths of a degree of the double build for LEO with a week old TLE.
+// On AVR double is float anyway, so it makes no difference there.
+
+#if defined(P13_SINGLE_PRECISION)
+typedef float P13Real ;
+#else
+typedef double P13Real ;
+#endif
+
+//----------------------------------------------------------------------
+
 // the original BASIC code used three variables (e.g. Ox, Oy, Oz) to
 // represent a vector quantity.  I think that makes for slightly more
 // obtuse code, so I going to collapse them into a single variable 
 // which is an array of three elements
 
-typedef double Vec3[3] ;
+typedef P13Real Vec3[3] ;
 
 //----------------------------------------------------------------------
 
@@ -124,6 +149,7 @@ public:
 	~SatDateTime() { } 
 	void add(double) ;
    	void settime(int year, int month, int day, int h, int m, int s) ;
+	void setjulian(long julian_day, double day_fraction) ;
         void gettime(int& year, int& mon, int& day, int& h, int& m, int& s) ;
         void ascii(char *) ;
 	void roundup(double) ;
@@ -147,11 +173,12 @@ public:
 
 //----------------------------------------------------------------------
 
+// The orbital elements straight out of a TLE, so a satellite can be reloaded
+// without going back to the ASCII.  tle() and packed() also work out the terms
+// derived from them, so loading a Satellite from here is just copying.
 
-class Satellite { 
-  	long N ;
-	long YE ;	
-    long DE ;
+struct SatElements {
+	long DE ;
 	double TE ;
 	double IN ;
 	double RA ;
@@ -161,6 +188,54 @@ class Satellite {
 	double MM ;
 	double M2 ;
 	double RV ;
+
+	P13Real N0, A_0, B_0 ;
+	P13Real QD, WD, DC ;
+
+	void tle(const char *l1, const char *l2) ;
+	void packed(const unsigned char *p) ;
+	void derive() ;
+} ;
+
+// Packed element record read by SatElements::packed(), all fields big endian, 
+// integers scaled from the TLE's own decimal places so nothing is lost:
+//
+//   0  1  epoch year, two digits as in the TLE
+//   1  2  epoch day of year
+//   3  4  epoch fraction of day * 1e8
+//   7  3  inclination * 1e4
+//  10  3  RAAN * 1e4
+//  13  3  eccentricity * 1e7
+//  16  3  argument of perigee * 1e4
+//  19  3  mean anomaly * 1e4
+//  22  4  mean motion (revs / day) * 1e8
+//  26  4  decay (first derivative of mean motion) * 1e8, signed
+//  30  3  revolution number
+
+#define SAT_ELEMENTS_PACKED_SIZE 33
+
+//----------------------------------------------------------------------
+
+// called by Satellite::predict_all() with the results for satellite n of the list
+
+typedef void (*SatResultFunction)(int n, double alt, double az, double lat, double lng) ;
+
+//----------------------------------------------------------------------
+
+
+class Satellite { 
+  	long N ;
+	long YE ;	
+    long DE ;
+	double TE ;
+	P13Real IN ;
+	P13Real RA ;
+	P13Real EC ;
+	P13Real WP ;
+	P13Real MA ;
+	P13Real MM ;
+	P13Real M2 ;
+	P13Real RV ;
 	double ALON ;
 	double ALAT ;
 
@@ -169,10 +244,13 @@ class Satellite {
 	// during calls to predict() 
 	// classic space/time tradeoff
 
-        double N0, A_0, B_0 ;
-        double PC ;
-        double QD, WD, DC ;
-        double RS ;
+        P13Real N0, A_0, B_0 ;
+        P13Real QD, WD, DC ;
+        P13Real RS ;
+        P13Real GHAE ;		// greenwich hour angle at epoch, 0 - 2*pi
+
+	void load(const SatElements &el) ;
+	void propagate(double TD, P13Real GHAA) ;
 
 public:
 
@@ -185,7 +263,16 @@ public:
 	Satellite(const char *name, const char *l1, const char *l2) ;
 	~Satellite() ;
         void tle(const char *name, const char *l1, const char *l2) ;
+	void elements(const char *name, const SatElements &el) ;
+	void get_elements(SatElements &el) ;
         void predict(const SatDateTime &dt) ;
+	// predict each el[i] (where use[i], or all of them if use is NULL) for the same dt, results
+	// go to result().  Works in a Satellite of its own, so any other one is left as it was.
+	static void predict_all(const SatDateTime &dt, const Observer &obs, const SatElements *el, const unsigned char *use, int count, SatResultFunction result) ;
+	// for stepping through time looking for horizon crossings (AOS / LOS), see P13.cpp
+	double max_ground_rate() ;
+	double horizon_step(const Observer &obs, double max_rate, double elevation_min, int in_pass) ;
+	static long crossing_probe(long low, double low_elevation, long high, double high_elevation, double elevation_min, int iteration) ;
  	void LL(double &lat, double &lng) ;
 	void altaz(const Observer &obs, double &alt, double &az) ;
 } ;
@@ -0,0 +1,107 @@
+#include <stdlib.h>
+#include "centidegrees.h"
+
+// --------------------------------------------------------------
+
+int32_t degrees_to_centidegrees(float degrees){
+
+  if (degrees < 0){
+    return (int32_t)((degrees * 100.0) - 0.5);
+  }
+  return (int32_t)((degrees * 100.0) + 0.5);
+
+}
+
+// --------------------------------------------------------------
+
+float centidegrees_to_degrees(int32_t centidegrees){
+
+  return centidegrees * 0.01;
+
+}
+
+// --------------------------------------------------------------
+
+int32_t map_analog_to_centidegrees(analog_heading_map &map, int analog, int analog_start, int analog_end, int32_t centidegrees_start, int32_t centidegrees_end, int32_t analog_full_scale){
+
+  // analog_full_scale is one more than the highest reading the ADC can give
+
+  int32_t scaled;
+  long long per_count;
+  long long per_count_magnitude;
+
+  // work out the scale factor again only when the calibration has changed
+  if ((analog_start != map.analog_start) || (analog_end != map.analog_end) || (centidegrees_start != map.centidegrees_start) || (centidegrees_end != map.centidegrees_end)){
+    map.analog_start = analog_start;
+    map.analog_end = analog_end;
+    map.centidegrees_start = centidegrees_start;
+    map.centidegrees_end = centidegrees_end;
+    map.centidegrees_per_count = 0;
+    map.shift = 16;
+    map.wide = 0;
+    if (analog_end != analog_start){
+      while (1){
+        per_count = ((((long long)(centidegrees_end - centidegrees_start)) << (map.shift + 1)) / (analog_end - analog_start) + 1) >> 1;  // rounded
+        map.centidegrees_per_count = per_count;
+        per_count_magnitude = (per_count < 0) ? -per_count : per_count;
+        // keep the product below in 32 bits for readings anywhere in the ADC range
+        if ((map.shift == 0) || (per_count_magnitude < (INT32_MAX / analog_full_scale))){
+          break;
+        }
+        // but not at the cost of more than half a centidegree of rounding across the ADC range
+        if (((1L << (map.shift - 1)) < analog_full_scale) && (per_count_magnitude < INT32_MAX)){
+          map.wide = 1;
+          break;
+        }
+        map.shift--;
+      }
+    }
+  }
+
+  if (map.wide){
+    return map.centidegrees_start + (int32_t)((((long long)(analog - map.analog_start) * map.centidegrees_per_count) + (1LL << (map.shift - 1))) >> map.shift);
+  }
+  scaled = (int32_t)(analog - map.analog_start) * map.centidegrees_per_count;
+  if (map.shift > 0){
+    scaled = scaled + ((int32_t)1 << (map.shift - 1));
+  }
+  return map.centidegrees_start + (scaled >> map.shift);
+
+}
+
+// --------------------------------------------------------------
+
+int32_t smooth_centidegrees(int32_t centidegrees, int32_t previous_centidegrees, int32_t smoothing_weight){
+
+  int32_t difference;
+
+  // smoothing_weight is the share of the previous reading out of 2^23 (AZIMUTH_SMOOTHING_WEIGHT or ELEVATION_SMOOTHING_WEIGHT)
+  if (centidegrees < 0){centidegrees = 0;}
+  difference = previous_centidegrees - centidegrees;
+  if (labs(difference) < 65536L){
+    // top 15 bits and bottom 8 bits of the weight separately so nothing overflows 32 bits
+    return centidegrees + ((((difference * (smoothing_weight >> 8)) + ((difference * (smoothing_weight & 0xff)) >> 8)) + 16384L) >> 15);
+  } else {  // a wild reading
+    return centidegrees + (int32_t)((((long long)difference * smoothing_weight) + 4194304L) >> 23);
+  }
+
+}
+
+// --------------------------------------------------------------
+
+int32_t wrap_centidegrees(int32_t centidegrees){
+
+  // 0 - 359.99 degrees; readings past 360 come from rotators with more than 360 degrees of rotation
+
+  if (centidegrees >= 36000){
+    while (centidegrees >= 36000){
+      centidegrees = centidegrees - 36000;
+    }
+  } else {
+    if (centidegrees < 0){
+      centidegrees = centidegrees + 36000;
+    }
+  }
+  return centidegrees;
+
+}
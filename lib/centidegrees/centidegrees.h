@@ -0,0 +1,27 @@
+#ifndef centidegrees_h
+#define centidegrees_h
+
+// The integer heading pipeline: headings in hundredths of a degree (centidegrees), with the scale factors
+// worked out ahead of time so each sensor reading is integer math.  These are the parts with no
+// configuration behind them, kept here so test/native/test_centidegrees can check them on the PC.
+// int32_t rather than long so the PC does the same 32 bit arithmetic the boards do.
+
+#include <stdint.h>
+
+struct analog_heading_map{
+  int analog_start;                       // calibration the scale factor was worked out for
+  int analog_end;
+  int32_t centidegrees_start;
+  int32_t centidegrees_end;
+  int32_t centidegrees_per_count;         // scaled up by 2^shift
+  uint8_t shift;
+  uint8_t wide;                           // the product needs 64 bits (only for the widest ADC readings)
+};
+
+int32_t degrees_to_centidegrees(float degrees);
+float centidegrees_to_degrees(int32_t centidegrees);
+int32_t map_analog_to_centidegrees(analog_heading_map &map, int analog, int analog_start, int analog_end, int32_t centidegrees_start, int32_t centidegrees_end, int32_t analog_full_scale);
+int32_t smooth_centidegrees(int32_t centidegrees, int32_t previous_centidegrees, int32_t smoothing_weight);
+int32_t wrap_centidegrees(int32_t centidegrees);
+
+#endif
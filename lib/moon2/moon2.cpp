@@ -4,6 +4,8 @@
 #include <string.h>
 #include <ctype.h>
 
+#include "moon2.h"
+
 // Translated from the WSJT Fortran code by Pete VE5VA
 
 /////////////////////////////////////////////////////////
@@ -149,6 +151,31 @@ void moon2(int y,int m,int Day,
         double *topRA,double *topDec,
         double *LST,double *HA,
         double *Az,double *El,double *dist)
+{
+  double d,Ms,ws,Ls,GMST0;
+
+  //Note the use of 'L' to force 32-bit integer arithmetic here. 
+  d=367L*y - 7L*(y+(m+9L)/12L)/4L + 275L*m/9L + Day - 730530L + UT/24.;
+
+  //  Local sidereal time from the mean longitude of the sun
+  Ms = fmod(356.0470 + 0.9856002585 * d + 3600000.,360.);
+  ws = 282.9404 + 4.70935e-5*d;
+  Ls = fmod(Ms + ws + 720.,360.);
+  GMST0 = (Ls + 180.)/15.;
+  *LST = fmod(GMST0+UT+lon/15.+48.,24.)    ;//LST in hours
+
+  moon2_days(d,*LST,lat,RA,Dec,topRA,topDec,HA,Az,El,dist);
+}
+
+// 2026-10-17: moon2() split in two so a caller that already has the days from 2000 Jan 0.0 UT
+// (JD 2451543.5) and the local sidereal time (hours) can skip the calendar arithmetic
+void moon2_days(double d,
+        double LST,
+        double lat,
+        double *RA,double *Dec,
+        double *topRA,double *topDec,
+        double *HA,
+        double *Az,double *El,double *dist)
 {
   // The strange position of some of the semicolons is because some
   // of this was translated using a TCL script that I wrote - it isn't
@@ -164,7 +191,6 @@ void moon2(int y,int m,int Day,
   double EE                           ;//Eccentric anomaly
   double ecl                          ;//Obliquity of the ecliptic
 
-  double d                            ;//Ephemeris time argument in days
   double r                            ;//Distance to sun, AU
   double xv,yv                        ;//x and y coords in ecliptic
   double lonecl,latecl                ;//Ecliptic long and lat of moon
@@ -180,7 +206,7 @@ void moon2(int y,int m,int Day,
   //  double lat,lon                      ;//Station coordinates on earth
   double gclat                        ;//Geocentric latitude
   double rho                          ;//Earth radius factor
-  double GMST0; //,LST,HA;
+  //  double GMST0,LST,HA;
   double g;
   //  double topRA,topDec                 ;//Topocentric coordinates of Moon
   //  double Az,El;
@@ -189,8 +215,6 @@ void moon2(int y,int m,int Day,
   double rad = 57.2957795131,twopi = 6.283185307,pi,pio2;
   //      data rad/57.2957795131d0/,twopi/6.283185307d0/
 
-  //Note the use of 'L' to force 32-bit integer arithmetic here. 
-  d=367L*y - 7L*(y+(m+9L)/12L)/4L + 275L*m/9L + Day - 730530L + UT/24.;
   ecl = 23.4393 - 3.563e-7 * d;
 
 //Serial.print("d = ");
@@ -308,15 +332,14 @@ void moon2(int y,int m,int Day,
   //      alt_topoc = alt_geoc - mpar*cos(alt_geoc);
   gclat = lat - 0.1924 * sin(2.*lat/rad);
   rho = 0.99883 + 0.00167 * cos(2.*lat/rad);
-  GMST0 = (Ls + 180.)/15.;
-  *LST = fmod(GMST0+UT+lon/15.+48.,24.)    ;//LST in hours
-
-  *HA = 15. * *LST - *RA                          ;//HA in degrees
+  *HA = 15. * LST - *RA                           ;//HA in degrees
   g = rad*atan(tan(gclat/rad)/cos(*HA/rad));
   *topRA = *RA - mpar*rho*cos(gclat/rad)*sin(*HA/rad)/cos(*Dec/rad);
-  *topDec = *Dec - mpar*rho*sin(gclat/rad)*sin((g-*Dec)/rad)/sin(g/rad);
+  // 2026-10-17: on the equator g is 0 and the general formula is 0 / 0, so use Schlyter's one for that case
+  if(gclat == 0.) *topDec = *Dec - mpar*rho*sin(-*Dec/rad)*cos(*HA/rad);
+  else *topDec = *Dec - mpar*rho*sin(gclat/rad)*sin((g-*Dec)/rad)/sin(g/rad);
 
-  *HA = 15. * *LST - *topRA                       ;//HA in degrees
+  *HA = 15. * LST - *topRA                        ;//HA in degrees
   if(*HA > 180.) *HA=*HA-360.;
   if(*HA < -180.) *HA=*HA+360.;
 
@@ -7,3 +7,11 @@ void moon2(int y,int m,int Day,
   double *topRA,double *topDec,
   double *LST,double *HA,
   double *Az,double *El,double *dist);
+
+void moon2_days(double d,
+  double LST,
+  double lat,
+  double *RA,double *Dec,
+  double *topRA,double *topDec,
+  double *HA,
+  double *Az,double *El,double *dist);
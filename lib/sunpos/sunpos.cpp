@@ -8,14 +8,7 @@ void sunpos(cTime udtTime,cLocation udtLocation, cSunCoordinates *udtSunCoordina
   // Main variables
   double dElapsedJulianDays;
   double dDecimalHours;
-  double dEclipticLongitude;
-  double dEclipticObliquity;
-  double dRightAscension;
-  double dDeclination;
-
-  // Auxiliary variables
-  double dY;
-  double dX;
+  double dLocalMeanSiderealTime;
 
 
 
@@ -69,6 +62,34 @@ void sunpos(cTime udtTime,cLocation udtLocation, cSunCoordinates *udtSunCoordina
 
   */
 
+  // Calculate local mean sidereal time in radians
+  {
+    double dGreenwichMeanSiderealTime;
+    dGreenwichMeanSiderealTime = 6.6974243242 + 
+      0.0657098283*dElapsedJulianDays 
+      + dDecimalHours;
+    dLocalMeanSiderealTime = (dGreenwichMeanSiderealTime*15 
+      + udtLocation.dLongitude)*RAD_SUNPOS;
+  }
+
+  sunpos_elapsed(dElapsedJulianDays, dLocalMeanSiderealTime, udtLocation, udtSunCoordinates);
+}
+
+// 2026-10-17: sunpos() split in two so a caller that already has the elapsed Julian days (from JD 2451545.0)
+// and the local mean sidereal time (radians) can skip the calendar arithmetic
+
+void sunpos_elapsed(double dElapsedJulianDays, double dLocalMeanSiderealTime, cLocation udtLocation, cSunCoordinates *udtSunCoordinates)
+{
+  // Main variables
+  double dEclipticLongitude;
+  double dEclipticObliquity;
+  double dRightAscension;
+  double dDeclination;
+
+  // Auxiliary variables
+  double dY;
+  double dX;
+
   // Calculate ecliptic coordinates (ecliptic longitude and obliquity of the 
   // ecliptic in radians but without limiting the angle to be less than 2*Pi 
   // (i.e., the result may be greater than 2*Pi)
@@ -101,19 +122,12 @@ void sunpos(cTime udtTime,cLocation udtLocation, cSunCoordinates *udtSunCoordina
 
   // Calculate local coordinates ( azimuth and zenith angle ) in degrees
   {
-    double dGreenwichMeanSiderealTime;
-    double dLocalMeanSiderealTime;
     double dLatitudeInRadians;
     double dHourAngle;
     double dCos_Latitude;
     double dSin_Latitude;
     double dCos_HourAngle;
     double dParallax;
-    dGreenwichMeanSiderealTime = 6.6974243242 + 
-      0.0657098283*dElapsedJulianDays 
-      + dDecimalHours;
-    dLocalMeanSiderealTime = (dGreenwichMeanSiderealTime*15 
-      + udtLocation.dLongitude)*RAD_SUNPOS;
     dHourAngle = dLocalMeanSiderealTime - dRightAscension;
     dLatitudeInRadians = udtLocation.dLatitude*RAD_SUNPOS;
     dCos_Latitude = cos( dLatitudeInRadians );
@@ -34,6 +34,7 @@ struct cSunCoordinates
 };
 
 void sunpos(cTime udtTime, cLocation udtLocation, cSunCoordinates *udtSunCoordinates);
+void sunpos_elapsed(double dElapsedJulianDays, double dLocalMeanSiderealTime, cLocation udtLocation, cSunCoordinates *udtSunCoordinates);
 
 #endif
 
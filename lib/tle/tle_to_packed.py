@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+#
+# tle_to_packed.py
+#
+# Convert a bare three line TLE file (like nasabare.txt) into the packed binary records
+# the rotator controller stores in its TLE file, for uploading with the \* command.
+#
+#   python3 tle_to_packed.py nasabare.txt nasabare.bin
+#
+# then issue \* and send nasabare.bin as a raw binary file within 20 seconds.
+#
+# Each record is:
+#
+#   0xFD, name length, name, 33 bytes of elements (see SatElements::packed() in lib/P13/P13.h), checksum
+#
+# where the checksum is the low byte of the sum of the 33 element bytes.  The file ends with 0xFF.
+# A packed record is 53 bytes for a 16 character name versus 160 odd for the TLE text.
+
+import sys
+from decimal import Decimal
+
+RECORD_MARKER = 0xFD
+END_OF_FILE = 0xFF
+MAX_NAME_LENGTH = 16  # SATELLITE_NAME_LENGTH - 1
+
+
+def scaled(text, scale):
+    return int((Decimal(text.strip()) * scale).to_integral_value())
+
+
+def packed_bytes(value, length, signed=False):
+    return value.to_bytes(length, 'big', signed=signed)
+
+
+def lines_valid(l1, l2):
+    # same checks as tle_lines_valid() in the controller
+    if len(l1) < 44 or len(l2) < 68:
+        return False
+    if l1[0] != '1' or l1[7] != 'U' or l2[0] != '2':
+        return False
+    if l1[17] != ' ' or l1[23] != '.' or l1[32] != ' ' or l1[34] != '.' or l1[43] != ' ':
+        return False
+    if l2[7] != ' ' or l2[11] != '.' or l2[16] != ' ' or l2[20] != '.' or l2[25] != ' ':
+        return False
+    if l2[33] != ' ' or l2[37] != '.' or l2[42] != ' ' or l2[46] != '.' or l2[51] != ' ' or l2[54] != '.':
+        return False
+    return True
+
+
+def pack_record(name, l1, l2):
+    name = name.strip().upper()[:MAX_NAME_LENGTH].rstrip()
+    day, fraction = l1[20:32].strip().split('.')
+    elements = b''.join([
+        packed_bytes(int(l1[18:20]), 1),
+        packed_bytes(int(day), 2),
+        packed_bytes(scaled('0.' + fraction, 10**8), 4),
+        packed_bytes(scaled(l2[8:16], 10**4), 3),
+        packed_bytes(scaled(l2[17:25], 10**4), 3),
+        packed_bytes(int(l2[26:33]), 3),
+        packed_bytes(scaled(l2[34:42], 10**4), 3),
+        packed_bytes(scaled(l2[43:51], 10**4), 3),
+        packed_bytes(scaled(l2[52:63], 10**8), 4),
+        packed_bytes(scaled(l1[33:43], 10**8), 4, signed=True),
+        packed_bytes(int(l2[63:68]), 3),
+    ])
+    encoded_name = name.encode('ascii')
+    return bytes([RECORD_MARKER, len(encoded_name)]) + encoded_name + elements + bytes([sum(elements) & 0xFF])
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.stderr.write('usage: tle_to_packed.py tle_file.txt packed_file.bin\n')
+        return 1
+
+    with open(sys.argv[1]) as f:
+        lines = [line.rstrip('\r\n') for line in f if line.strip()]
+
+    output = bytearray()
+    records = 0
+    for x in range(0, len(lines) - 2, 3):
+        name, l1, l2 = lines[x], lines[x+1], lines[x+2]
+        if not lines_valid(l1, l2):
+            sys.stderr.write('skipping %s: TLE lines invalid\n' % name.strip())
+            continue
+        output += pack_record(name, l1, l2)
+        records += 1
+    output.append(END_OF_FILE)
+
+    with open(sys.argv[2], 'wb') as f:
+        f.write(output)
+
+    sys.stderr.write('%d satellites, %d bytes\n' % (records, len(output)))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
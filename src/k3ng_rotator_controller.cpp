@@ -1099,6 +1099,183 @@
       2023.10.06.2200
         FEATURE_AZ_POSITION_HH12_AS5045_SSI_RELATIVE: fixed bugs
 
+      2026.10.17.01
+        FEATURE_SATELLITE_TRACKING: parsed TLE elements are now cached for each satellite array slot when the list is populated, so array refreshes
+          no longer rescan the EEPROM TLE file and re-parse the TLE every time.  The cache is invalidated when the TLE file is rewritten or erased.
+        P13 library: added SatElements, Satellite.elements() and Satellite.get_elements()
+
+      2026.10.17.02
+        FEATURE_SATELLITE_TRACKING: the EEPROM TLE file area now has a directory (name hash, offset, and length of each satellite record) at the top of the area.
+          It's written at the end of the \# TLE upload and used for satellite lookups, populating the satellite list, and the \@ file listing.
+          The directory takes 144 bytes from the end of the TLE file area; a file stored by an earlier version gets a directory built at boot up,
+          unless it ran into the directory's space, in which case it's emptied at boot up with a message to load it again.
+
+      2026.10.17.03
+        FEATURE_SATELLITE_TRACKING: the next AOS / LOS calculation no longer scans ahead at fixed 120 / 10 / 1 second steps.  It steps ahead as far as
+          the satellite's distance from the observer's visibility circle and its fastest ground track speed (from the TLE mean motion) allow, then refines
+          each horizon crossing to 1 second with secant / bisection steps.  Roughly 5x fewer predictions per satellite, same AOS and LOS times.
+          Passes down to SATELLITE_CALC_SEARCH_MIN_STEP_SECS (1 second) long are found, including short grazing ones the fixed 120 second steps could miss.
+        Settings: SATELLITE_CALC_STAGE_1/2/3_RESOLUTION_SECS replaced by SATELLITE_CALC_SEARCH_MAX_STEP_SECS, SATELLITE_CALC_IN_PASS_MAX_STEP_SECS,
+          SATELLITE_CALC_SEARCH_MIN_STEP_SECS, and SATELLITE_CALC_RESOLUTION_SECS
+
+      2026.10.17.04
+        FEATURE_SATELLITE_TRACKING: each satellite in the array now keeps a small table of its upcoming passes (AOS, LOS, AOS / LOS azimuth, max elevation and
+          time of max elevation) which is topped up in the background by service_satellite_tracking() as passes expire.  The \% command prints straight from
+          the table when it holds enough passes, otherwise it falls back to searching as before.  Max elevation is now also checked at the pass midpoint.
+        FEATURE_NEXTION_DISPLAY: new API variable vSatEx (max elevation of the next pass of each satellite in the vSatNx list)
+        Settings: SATELLITE_PASS_TABLE_LENGTH
+
+      2026.10.17.05
+        P13 library: Satellite predict(), LL() and altaz() now work in P13Real, which is float when built with -D P13_SINGLE_PRECISION.  The new
+          uno_r4_minima_fast environment in platformio.ini sets this, as the R4 FPU only does single precision; uno_r4_minima stays double.  The greenwich
+          hour angle at epoch is now calculated once per TLE in derive() and is no longer rounded to float first.
+
+      2026.10.17.06
+        FEATURE_SATELLITE_TRACKING: az, el, lat, and long of all the satellites in the array are now recalculated together every SATELLITE_ARRAY_AZ_EL_REFRESH_MS
+          using the new P13 Satellite.predict_all(), rather than one satellite at a time between the AOS / LOS calculations.  The observer location is no
+          longer updated on every service_calc_satellite_data() call, only when a calculation starts.
+        P13 library: added Satellite.predict_all(); the greenwich hour angle is now worked out from whole days and the fraction of the day separately
+        Settings: SATELLITE_ARRAY_AZ_EL_REFRESH_MS
+
+      2026.10.17.07
+        FEATURE_SATELLITE_TRACKING: while tracking a satellite that's up, its pass is precomputed in the background as knots every SATELLITE_TRACK_KNOT_INTERVAL_SECS
+          and the tracking az and el are interpolated from them (cubic, on the direction vector so zenith passes work) rather than waiting on the propagation.
+          Long passes slide along the table.  Not available with OPTION_USE_OLD_TIME_CODE.
+        Settings: SATELLITE_TRACK_KNOT_INTERVAL_SECS, SATELLITE_TRACK_KNOTS
+
+      2026.10.17.08
+        FEATURE_MOON_TRACKING, FEATURE_SUN_TRACKING, FEATURE_SATELLITE_TRACKING: the rotator's slew rate and start up latency are now measured for each axis
+          while it rotates, and tracking aims at where the target will be when the rotator gets there rather than where it is now.  No lead is applied until
+          a slew rate has been measured.  Not available with OPTION_USE_OLD_TIME_CODE.
+        Settings: TRACKING_LEAD_MAX_SECS, TRACKING_LEAD_SAMPLE_MS, TRACKING_LEAD_SMOOTHING
+        Debug: DEBUG_TRACKING_LEAD
+
+      2026.10.17.09
+        FEATURE_SATELLITE_TRACKING: satellites in the array are no longer refreshed round robin.  Each one's az / el refresh is scheduled from how fast
+          it's moving while it's up and how long it is to its next AOS / LOS, from every SATELLITE_ARRAY_AZ_EL_REFRESH_MS close to a horizon crossing out to
+          SATELLITE_ARRAY_AZ_EL_REFRESH_MAX_MS for ones hours away.  Next AOS / LOS and pass table calculations go to the satellite with the soonest AOS / LOS
+          first, and satellites whose calculation timed out are only retried every SATELLITE_ARRAY_AZ_EL_REFRESH_MAX_MS.  DEBUG_SATELLITE_LIST_EXTRA_INFO shows
+          each satellite's refresh and calculation counts in the \| report.  Not available with OPTION_USE_OLD_TIME_CODE.
+        Settings: SATELLITE_ARRAY_AZ_EL_REFRESH_MAX_MS, SATELLITE_ARRAY_AZ_EL_REFRESH_DEGREES
+
+      2026.10.17.10
+        FEATURE_SATELLITE_TRACKING: the satellite array now stores next AOS and LOS as time_t rather than tmElements_t, and az and el in hundredths of a
+          degree (the other fields are int16_t so the array is the same size on 32 bit boards).  Ordering the array and the AOS / LOS countdowns are now just
+          subtractions rather than breakTime(now()) and difftime() for every satellite.  The array is 40 bytes per satellite on the Mega, down from 46.
+          Not available with OPTION_USE_OLD_TIME_CODE (the times stay as they were).
+        tm_time_string_long() and tm_month_and_day_string() no longer overrun their string buffers
+
+      2026.10.17.11
+        FEATURE_SATELLITE_TRACKING: the satellite array order (\| output, Nextion vSatNx list) is now kept up as satellites are calculated and go in and
+          out of AOS, moving just that satellite up or down the list, instead of re-sorting the whole array every SATELLITE_UPDATE_ARRAY_ORDER_INTERVAL_MS.
+          \| no longer scans the array 255 times.  SATELLITE_UPDATE_ARRAY_ORDER_INTERVAL_MS is only used with OPTION_USE_OLD_TIME_CODE.
+        FEATURE_NEXTION_DISPLAY: vSatNx no longer reads past the end of the satellite array when there are fewer satellites than NEXTION_NUMBER_OF_NEXT_SATELLITES
+
+      2026.10.17.12
+        FEATURE_SATELLITE_TLE_CATALOG_SD: keep the TLE file and its directory on an SD card (SATELLITE_TLE_CATALOG_SD_FILE, SATELLITE_TLE_CATALOG_SD_DIRECTORY_FILE)
+          rather than in the EEPROM left over after the configuration.  The file can hold thousands of satellites (SATELLITE_TLE_CATALOG_SD_DIRECTORY_LENGTH);
+          the array still holds the first SATELLITE_LIST_LENGTH, and \$ on a satellite further down the file puts it in the array.
+          All TLE file access now goes through tle_catalog_read(), tle_catalog_write(), and friends, so other storage can be added there.
+          Pin setting: satellite_tle_catalog_sd_cs_pin
+        FEATURE_SATELLITE_TRACKING: parsed TLEs are now kept in a least recently used cache of SATELLITE_ELEMENT_CACHE_LENGTH entries rather than one per
+          array slot; ones that aren't cached are read back in from the TLE file as needed.  The default is still one per array slot with the TLE file
+          in EEPROM, since the array refresh goes through every slot; with FEATURE_SATELLITE_TLE_CATALOG_SD it's 16.
+          The TLE file directory format changed (2 byte entry count), it's rebuilt automatically the first time.
+
+      2026.10.17.13
+        FEATURE_SATELLITE_TRACKING: packed TLE records.  \* uploads a TLE file converted with lib/tle/tle_to_packed.py, which stores each satellite
+          as its name and the elements already parsed into scaled integers (SatElements::packed() in P13), with a checksum per record.  A packed record is
+          about a third the size of the TLE text, so about three times as many satellites fit in the EEPROM, and nothing has to be parsed when a satellite
+          is loaded.  \# text uploads work as before and \@ prints packed records decoded.
+
+      2026.10.17.14
+        FEATURE_SATELLITE_TRACKING: the \# and \* TLE file uploads do XON/XOFF flow control, so a TLE file can be sent from a script at full speed
+          (set the terminal or script for software flow control).  XOFF goes out when SATELLITE_TLE_UPLOAD_XOFF_LEVEL bytes are waiting to be stored,
+          XON when it's down to SATELLITE_TLE_UPLOAD_XON_LEVEL.  TLE file and directory bytes that are already in the EEPROM aren't written again, and
+          the uploads report bytes/S and how many bytes were written and how many were unchanged.
+
+      2026.10.17.15
+        FEATURE_SATELLITE_TRACKING: satellites that can't have an AOS or LOS from here are spotted from their inclination, orbit size, and our latitude
+          (and for geostationary ones, where they are now) and skip the AOS / LOS search rather than running it until SATELLITE_CALC_TIMEOUT_MS.
+          \| and \~ show them as "Never visible" or "Always visible", \% says so, and they're listed after the satellites with upcoming passes.
+
+      2026.10.17.16
+        FEATURE_SATELLITE_TRACKING: while the rotator is idle, the satellite AOS / LOS calculations keep going each time through loop() until
+          SATELLITE_CALC_BUDGET_US microseconds are used up, rather than doing one prediction, so they finish a lot sooner.  While it's rotating
+          it's still one prediction per loop().  \= shows the budget, \=<microseconds> changes it (until restart, 0 = one prediction per loop()).
+          DEBUG_PROCESSES shows the time spent in satellite_calc, the budget, predictions per call, and the longest call.
+
+      2026.10.17.17
+        FEATURE_MOON_TRACKING, FEATURE_SUN_TRACKING: the sun and moon positions come from a Chebyshev fit of their direction made once a day
+          (EPHEMERIS_CACHE_TERMS runs of sunpos() or moon2() at midnight UTC, or when the location changes) rather than running sunpos() or moon2()
+          every time the display, tracking, or a command wants them.  The fit is within a couple thousandths of a degree.  SUN_UPDATE_POSITION_INTERVAL_MS
+          and MOON_UPDATE_POSITION_INTERVAL_MS are now 100 mS.  Not with OPTION_USE_OLD_TIME_CODE.
+
+      2026.10.17.18
+        FEATURE_MOON_TRACKING, FEATURE_SUN_TRACKING: the next rise, set (through MOON_AOS_ELEVATION_MIN / SUN_AOS_ELEVATION_MIN) and transit of the
+          moon and sun are found ahead of time, looking out SUN_MOON_EVENT_SEARCH_HOURS, a step per pass through loop().  \ME and \UE show them
+          ("searching" for any the search hasn't got to yet), and the Nextion gets them in vMRT, vMST, vMTT, vSRT, vSST, and vSTT (UTC).  While
+          the moon or sun is below the elevation minimum and won't be up until the next rise, moon and sun tracking sleep until then rather
+          than polling the position.  \U updates the sun position before showing it, like \M.  Not with OPTION_USE_OLD_TIME_CODE.
+
+      2026.10.17.19
+        FEATURE_MOON_TRACKING, FEATURE_SUN_TRACKING, FEATURE_SATELLITE_TRACKING: the time is worked out once each time through loop() into astro_now
+          (UTC, Julian day, GMST, and local sidereal time), straight from the seconds, and the sun, moon, and satellite calculations take it from there
+          rather than each breaking now() down into year, month, day, etc. and sunpos(), moon2(), and P13 turning that back into a day number.
+          sunpos_elapsed(), moon2_days(), and SatDateTime::setjulian() added to the libraries for this.  Not with OPTION_USE_OLD_TIME_CODE.
+
+      2026.10.17.20
+        Native tests for sunpos(), moon2(), and the P13 satellite code in test/native, run on the PC with  pio test -e native .  They check
+          azimuth and elevation, including ISS passes and their AOS and LOS, against reference values worked out independently by
+          test/native/reference/astro_reference.py (Meeus for the sun and moon, SGP4 for satellites), and time each library.
+        moon2(): fixed the topocentric declination coming out NaN for an observer exactly on the equator
+
+      2026.10.17.21
+        read_azimuth() and read_elevation() now do the mapping, offset, smoothing, and 0 - 359 wrap in integer hundredths of a degree rather than
+          software floating point, for all position sensors.  The potentiometer scale factors are worked out only when the calibration changes.
+          Results are the same as before to within 0.01 degree.  The mapping, smoothing, and wrap are in the new library lib/centidegrees (Arduino IDE
+          users: install it along with the others), which test/native/test_centidegrees checks against the old float pipeline.
+
+      2026.10.17.22
+        FEATURE_AZIMUTH_CORRECTION, FEATURE_ELEVATION_CORRECTION: the calibration table is resampled at boot into a lookup table of evenly spaced
+          points (AZIMUTH_CORRECTION_LUT_SIZE, ELEVATION_CORRECTION_LUT_SIZE) and each heading is corrected with one interpolation rather than
+          searching the table.  The old search used the size of the table in bytes rather than entries and ran off the end of the arrays.
+          The tables can now be loaded into EEPROM over the serial port rather than compiled in:
+            \>A                  - show the azimuth calibration table (\>E elevation)
+            \>Axxx[.xx] yyy[.yy] - add the point xxx degrees raw -> yyy degrees, or change it if it's already there (\>E elevation)
+            \>AC                 - empty the EEPROM table (\>EC elevation)
+            \>AD                 - go back to the compiled in table (\>ED elevation)
+          The EEPROM tables (AZIMUTH_CORRECTION_EEPROM_POINTS, ELEVATION_CORRECTION_EEPROM_POINTS) go at the top of EEPROM, under the TLE
+          file directory, and take their room from the end of the TLE file area.  The TLE file stays where it was; if the area's end moves
+          (turning either feature on or off, or changing the number of points) and the stored TLE file no longer fits, it's emptied and has
+          to be loaded again.
+
+      2026.10.17.23
+        OPTION_POTENTIOMETER_ADC_OVERSAMPLING: FEATURE_AZ_POSITION_POTENTIOMETER and FEATURE_EL_POSITION_POTENTIOMETER pots are sampled continuously
+          in the background rather than with one analogRead() each time the heading is read.  POTENTIOMETER_OVERSAMPLING_SAMPLES samples are added
+          up into each reading (16 gives two more bits of resolution) and read_azimuth() and read_elevation() take the median of the last
+          POTENTIOMETER_MEDIAN_LENGTH readings, which takes out spikes with much less lag than the smoothing factors.  On AVR the ADC conversion
+          complete interrupt does the sampling, alternating between the two pots; other analogReadEnhanced() calls hold it off while they convert.
+          Other boards take a sample of each pot from read_headings() every POTENTIOMETER_SAMPLE_INTERVAL_MS.  Off by default.
+        FEATURE_ADC_RESOLUTION14 - 14 bit ADC resolution for the Arduino UNO R4
+
+      2026.10.17.24
+        read_azimuth() and read_elevation() feed an alpha-beta filter (HEADING_ESTIMATE_ALPHA, HEADING_ESTIMATE_BETA) that keeps a filtered
+          position and velocity for each axis.  Rotation stall detection, slow down, and the tracking lead slew rate measurement now work
+          from it rather than each keeping its own heading history.  It's fed each new measurement with the time it was taken.
+        Stall detection now trips when the velocity stays under STALL_CHECK_DEGREES_THRESHOLD per STALL_CHECK_FREQUENCY_MS for
+          STALL_CHECK_FREQUENCY_MS.  Elevation stall detection was using STALL_CHECK_DEGREES_THRESHOLD_AZ; it now uses _EL.
+        SLOW_DOWN_BEFORE_TARGET_SECS_AZ, SLOW_DOWN_BEFORE_TARGET_SECS_EL - start slow down further out than SLOW_DOWN_BEFORE_TARGET_AZ / _EL
+          when the rotator is fast enough to cover more than that in this many seconds
+        \?AV, \?EV - query azimuth / elevation velocity, degrees per second
+
+      2026.10.17.25
+        FEATURE_AZ_POSITION_INCREMENTAL_ENCODER, FEATURE_EL_POSITION_INCREMENTAL_ENCODER: the interrupt handlers now only decode and count.  The
+          A, B, and Z pins are read straight from their port registers on AVR and the count comes from a 16 entry transition table.
+          read_azimuth() and read_elevation() are no longer called from the interrupt handlers; read_headings() picks up a changed count
+          the next time through loop() and service_rotation() goes from there.  Transitions where both A and B changed are counted as
+          missed and show in the debug output.
+
     All library files should be placed in directories likes \sketchbook\libraries\library1\ , \sketchbook\libraries\library2\ , etc.
     Anything rotator_*.* should be in the ino directory!
 
@@ -1112,12 +1289,13 @@
 
   */
 
-#define CODE_VERSION "2023.10.06.2200"
+#define CODE_VERSION "2026.10.17.25"
 
 
 #include <avr/pgmspace.h>
 #include <EEPROM.h>
 #include <math.h>
+#include <centidegrees.h>
 
 #include "rotator_hardware.h"
 
@@ -1237,6 +1415,11 @@
   #include <Ethernet.h>
 #endif
 
+#if defined(FEATURE_SATELLITE_TLE_CATALOG_SD)
+  #include <SPI.h>
+  #include <SD.h>
+#endif
+
 #if defined(FEATURE_AZ_POSITION_ROTARY_ENCODER_USE_PJRC_LIBRARY) || defined(FEATURE_EL_POSITION_ROTARY_ENCODER_USE_PJRC_LIBRARY)
   #include <Encoder.h>
 #endif    
@@ -1266,6 +1449,10 @@
   #error "az_stepper_motor_direction and el_stepper_motor_direction pins are not supported anymore.  Use rotate_* pins instead."
 #endif
 
+#if defined(FEATURE_SATELLITE_TLE_CATALOG_SD) && (satellite_tle_catalog_sd_cs_pin == 0)
+  #error "FEATURE_SATELLITE_TLE_CATALOG_SD requires satellite_tle_catalog_sd_cs_pin to be set in the pins file"
+#endif
+
 
 #ifdef HARDWARE_WB6KCN_K3NG
   #include "rotator_settings_wb6kcn_k3ng.h"
@@ -1341,6 +1528,14 @@ unsigned long az_timed_slow_down_start_time = 0;
 byte backslash_command = 0;
 byte normal_az_speed_voltage = 0;
 byte current_az_speed_voltage = 0;
+float az_slow_down_distance = SLOW_DOWN_BEFORE_TARGET_AZ;
+
+struct heading_estimate {
+  float position;                   // degrees, filtered
+  float velocity;                   // degrees per second, + = CW / up
+  unsigned long time;               // millis() of the last update
+  byte valid;
+} azimuth_estimate;                 // alpha-beta filtered from read_azimuth() by update_heading_estimate()
 double latitude = DEFAULT_LATITUDE;
 double longitude = DEFAULT_LONGITUDE;
 double altitude_m = DEFAULT_ALTITUDE_M;
@@ -1431,6 +1626,8 @@ struct config_t {
   unsigned long el_timed_slow_down_start_time = 0;
   byte normal_el_speed_voltage = 0;
   byte current_el_speed_voltage = 0;
+  float el_slow_down_distance = SLOW_DOWN_BEFORE_TARGET_EL;
+  struct heading_estimate elevation_estimate;
   byte el_state = IDLE;
   int analog_el = 0;
   unsigned long el_last_rotate_initiation = 0;
@@ -1440,6 +1637,53 @@ struct config_t {
   #endif // FEATURE_TIMED_BUFFER  
 #endif // FEATURE_ELEVATION_CONTROL
 
+#if defined(FEATURE_AZ_POSITION_POTENTIOMETER) || defined(FEATURE_EL_POSITION_POTENTIOMETER)
+  #if defined(FEATURE_AZ_POSITION_POTENTIOMETER)
+    analog_heading_map azimuth_analog_map;  // kept up to date by map_analog_to_centidegrees()
+  #endif
+  #if defined(FEATURE_EL_POSITION_POTENTIOMETER)
+    analog_heading_map elevation_analog_map;
+  #endif
+  #if defined(FEATURE_ADC_RESOLUTION14)
+    #define POTENTIOMETER_ADC_BITS 14
+  #elif defined(FEATURE_ADC_RESOLUTION12)
+    #define POTENTIOMETER_ADC_BITS 12
+  #else
+    #define POTENTIOMETER_ADC_BITS 10
+  #endif
+  #if defined(OPTION_POTENTIOMETER_ADC_OVERSAMPLING)
+    // every 4x oversampling is good for another bit
+    #if POTENTIOMETER_OVERSAMPLING_SAMPLES >= 64
+      #define POTENTIOMETER_OVERSAMPLING_SHIFT 6
+      #define POTENTIOMETER_OVERSAMPLING_EXTRA_BITS 3
+    #elif POTENTIOMETER_OVERSAMPLING_SAMPLES >= 16
+      #define POTENTIOMETER_OVERSAMPLING_SHIFT 4
+      #define POTENTIOMETER_OVERSAMPLING_EXTRA_BITS 2
+    #elif POTENTIOMETER_OVERSAMPLING_SAMPLES >= 4
+      #define POTENTIOMETER_OVERSAMPLING_SHIFT 2
+      #define POTENTIOMETER_OVERSAMPLING_EXTRA_BITS 1
+    #else
+      #define POTENTIOMETER_OVERSAMPLING_SHIFT 0
+      #define POTENTIOMETER_OVERSAMPLING_EXTRA_BITS 0
+    #endif
+    struct potentiometer_sampler_state {
+      byte pin;                             // 255 = not in use
+      unsigned long sum;                    // ADC samples so far toward the next decimated reading
+      byte samples;
+      int readings[POTENTIOMETER_MEDIAN_LENGTH];  // last decimated readings, ADC counts << POTENTIOMETER_OVERSAMPLING_EXTRA_BITS
+      byte reading_in;
+      byte readings_stored;
+    };
+    // filled in by the ADC interrupt on AVR, by service_potentiometer_sampler() elsewhere
+    volatile potentiometer_sampler_state potentiometer_sampler[2] = {{255,0,0,{0},0,0},{255,0,0,{0},0,0}};
+    volatile byte potentiometer_sampler_current = 0;
+    volatile byte potentiometer_sampler_running = 0;
+  #else
+    #define POTENTIOMETER_OVERSAMPLING_EXTRA_BITS 0
+  #endif
+  #define POTENTIOMETER_FULL_SCALE (1L << (POTENTIOMETER_ADC_BITS + POTENTIOMETER_OVERSAMPLING_EXTRA_BITS))
+#endif
+
 #ifdef FEATURE_ROTARY_ENCODER_SUPPORT
   #ifdef OPTION_ENCODER_HALF_STEP_MODE      // Use the half-step state table (emits a code at 00 and 11)
     const unsigned char ttable[6][4] = {
@@ -1529,11 +1773,35 @@ struct config_t {
   byte park_serial_initiated = 0;
 #endif // FEATURE_PARK
 
+#if defined(FEATURE_AZ_POSITION_INCREMENTAL_ENCODER) || defined(FEATURE_EL_POSITION_INCREMENTAL_ENCODER)
+  struct incremental_encoder_pins {
+    #if defined(__AVR__)
+      volatile uint8_t * phase_a_register;   // PINx input registers, read directly by the interrupt handlers
+      volatile uint8_t * phase_b_register;
+      volatile uint8_t * phase_z_register;
+      uint8_t phase_a_mask;
+      uint8_t phase_b_mask;
+      uint8_t phase_z_mask;
+    #else
+      uint8_t phase_a_pin;
+      uint8_t phase_b_pin;
+      uint8_t phase_z_pin;
+    #endif
+  };
+
+  // count change for each (last A B << 2) | (current A B) quadrature transition; INCREMENTAL_ENCODER_MISSED_TRANSITION = both phases changed, a transition was missed
+  const signed char incremental_encoder_transition[16] = {0, -1, 1, INCREMENTAL_ENCODER_MISSED_TRANSITION,
+                                                          1, 0, INCREMENTAL_ENCODER_MISSED_TRANSITION, -1,
+                                                          -1, INCREMENTAL_ENCODER_MISSED_TRANSITION, 0, 1,
+                                                          INCREMENTAL_ENCODER_MISSED_TRANSITION, 1, -1, 0};
+#endif
+
 #ifdef FEATURE_AZ_POSITION_INCREMENTAL_ENCODER
-  volatile byte read_azimuth_lock = 0;
   volatile long az_incremental_encoder_position = 0;
-  volatile byte az_3_phase_encoder_last_phase_a_state = 0;
-  volatile byte az_3_phase_encoder_last_phase_b_state = 0;
+  volatile byte az_incremental_encoder_last_phases = 0;
+  volatile byte az_incremental_encoder_moved = 0;                   // set by the interrupt handler, cleared when read_azimuth() picks up the count
+  volatile unsigned long az_incremental_encoder_missed_transitions = 0;
+  struct incremental_encoder_pins az_incremental_encoder_pins;
   #ifdef DEBUG_AZ_POSITION_INCREMENTAL_ENCODER
     volatile long az_position_incremental_encoder_interrupt = 0;
   #endif // DEBUG_AZ_POSITION_INCREMENTAL_ENCODER
@@ -1541,18 +1809,15 @@ struct config_t {
 
 #ifdef FEATURE_EL_POSITION_INCREMENTAL_ENCODER
   volatile long el_incremental_encoder_position = 0;
-  volatile byte el_3_phase_encoder_last_phase_a_state = 0;
-  volatile byte el_3_phase_encoder_last_phase_b_state = 0;
-  volatile byte read_elevation_lock = 0;
+  volatile byte el_incremental_encoder_last_phases = 0;
+  volatile byte el_incremental_encoder_moved = 0;
+  volatile unsigned long el_incremental_encoder_missed_transitions = 0;
+  struct incremental_encoder_pins el_incremental_encoder_pins;
   #ifdef DEBUG_EL_POSITION_INCREMENTAL_ENCODER
     volatile long el_position_incremental_encoder_interrupt = 0;
   #endif // DEBUG_EL_POSITION_INCREMENTAL_ENCODER
 #endif // FEATURE_EL_POSITION_INCREMENTAL_ENCODER
 
-#if defined(FEATURE_AZ_POSITION_INCREMENTAL_ENCODER) || defined(FEATURE_EL_POSITION_INCREMENTAL_ENCODER)
-  volatile byte service_rotation_lock = 0;
-#endif
-
 #if defined(FEATURE_REMOTE_UNIT_SLAVE) || defined(CONTROL_PROTOCOL_EMULATION) || defined(FEATURE_CLOCK) || defined(UNDER_DEVELOPMENT_REMOTE_UNIT_COMMANDS)
   CONTROL_PORT_SERIAL_PORT_CLASS * control_port;
 #endif
@@ -1574,6 +1839,68 @@ struct config_t {
   byte sun_tracking_active = 0;
 #endif // FEATURE_SUN_TRACKING
 
+#if (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING) || defined(FEATURE_SATELLITE_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
+  struct tracking_lead_axis{
+    float slew_rate;                // degrees per second at full speed; 0 = not measured yet
+    float start_latency;            // seconds from starting a rotation until the heading is moving at speed
+    unsigned long last_sample_time;
+    byte last_sample_at_speed;
+    float start_heading;
+    unsigned long start_time;
+    byte starting;
+    byte was_idle;
+  } tracking_lead_az, tracking_lead_el;   // measured by service_tracking_lead() for tracking_lead_position()
+
+  struct astro_time{
+    time_t epoch;                           // UTC
+    long julian_day;                        // Julian day number of the UTC date
+    double day_fraction;                    // of the UTC day, from 00:00
+    double gmst;                            // Greenwich mean sidereal time, degrees
+    double lst;                             // local mean sidereal time at lst_longitude, degrees
+    double lst_longitude;
+  } astro_now;                              // set once each time through loop() by update_astro_time(), for the sun, moon, and satellite calculations
+#endif
+
+#if (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
+  struct ephemeris_cache{
+    time_t start;                           // the fit covers start to start + EPHEMERIS_CACHE_SPAN_SECS; 0 = nothing fitted yet
+    double latitude;                        // observer the fit was made for
+    double longitude;
+    float east[EPHEMERIS_CACHE_TERMS];      // Chebyshev coefficients of the direction unit vector
+    float north[EPHEMERIS_CACHE_TERMS];
+    float up[EPHEMERIS_CACHE_TERMS];
+  };
+  #if defined(FEATURE_MOON_TRACKING)
+    ephemeris_cache moon_ephemeris;         // daily fits made by ephemeris_cache_position()
+  #endif
+  #if defined(FEATURE_SUN_TRACKING)
+    ephemeris_cache sun_ephemeris;
+  #endif
+
+  struct sun_moon_events{
+    time_t rise;                            // next time the elevation comes up through the AOS elevation minimum; 0 = not in the search window
+    time_t set;                             // next time it goes down through it; 0 = not in the search window
+    time_t transit;                         // next culmination; 0 = not in the search window
+    float transit_elevation;
+    time_t search_start;                    // 0 = start a new search
+    time_t search_time;                     // how far the coarse steps have gotten
+    time_t bisect_low;                      // bracket around the event being narrowed down
+    time_t bisect_high;
+    byte bisect_event;                      // SUN_MOON_EVENT_*
+    byte complete;
+    float last_elevation;                   // at search_time
+    float last_slope;                       // elevation change over the last step
+    double latitude;                        // observer the search was made for
+    double longitude;
+  };
+  #if defined(FEATURE_MOON_TRACKING)
+    sun_moon_events moon_events;            // kept up to date by service_sun_moon_events()
+  #endif
+  #if defined(FEATURE_SUN_TRACKING)
+    sun_moon_events sun_events;
+  #endif
+#endif
+
 
 #ifdef FEATURE_CLOCK
 #if defined(OPTION_USE_OLD_TIME_CODE)
@@ -1658,16 +1985,45 @@ struct config_t {
 
 #endif //FEATURE_STEPPER_MOTOR
 
+#if defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+  // the calibration table resampled at evenly spaced, power of two centidegree steps, so a lookup is a shift and one interpolation
+  struct correction_lut_state {
+    long from_start;            // centidegrees
+    long from_end;
+    byte step_shift;            // points are 2^step_shift centidegrees apart
+    byte points;                // 0 = no correction
+  };
+#endif
+
 #ifdef FEATURE_AZIMUTH_CORRECTION
   const float azimuth_calibration_from[]  = AZIMUTH_CALIBRATION_FROM_ARRAY;    
   const float azimuth_calibration_to[]    = AZIMUTH_CALIBRATION_TO_ARRAY;
+  struct correction_lut_state azimuth_correction_lut;
+  long azimuth_correction_lut_to[AZIMUTH_CORRECTION_LUT_SIZE];
+  #define azimuth_correction_table_eeprom_size (CORRECTION_TABLE_EEPROM_HEADER_SIZE+(AZIMUTH_CORRECTION_EEPROM_POINTS*CORRECTION_TABLE_EEPROM_POINT_SIZE))
+#else
+  #define azimuth_correction_table_eeprom_size 0
 #endif // FEATURE_AZIMUTH_CORRECTION
 
 #ifdef FEATURE_ELEVATION_CORRECTION
   const float elevation_calibration_from[]  = ELEVATION_CALIBRATION_FROM_ARRAY;
   const float elevation_calibration_to[]    = ELEVATION_CALIBRATION_TO_ARRAY;
+  struct correction_lut_state elevation_correction_lut;
+  long elevation_correction_lut_to[ELEVATION_CORRECTION_LUT_SIZE];
+  #define elevation_correction_table_eeprom_size (CORRECTION_TABLE_EEPROM_HEADER_SIZE+(ELEVATION_CORRECTION_EEPROM_POINTS*CORRECTION_TABLE_EEPROM_POINT_SIZE))
+#else
+  #define elevation_correction_table_eeprom_size 0
 #endif // FEATURE_ELEVATION_CORRECTION
 
+// The calibration tables loaded with \> sit at the top of EEPROM, under the TLE file directory, so turning either
+// correction feature on or off doesn't move the TLE file, it only changes how much room the file has
+#if defined(FEATURE_SATELLITE_TRACKING) && !defined(FEATURE_SATELLITE_TLE_CATALOG_SD)
+  #define tle_file_directory_eeprom_size TLE_FILE_DIRECTORY_SIZE
+#else
+  #define tle_file_directory_eeprom_size 0
+#endif
+#define correction_table_eeprom_start (eeprom_end()-tle_file_directory_eeprom_size-azimuth_correction_table_eeprom_size-elevation_correction_table_eeprom_size)
+
 #ifdef FEATURE_AUTOCORRECT
   byte autocorrect_state_az = AUTOCORRECT_INACTIVE;
   float autocorrect_az = 0;
@@ -1809,14 +2165,39 @@ struct config_t {
 #if defined(FEATURE_SATELLITE_TRACKING)
   #include <P13.h>
   #define tle_file_eeprom_memory_area_start (sizeof(configuration)+5)
+  #define tle_file_layout_eeprom_start (sizeof(configuration))  // magic and TLE file area end (2 bytes), in the gap before the TLE file
+  #define TLE_FILE_LAYOUT_MAGIC 0xA7
   #define SATELLITE_NAME_LENGTH 17
   #define SATELLITE_LIST_LENGTH 35
+  #if defined(FEATURE_SATELLITE_TLE_CATALOG_SD)
+    #define TLE_FILE_DIRECTORY_LENGTH SATELLITE_TLE_CATALOG_SD_DIRECTORY_LENGTH
+    #define TLE_FILE_DIRECTORY_OFFSET_SIZE 3
+  #else
+    #define TLE_FILE_DIRECTORY_LENGTH SATELLITE_LIST_LENGTH
+    #define TLE_FILE_DIRECTORY_OFFSET_SIZE 2
+  #endif
+  #define TLE_FILE_DIRECTORY_MAGIC 0xA6
+  #define TLE_FILE_DIRECTORY_HEADER_SIZE 5   // magic, entry count (2 bytes), flags, checksum
+  #define TLE_FILE_DIRECTORY_ENTRY_SIZE (TLE_FILE_DIRECTORY_OFFSET_SIZE+2)    // name hash, offset, length
+  #define TLE_FILE_DIRECTORY_SIZE (TLE_FILE_DIRECTORY_HEADER_SIZE+(TLE_FILE_DIRECTORY_LENGTH*TLE_FILE_DIRECTORY_ENTRY_SIZE))
+  #define TLE_FILE_DIRECTORY_INCOMPLETE 1    // flag: not every satellite in the file is in the directory (too many, or a record too long to index)
+  #define TLE_FILE_DIRECTORY_NOT_FOUND 0xFFFF
+  #define TLE_FILE_PACKED_RECORD_MARKER 0xFD  // first byte of a packed record: marker, name length, name, SatElements::packed() bytes, checksum
+  #define TLE_FILE_PACKED_RECORD_SIZE(name_length) ((name_length)+SAT_ELEMENTS_PACKED_SIZE+3)
+  #define tle_file_directory_eeprom_start (eeprom_end()-TLE_FILE_DIRECTORY_SIZE)
   byte satellite_array_data_ready = 0;
   double current_satellite_elevation;
   double current_satellite_azimuth;      
   double current_satellite_longitude;
   double current_satellite_latitude;
   unsigned int tle_file_eeprom_memory_area_end;
+  unsigned long tle_file_eeprom_read_location;  // offset into the TLE file
+  byte tle_file_record_packed = 0;              // get_line_from_tle_file_eeprom() is sitting on the elements of a packed record
+  unsigned long tle_catalog_bytes_written = 0;  // bytes tle_catalog_write() actually wrote
+  unsigned long tle_catalog_bytes_unchanged = 0;  // and ones it didn't have to because they were already there
+  byte tle_file_directory_valid = 0;
+  unsigned int tle_file_directory_count = 0;
+  byte tle_file_directory_flags = 0;
   byte satellite_tracking_active = 0;
   float current_satellite_next_aos_az = 0;
   float current_satellite_next_aos_el = 0;
@@ -1826,6 +2207,12 @@ struct config_t {
   byte periodic_aos_los_satellite_status = 0;
   byte current_satellite_position_in_array = 255;
   byte service_calc_satellite_data_service_state = SERVICE_IDLE;
+  unsigned long satellite_calc_budget_us = SATELLITE_CALC_BUDGET_US;
+  #if defined(DEBUG_PROCESSES)
+    unsigned long satellite_calc_budget_calls = 0;
+    unsigned long satellite_calc_budget_steps = 0;
+    unsigned long satellite_calc_budget_max_us = 0;
+  #endif
   byte service_calc_current_sat;
   byte service_calc_satellite_data_task;
 
@@ -1840,15 +2227,16 @@ struct config_t {
 
   struct satellite_list{
     char name[SATELLITE_NAME_LENGTH];
-    int azimuth;
-    int elevation;
-    int next_aos_az;
-    int next_los_az;
-    int longitude;
-    int latitude;      
+    uint16_t azimuth;     // hundredths of a degree
+    int16_t elevation;    // hundredths of a degree
+    int16_t next_aos_az;
+    int16_t next_los_az;
+    int16_t longitude;
+    int16_t latitude;      
     byte next_pass_max_el;
     byte order;
-    byte status;   // bitmapped:      1 = aos, 2 = last_calc_timed_out, 4 = AOS/LOS state change
+    byte status;   // bitmapped:      1 = aos, 2 = last_calc_timed_out, 4 = AOS/LOS state change, 8 = never visible, 16 = always visible
+    uint16_t catalog_entry;       // TLE file directory entry, TLE_FILE_DIRECTORY_NOT_FOUND if it's not in the directory
  
     #if defined(OPTION_USE_OLD_TIME_CODE)
 
@@ -1857,12 +2245,54 @@ struct config_t {
 
     #else //OPTION_USE_OLD_TIME_CODE
 
-    tmElements_t next_aos;
-    tmElements_t next_los;
+    time_t next_aos;      // 0 = not calculated yet
+    time_t next_los;
 
     #endif //OPTION_USE_OLD_TIME_CODE
   } satellite[SATELLITE_LIST_LENGTH];
 
+  SatElements satellite_elements[SATELLITE_ELEMENT_CACHE_LENGTH];  // parsed TLE elements, paged in from the TLE file by satellite_element_cache_entry()
+  byte satellite_elements_slot[SATELLITE_ELEMENT_CACHE_LENGTH];     // the satellite[] slot each cache entry is for, 255 = empty
+  byte satellite_elements_lru[SATELLITE_ELEMENT_CACHE_LENGTH];      // cache entries, most recently used first
+
+  #if defined(FEATURE_SATELLITE_TLE_CATALOG_SD)
+    File tle_catalog_file;
+    File tle_catalog_directory_file;
+  #endif
+
+  #if !defined(OPTION_USE_OLD_TIME_CODE)
+  struct satellite_pass{
+    time_t aos;
+    unsigned int los;           // seconds after aos
+    unsigned int max_el_time;   // seconds after aos
+    int aos_az;
+    int los_az;
+    byte max_el;
+  } satellite_passes[SATELLITE_LIST_LENGTH][SATELLITE_PASS_TABLE_LENGTH];  // ring of the next passes for each satellite[] slot, kept topped up by service_satellite_tracking()
+  byte satellite_pass_first[SATELLITE_LIST_LENGTH];
+  byte satellite_pass_count[SATELLITE_LIST_LENGTH];
+
+  struct satellite_track_knot{
+    int east;                   // direction to the satellite, unit vector scaled to 32767
+    int north;
+    int up;
+  } satellite_track_knots[SATELLITE_TRACK_KNOTS];  // the pass of the satellite being tracked, one every SATELLITE_TRACK_KNOT_INTERVAL_SECS, filled by service_satellite_track()
+  time_t satellite_track_start;                    // time of satellite_track_knots[0]
+  byte satellite_track_knot_count = 0;
+  byte satellite_track_satellite = 255;            // satellite[] slot the knots are for; 255 = none
+  byte satellite_track_complete = 0;               // knots go out past LOS, nothing more to calculate
+
+  struct satellite_refresh_schedule{
+    byte countdown;             // SATELLITE_ARRAY_AZ_EL_REFRESH_MS ticks until the next az / el refresh; 0 = due now
+    byte interval;              // ticks between the last two az / el refreshes
+    unsigned int refreshes;     // az / el refreshes since the array was initialized
+    unsigned int calcs;         // next AOS / LOS and pass table calculations since the array was initialized
+  } satellite_refresh[SATELLITE_LIST_LENGTH];     // filled by refresh_satellite_array_positions() and service_satellite_tracking()
+
+  byte satellite_order_list[SATELLITE_LIST_LENGTH];  // satellite[] slots, ones in AOS first, then soonest next AOS / LOS first; satellite[].order is the place in here
+  byte satellite_order_list_count = 0;
+  #endif //OPTION_USE_OLD_TIME_CODE
+
 #endif //FEATURE_SATELLITE_TRACKING
 
 #if defined(FEATURE_NEXTION_DISPLAY)
@@ -1887,6 +2317,10 @@ void setup() {
 
   read_settings_from_eeprom();
 
+  #if defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+    initialize_correction_tables();
+  #endif
+
   initialize_pins();
 
   read_azimuth(0);
@@ -1915,6 +2349,10 @@ void loop() {
     update_time();
   #endif
 
+  #if (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING) || defined(FEATURE_SATELLITE_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
+    update_astro_time();
+  #endif
+
   service_process_debug(DEBUG_PROCESSES_SERVICE,0);
 
   check_serial();
@@ -2019,6 +2457,10 @@ void loop() {
     check_limit_sense();
   #endif // FEATURE_LIMIT_SENSE
 
+  #if (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING) || defined(FEATURE_SATELLITE_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
+    service_tracking_lead();
+  #endif
+
   #ifdef FEATURE_MOON_TRACKING
     service_moon_tracking();
   #endif // FEATURE_MOON_TRACKING
@@ -2092,7 +2534,13 @@ void loop() {
 
   #if defined(FEATURE_SATELLITE_TRACKING)
     service_satellite_tracking(0,0);
-    service_calc_satellite_data(0,0,0,SERVICE_CALC_DO_NOT_PRINT_HEADER,SERVICE_CALC_SERVICE,SERVICE_CALC_DO_NOT_PRINT_DONE,0);
+    #ifdef DEBUG_PROCESSES
+      service_process_debug(DEBUG_PROCESSES_PROCESS_ENTER,PROCESS_SATELLITE_CALC);
+    #endif
+    service_calc_satellite_data_within_budget();
+    #ifdef DEBUG_PROCESSES
+      service_process_debug(DEBUG_PROCESSES_PROCESS_EXIT,PROCESS_SATELLITE_CALC);
+    #endif
     //service_calculate_multi_satellite_upcoming_aos_and_los(SERVICE_CALC_SERVICE);
   #endif
 
@@ -2570,10 +3018,22 @@ void read_headings(){
   #endif
 
 
-  read_azimuth(0);
+  #if defined(OPTION_POTENTIOMETER_ADC_OVERSAMPLING) && (defined(FEATURE_AZ_POSITION_POTENTIOMETER) || defined(FEATURE_EL_POSITION_POTENTIOMETER)) && !defined(__AVR__)
+    service_potentiometer_sampler();
+  #endif
+
+  #ifdef FEATURE_AZ_POSITION_INCREMENTAL_ENCODER
+    read_azimuth(az_incremental_encoder_moved);  // pick up encoder counts right away rather than waiting on AZIMUTH_MEASUREMENT_FREQUENCY_MS
+  #else
+    read_azimuth(0);
+  #endif
 
   #ifdef FEATURE_ELEVATION_CONTROL
-    read_elevation(0);
+    #if defined(FEATURE_EL_POSITION_INCREMENTAL_ENCODER)
+      read_elevation(el_incremental_encoder_moved);
+    #else
+      read_elevation(0);
+    #endif
   #endif
 
   #ifdef DEBUG_PROCESSES
@@ -2834,11 +3294,11 @@ void initialize_rotary_encoders(){
       digitalWrite(az_incremental_encoder_pin_phase_b, HIGH);
       digitalWrite(az_incremental_encoder_pin_phase_z, HIGH);
     #endif // OPTION_INCREMENTAL_ENCODER_PULLUPS
+    initialize_incremental_encoder_pins(az_incremental_encoder_pins, az_incremental_encoder_pin_phase_a, az_incremental_encoder_pin_phase_b, az_incremental_encoder_pin_phase_z);
+    az_incremental_encoder_last_phases = read_incremental_encoder_phases(az_incremental_encoder_pins) & INCREMENTAL_ENCODER_PHASES_AB;
     attachInterrupt(AZ_POSITION_INCREMENTAL_ENCODER_A_PIN_INTERRUPT, az_position_incremental_encoder_interrupt_handler, CHANGE);
     attachInterrupt(AZ_POSITION_INCREMENTAL_ENCODER_B_PIN_INTERRUPT, az_position_incremental_encoder_interrupt_handler, CHANGE);
     delay(250);
-    az_3_phase_encoder_last_phase_a_state = digitalRead(az_incremental_encoder_pin_phase_a);
-    az_3_phase_encoder_last_phase_b_state = digitalRead(az_incremental_encoder_pin_phase_b);
   #endif // FEATURE_AZ_POSITION_INCREMENTAL_ENCODER
 
   #if defined(FEATURE_EL_POSITION_INCREMENTAL_ENCODER) && defined(FEATURE_ELEVATION_CONTROL)
@@ -2850,11 +3310,11 @@ void initialize_rotary_encoders(){
   digitalWrite(el_incremental_encoder_pin_phase_b, HIGH);
   digitalWrite(el_incremental_encoder_pin_phase_z, HIGH);
   #endif // OPTION_INCREMENTAL_ENCODER_PULLUPS
+  initialize_incremental_encoder_pins(el_incremental_encoder_pins, el_incremental_encoder_pin_phase_a, el_incremental_encoder_pin_phase_b, el_incremental_encoder_pin_phase_z);
+  el_incremental_encoder_last_phases = read_incremental_encoder_phases(el_incremental_encoder_pins) & INCREMENTAL_ENCODER_PHASES_AB;
   attachInterrupt(EL_POSITION_INCREMENTAL_ENCODER_A_PIN_INTERRUPT, el_position_incremental_encoder_interrupt_handler, CHANGE);
   attachInterrupt(EL_POSITION_INCREMENTAL_ENCODER_B_PIN_INTERRUPT, el_position_incremental_encoder_interrupt_handler, CHANGE);
   delay(250);
-  el_3_phase_encoder_last_phase_a_state = digitalRead(el_incremental_encoder_pin_phase_a);
-  el_3_phase_encoder_last_phase_b_state = digitalRead(el_incremental_encoder_pin_phase_b);
   #endif // defined(FEATURE_EL_POSITION_INCREMENTAL_ENCODER) && defined(FEATURE_ELEVATION_CONTROL)
 
 } /* initialize_rotary_encoders */
@@ -4526,6 +4986,9 @@ void service_nextion_display(){
 
   #if defined(FEATURE_SATELLITE_TRACKING)
     unsigned int temp2 = 0;
+    #if !defined(OPTION_USE_OLD_TIME_CODE)
+      satellite_pass* next_pass;
+    #endif
   #endif
 
   #if defined(DEBUG_NEXTION_COMMANDS_COMING_FROM_NEXTION)
@@ -5728,6 +6191,25 @@ TODO:
           strcat(workstring1,workstring2);
           sendNextionCommand(workstring1);   
 
+          #if !defined(OPTION_USE_OLD_TIME_CODE)
+            if (moon_events.complete){  // next rise, set, and transit, UTC
+              strcpy_P(workstring1,(const char*) F("vMRT.txt=\""));
+              strcat(workstring1,sun_moon_event_string(moon_events.rise));
+              strcat(workstring1,"\"");
+              sendNextionCommand(workstring1);
+
+              strcpy_P(workstring1,(const char*) F("vMST.txt=\""));
+              strcat(workstring1,sun_moon_event_string(moon_events.set));
+              strcat(workstring1,"\"");
+              sendNextionCommand(workstring1);
+
+              strcpy_P(workstring1,(const char*) F("vMTT.txt=\""));
+              strcat(workstring1,sun_moon_event_string(moon_events.transit));
+              strcat(workstring1,"\"");
+              sendNextionCommand(workstring1);
+            }
+          #endif
+
         #endif // FEATURE_MOON_TRACKING
 
 
@@ -5761,6 +6243,25 @@ TODO:
           strcat(workstring1,workstring2);
           sendNextionCommand(workstring1);   
 
+          #if !defined(OPTION_USE_OLD_TIME_CODE)
+            if (sun_events.complete){  // next rise, set, and transit, UTC
+              strcpy_P(workstring1,(const char*) F("vSRT.txt=\""));
+              strcat(workstring1,sun_moon_event_string(sun_events.rise));
+              strcat(workstring1,"\"");
+              sendNextionCommand(workstring1);
+
+              strcpy_P(workstring1,(const char*) F("vSST.txt=\""));
+              strcat(workstring1,sun_moon_event_string(sun_events.set));
+              strcat(workstring1,"\"");
+              sendNextionCommand(workstring1);
+
+              strcpy_P(workstring1,(const char*) F("vSTT.txt=\""));
+              strcat(workstring1,sun_moon_event_string(sun_events.transit));
+              strcat(workstring1,"\"");
+              sendNextionCommand(workstring1);
+            }
+          #endif
+
         #endif // FEATURE_SUN_TRACKING
 
         #ifdef FEATURE_SATELLITE_TRACKING
@@ -5857,10 +6358,16 @@ TODO:
 
           if (satellite_array_data_ready){
             for (int x = 0;x < NEXTION_NUMBER_OF_NEXT_SATELLITES;x++){
-              temp2 = 0;
-              while ((temp2 < SATELLITE_LIST_LENGTH) && (satellite[temp2].order != x)){
-                temp2++;
-              }
+              #if defined(OPTION_USE_OLD_TIME_CODE)
+                temp2 = 0;
+                while ((temp2 < SATELLITE_LIST_LENGTH) && (satellite[temp2].order != x)){
+                  temp2++;
+                }
+                if (temp2 >= SATELLITE_LIST_LENGTH){break;}
+              #else
+                if (x >= satellite_order_list_count){break;}
+                temp2 = satellite_order_list[x];
+              #endif
 
               strcpy_P(workstring1,(const char*) F("vSatN"));
               dtostrf(x+1,0,0,workstring2);
@@ -5889,6 +6396,22 @@ TODO:
               }
               sendNextionCommand(workstring1);               
 
+              #if !defined(OPTION_USE_OLD_TIME_CODE)
+                strcpy_P(workstring1,(const char*) F("vSatE"));
+                dtostrf(x+1,0,0,workstring2);
+                strcat(workstring1,workstring2);
+                strcat_P(workstring1,(const char*) F(".val="));
+                expire_satellite_passes(temp2);
+                next_pass = get_satellite_pass(temp2,0);
+                if (next_pass != NULL){
+                  dtostrf(next_pass->max_el,0,0,workstring2);
+                  strcat(workstring1,workstring2);
+                } else {
+                  strcat(workstring1,"0");
+                }
+                sendNextionCommand(workstring1);
+              #endif
+
             } //for (int x = 0;x < NEXTION_NUMBER_OF_NEXT_SATELLITES;x++){
           } else { //if (satellite_array_data_ready){
             strcpy_P(workstring1,(const char*) F("vSatO1.txt=\"not ready\""));
@@ -7201,6 +7724,24 @@ byte calculated_configuration_struct_subversion(){
 
 }
 
+// --------------------------------------------------------------
+unsigned int eeprom_end(){
+
+  // the end of what we use at the top of EEPROM (the TLE file directory and the calibration tables loaded
+  // with \>); the last 5 bytes are left alone
+
+  #if (!defined(ARDUINO_SAM_DUE) || (defined(ARDUINO_SAM_DUE) && defined(FEATURE_EEPROM_E24C1024))) && !defined(HARDWARE_GENERIC_STM32F103C)
+    return EEPROM.length() - 5;
+  #else
+    #if defined(HARDWARE_GENERIC_STM32F103C)
+      return 254 - 5;
+    #else
+      return 1024 - 5; // not sure if this is a valid assumption
+    #endif
+  #endif
+
+}
+
 // --------------------------------------------------------------
 void read_settings_from_eeprom(){
 
@@ -7209,16 +7750,8 @@ void read_settings_from_eeprom(){
   int ee = 0;
 
 
-  #if defined(FEATURE_SATELLITE_TRACKING)
-    #if (!defined(ARDUINO_SAM_DUE) || (defined(ARDUINO_SAM_DUE) && defined(FEATURE_EEPROM_E24C1024))) && !defined(HARDWARE_GENERIC_STM32F103C)
-      tle_file_eeprom_memory_area_end = EEPROM.length() - 5;
-    #else
-      #if defined(HARDWARE_GENERIC_STM32F103C)
-        tle_file_eeprom_memory_area_end = 254 - 5;
-      #else
-        tle_file_eeprom_memory_area_end = 1024 - 5; // not sure if this is a valid assumption
-      #endif  
-    #endif
+  #if defined(FEATURE_SATELLITE_TRACKING) && !defined(FEATURE_SATELLITE_TLE_CATALOG_SD)
+    tle_file_eeprom_memory_area_end = eeprom_end() - TLE_FILE_DIRECTORY_SIZE - azimuth_correction_table_eeprom_size - elevation_correction_table_eeprom_size;
   #endif //FEATURE_SATELLITE_TRACKING
 
   for (i = 0; i < sizeof(configuration); i++) {
@@ -7333,9 +7866,9 @@ void read_settings_from_eeprom(){
     initialize_eeprom_with_defaults();
   }
 
-
-
-
+  #if defined(FEATURE_SATELLITE_TRACKING) && !defined(FEATURE_SATELLITE_TLE_CATALOG_SD)
+    check_tle_file_eeprom_layout();  // after initialize_eeprom_with_defaults(), which empties the TLE file anyway
+  #endif //FEATURE_SATELLITE_TRACKING
 
 } /* read_settings_from_eeprom */
 
@@ -7476,6 +8009,152 @@ void write_settings_to_eeprom(){
 
 }
 
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TLE_CATALOG_SD)
+  void initialize_tle_catalog(){
+
+    // open the TLE file and its directory on the SD card; if there's no card they stay closed and the TLE file reads as empty
+
+    pinModeEnhanced(satellite_tle_catalog_sd_cs_pin, OUTPUT);
+
+    if (!SD.begin(satellite_tle_catalog_sd_cs_pin)){
+      #if defined(DEBUG_SATELLITE_TLE_EEPROM)
+        debug.println(F("initialize_tle_catalog: SD.begin failed"));
+      #endif
+      return;
+    }
+
+    // not FILE_WRITE, it appends every write to the end of the file
+    tle_catalog_file = SD.open(SATELLITE_TLE_CATALOG_SD_FILE,O_READ|O_WRITE|O_CREAT);
+    tle_catalog_directory_file = SD.open(SATELLITE_TLE_CATALOG_SD_DIRECTORY_FILE,O_READ|O_WRITE|O_CREAT);
+
+    if (tle_catalog_file){
+      if (tle_catalog_file.size() == 0){
+        tle_catalog_write(0,0xFF);
+        tle_catalog_flush();
+      }
+    }
+
+    #if defined(DEBUG_SATELLITE_TLE_EEPROM)
+      debug.print(F("initialize_tle_catalog: file size:"));
+      if (tle_catalog_file){
+        debug.print(tle_catalog_file.size());
+      } else {
+        debug.print(F("<didn't open>"));
+      }
+      debug.println("");
+    #endif
+
+  }
+#endif //FEATURE_SATELLITE_TLE_CATALOG_SD
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING)
+  byte tle_catalog_read(unsigned long location){
+
+    // read a byte of the TLE file; location is the offset from the start of the file
+    // past the end of the storage reads as 0xFF, the end of file marker
+
+    #if defined(FEATURE_SATELLITE_TLE_CATALOG_SD)
+      if ((!tle_catalog_file) || (location >= tle_catalog_file.size())){return 0xFF;}
+      if (tle_catalog_file.position() != location){  // reading along the file doesn't need a seek
+        tle_catalog_file.seek(location);
+      }
+      return tle_catalog_file.read();
+    #else
+      if (location >= tle_catalog_size()){return 0xFF;}
+      return EEPROM.read(tle_file_eeprom_memory_area_start + location);
+    #endif
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING)
+  void tle_catalog_write(unsigned long location, byte byte_to_write){
+
+    #if defined(FEATURE_SATELLITE_TLE_CATALOG_SD)
+      if (!tle_catalog_file){return;}
+      if (tle_catalog_file.position() != location){
+        tle_catalog_file.seek(location);
+      }
+      tle_catalog_file.write(byte_to_write);
+      tle_catalog_bytes_written++;
+    #else
+      if (location >= tle_catalog_size()){return;}
+      // an EEPROM write takes milliseconds and wears the cell, a read doesn't, so only write what's different
+      // (reloading the same or a slightly changed TLE file rewrites very little)
+      if (EEPROM.read(tle_file_eeprom_memory_area_start + location) != byte_to_write){
+        EEPROM.write(tle_file_eeprom_memory_area_start + location,byte_to_write);
+        tle_catalog_bytes_written++;
+      } else {
+        tle_catalog_bytes_unchanged++;
+      }
+    #endif
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING)
+  unsigned long tle_catalog_size(){
+
+    // how big the TLE file can be
+
+    #if defined(FEATURE_SATELLITE_TLE_CATALOG_SD)
+      return SATELLITE_TLE_CATALOG_SD_MAX_BYTES;
+    #else
+      return tle_file_eeprom_memory_area_end - tle_file_eeprom_memory_area_start;
+    #endif
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING)
+  byte tle_catalog_directory_read(unsigned long location){
+
+    // read a byte of the TLE file directory
+
+    #if defined(FEATURE_SATELLITE_TLE_CATALOG_SD)
+      if ((!tle_catalog_directory_file) || (location >= tle_catalog_directory_file.size())){return 0xFF;}
+      if (tle_catalog_directory_file.position() != location){
+        tle_catalog_directory_file.seek(location);
+      }
+      return tle_catalog_directory_file.read();
+    #else
+      return EEPROM.read(tle_file_directory_eeprom_start + location);
+    #endif
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING)
+  void tle_catalog_directory_write(unsigned long location, byte byte_to_write){
+
+    #if defined(FEATURE_SATELLITE_TLE_CATALOG_SD)
+      if (!tle_catalog_directory_file){return;}
+      if (tle_catalog_directory_file.position() != location){
+        tle_catalog_directory_file.seek(location);
+      }
+      tle_catalog_directory_file.write(byte_to_write);
+    #else
+      if (EEPROM.read(tle_file_directory_eeprom_start + location) != byte_to_write){
+        EEPROM.write(tle_file_directory_eeprom_start + location,byte_to_write);
+      }
+    #endif
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING)
+  void tle_catalog_flush(){
+
+    // make sure everything written to the TLE file and directory is actually stored
+
+    #if defined(FEATURE_SATELLITE_TLE_CATALOG_SD)
+      if (tle_catalog_file){tle_catalog_file.flush();}
+      if (tle_catalog_directory_file){tle_catalog_directory_file.flush();}
+    #endif
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
 // --------------------------------------------------------------
 #if defined(FEATURE_SATELLITE_TRACKING)
   void initialize_tle_file_area_eeprom(byte verbose){
@@ -7488,10 +8167,14 @@ void write_settings_to_eeprom(){
 
     // Don't need to "erase" all the locations, just the first one
 
-    EEPROM.write(tle_file_eeprom_memory_area_start,0xFF);
+    tle_catalog_write(0,0xFF);
+
+    invalidate_tle_file_directory();
+    invalidate_satellite_element_cache();
+    tle_catalog_flush();
 
     if (verbose){
-      control_port->print(tle_file_eeprom_memory_area_end-tle_file_eeprom_memory_area_start);
+      control_port->print(tle_catalog_size());
       control_port->println(F(" bytes free"));
     }
 
@@ -7519,8 +8202,20 @@ void write_settings_to_eeprom(){
       satellite[x].next_pass_max_el = 0;
       satellite[x].order = 0;
       satellite[x].status = 255;
+      satellite[x].catalog_entry = TLE_FILE_DIRECTORY_NOT_FOUND;
+      #if !defined(OPTION_USE_OLD_TIME_CODE)
+        clear_satellite_passes(x);
+        clear_satellite_refresh_schedule(x);
+      #endif
     } 
 
+    #if !defined(OPTION_USE_OLD_TIME_CODE)
+      clear_satellite_track();
+      update_satellite_array_order();
+    #endif
+
+    invalidate_satellite_element_cache();
+
   }
 #endif //FEATURE_SATELLITE_TRACKING
 
@@ -7533,7 +8228,7 @@ void write_settings_to_eeprom(){
 
     // returns 1 if write was successful, 0 if we hit the end of the eeprom space
 
-    static unsigned int eeprom_write_location = 0;
+    static unsigned long eeprom_write_location = 0;
 
     #ifdef DEBUG_SATELLITE_TLE_EEPROM
       control_port->print(F("\r\nwrite_char_to_tle_file_area_eeprom: "));
@@ -7547,8 +8242,8 @@ void write_settings_to_eeprom(){
     if (initialize_to_start){
       eeprom_write_location = 0;
     } else {
-      if ((tle_file_eeprom_memory_area_start + eeprom_write_location) < tle_file_eeprom_memory_area_end){
-        EEPROM.write((tle_file_eeprom_memory_area_start + eeprom_write_location),char_to_write);
+      if (eeprom_write_location < tle_catalog_size()){
+        tle_catalog_write(eeprom_write_location,char_to_write);
         eeprom_write_location++;
         return 1;
       }
@@ -7570,26 +8265,52 @@ void write_settings_to_eeprom(){
     // 4 = initialized
     // 5 = line overrun
 
-    static unsigned int eeprom_location = tle_file_eeprom_memory_area_start;
     char eeprom_read[2];
     char tle_line[SATELLITE_TLE_CHAR_SIZE]; //make this global for giggles
     byte hit_return = 0;
     byte char_counter = 0;
     byte eeprom_byte;
 
-    if (EEPROM.read(tle_file_eeprom_memory_area_start) == 0xFF){
+    if (tle_catalog_read(0) == 0xFF){
       return 1;
     }  
     if (initialize_to_start_of_file){
-      eeprom_location = tle_file_eeprom_memory_area_start;
+      tle_file_eeprom_read_location = 0;
+      tle_file_record_packed = 0;
       return 4;
     }
 
+    if (tle_file_record_packed){  // nobody wanted the elements of the last packed record, skip over them
+      tle_file_eeprom_read_location = tle_file_eeprom_read_location + SAT_ELEMENTS_PACKED_SIZE + 1;
+      tle_file_record_packed = 0;
+    }
+
+    if ((tle_file_eeprom_read_location + 1) >= tle_catalog_size()){
+      return 3;
+    }
+
+    if (tle_catalog_read(tle_file_eeprom_read_location) == TLE_FILE_PACKED_RECORD_MARKER){  // packed record, the name is all there is in the way of lines
+      char_counter = tle_catalog_read(tle_file_eeprom_read_location + 1);
+      if (char_counter > (SATELLITE_NAME_LENGTH - 1)){
+        return 5;
+      }
+      if ((tle_file_eeprom_read_location + TLE_FILE_PACKED_RECORD_SIZE(char_counter)) > tle_catalog_size()){
+        return 3;
+      }
+      for (byte x = 0;x < char_counter;x++){
+        tle_line_out[x] = tle_catalog_read(tle_file_eeprom_read_location + 2 + x);
+      }
+      tle_line_out[char_counter] = 0;
+      tle_file_eeprom_read_location = tle_file_eeprom_read_location + 2 + char_counter;
+      tle_file_record_packed = 1;
+      return 0;
+    }
+
     strcpy(tle_line,"");
     eeprom_read[1] = 0;
 
-    while ((eeprom_location < tle_file_eeprom_memory_area_end) && (!hit_return) && (char_counter < 71)){
-      eeprom_byte = EEPROM.read(eeprom_location);
+    while ((tle_file_eeprom_read_location < tle_catalog_size()) && (!hit_return) && (char_counter < 71)){
+      eeprom_byte = tle_catalog_read(tle_file_eeprom_read_location);
       eeprom_read[0] = eeprom_byte;
       char_counter++;
       if (eeprom_byte == 254 /*'\r'*/){
@@ -7602,10 +8323,10 @@ void write_settings_to_eeprom(){
           strcat(tle_line,eeprom_read);
         }
       }  
-      eeprom_location++;
+      tle_file_eeprom_read_location++;
     }
 
-    if (eeprom_location == tle_file_eeprom_memory_area_end){
+    if (tle_file_eeprom_read_location == tle_catalog_size()){
       return 3;
     }
 
@@ -7622,50 +8343,418 @@ void write_settings_to_eeprom(){
 #endif //FEATURE_SATELLITE_TRACKING
 // --------------------------------------------------------------
 #if defined(FEATURE_SATELLITE_TRACKING)
-  byte pull_satellite_tle_and_activate(char* satellite_to_find,byte verbose,byte where_to_activate_it){
+  void seek_tle_file_eeprom(unsigned int directory_entry){
 
-    // returns
-    // 1 = found it
-    // 0 = didn't find it
- 
-    byte get_line_result;
-    byte stop_looping1 = 0;
-    byte stop_looping2 = 0;
-    char tle_line1[SATELLITE_TLE_CHAR_SIZE];
-    char tle_line2[SATELLITE_TLE_CHAR_SIZE];
-    byte found_it = 0;
-    byte invalid = 0;
-    byte pass = 0;
-    byte string_pointer = 0;
-    char alternate_satellite_search_string[SATELLITE_NAME_LENGTH];
+    // position get_line_from_tle_file_eeprom() at the start of a satellite record using the directory
 
-    #if defined(DEBUG_SATELLITE_TRACKING_LOAD)
-      debug.println(F("pull_satellite_tle_and_activate: start"));
-    #endif
+    unsigned long directory_location = TLE_FILE_DIRECTORY_HEADER_SIZE + ((unsigned long)directory_entry * TLE_FILE_DIRECTORY_ENTRY_SIZE);
 
-    if (verbose == _VERBOSE_){
-      control_port->print(F("Loading satellite "));
-      control_port->println(satellite_to_find);
+    tle_file_eeprom_read_location = 0;
+    tle_file_record_packed = 0;
+    for (byte x = 1;x <= TLE_FILE_DIRECTORY_OFFSET_SIZE;x++){
+      tle_file_eeprom_read_location = (tle_file_eeprom_read_location * 256) + tle_catalog_directory_read(directory_location + x);
     }
 
-    for (int x = 0;x < SATELLITE_NAME_LENGTH;x++){
-      if ((satellite_to_find[x] != ' ') && (satellite_to_find[x] != '-') && (satellite_to_find[x] != '/')){
-        alternate_satellite_search_string[string_pointer] = satellite_to_find[x];
-        string_pointer++;
-      }
-      if (satellite_to_find[x] == 0){
-        x = SATELLITE_NAME_LENGTH;
-      }
-    }
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING)
+  unsigned long tle_catalog_read_packed(unsigned long location,byte bytes){
 
-    while(!stop_looping2){
+    // read a big endian number out of a packed record
 
-      get_line_from_tle_file_eeprom(NULL,1);
+    unsigned long value = 0;
 
-      stop_looping1 = 0;
+    for (byte x = 0;x < bytes;x++){
+      value = (value * 256) + tle_catalog_read(location + x);
+    }
 
-      while(!stop_looping1){
-        
+    return value;
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING)
+  byte get_elements_from_tle_file_eeprom(SatElements &elements){
+
+    // read the elements of the record whose name get_line_from_tle_file_eeprom() just returned, either
+    // straight out of a packed record or by parsing the two TLE lines that follow the name
+
+    // returns
+    // 0 = successful read
+    // 1 = couldn't read the record
+    // 2 = record is corrupt
+
+    unsigned char packed_elements[SAT_ELEMENTS_PACKED_SIZE];
+    char tle_line1[SATELLITE_TLE_CHAR_SIZE];
+    char tle_line2[SATELLITE_TLE_CHAR_SIZE];
+    byte checksum = 0;
+
+    if (tle_file_record_packed){
+      tle_file_record_packed = 0;
+      for (byte x = 0;x < SAT_ELEMENTS_PACKED_SIZE;x++){
+        packed_elements[x] = tle_catalog_read(tle_file_eeprom_read_location + x);
+        checksum = checksum + packed_elements[x];
+      }
+      if (checksum != tle_catalog_read(tle_file_eeprom_read_location + SAT_ELEMENTS_PACKED_SIZE)){
+        return 2;
+      }
+      tle_file_eeprom_read_location = tle_file_eeprom_read_location + SAT_ELEMENTS_PACKED_SIZE + 1;
+      elements.packed(packed_elements);
+      return 0;
+    }
+
+    if ((get_line_from_tle_file_eeprom(tle_line1,0) != 0) || (get_line_from_tle_file_eeprom(tle_line2,0) != 0)){
+      return 1;
+    }
+    if (!tle_lines_valid(tle_line1,tle_line2)){
+      return 2;
+    }
+    elements.tle(tle_line1,tle_line2);
+    return 0;
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING)
+  byte tle_name_hash(char* satellite_name){
+
+    byte hash = 0;
+
+    for (int x = 0;(x < SATELLITE_TLE_CHAR_SIZE) && (satellite_name[x] != 0);x++){
+      hash = (hash * 31) + satellite_name[x];
+    }
+
+    return hash;
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING)
+  unsigned int tle_file_directory_find(char* satellite_name){
+
+    // returns the directory entry with exactly this satellite name, or TLE_FILE_DIRECTORY_NOT_FOUND
+
+    char tle_line[SATELLITE_TLE_CHAR_SIZE];
+    byte search_hash = tle_name_hash(satellite_name);
+
+    if (!tle_file_directory_valid){return TLE_FILE_DIRECTORY_NOT_FOUND;}
+
+    for (unsigned int directory_entry = 0;directory_entry < tle_file_directory_count;directory_entry++){
+      if (tle_catalog_directory_read(TLE_FILE_DIRECTORY_HEADER_SIZE + ((unsigned long)directory_entry * TLE_FILE_DIRECTORY_ENTRY_SIZE)) == search_hash){
+        seek_tle_file_eeprom(directory_entry);
+        if ((get_line_from_tle_file_eeprom(tle_line,0) == 0) && (strcmp(tle_line,satellite_name) == 0)){
+          return directory_entry;
+        }
+      }
+    }
+
+    return TLE_FILE_DIRECTORY_NOT_FOUND;
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING)
+  void invalidate_tle_file_directory(){
+
+    tle_catalog_directory_write(0,0xFF);
+    tle_file_directory_valid = 0;
+    tle_file_directory_count = 0;
+    tle_file_directory_flags = 0;
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING) && !defined(FEATURE_SATELLITE_TLE_CATALOG_SD)
+  byte tle_file_ends_before(unsigned long limit){
+
+    // returns 1 if the TLE file's end of file marker comes before limit (an offset from the start of the file)
+    // packed records are stepped over whole so a 0xFF in their elements isn't taken for the end of the file
+
+    unsigned long file_location = 0;
+    byte file_byte;
+    byte line_number = 0;
+
+    while (file_location < limit){
+      file_byte = tle_catalog_read(file_location);
+      if (file_byte == 0xFF){
+        return 1;
+      }
+      if ((line_number == 0) && (file_byte == TLE_FILE_PACKED_RECORD_MARKER)){
+        file_location = file_location + TLE_FILE_PACKED_RECORD_SIZE(tle_catalog_read(file_location + 1));
+      } else {
+        if (file_byte == 254){
+          line_number++;
+          if (line_number > 2){line_number = 0;}
+        }
+        file_location++;
+      }
+    }
+    return 0;
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING) && !defined(FEATURE_SATELLITE_TLE_CATALOG_SD)
+  void check_tle_file_eeprom_layout(){
+
+    // The TLE file area ends where the calibration tables start, so turning FEATURE_AZIMUTH_CORRECTION or
+    // FEATURE_ELEVATION_CORRECTION on or off, or changing their EEPROM points, moves the end.  So does coming
+    // from a version without the TLE file directory: those had no end stored here, and the file could go right
+    // to eeprom_end(), where the directory is now.  A file that doesn't end before both the old and the new end
+    // would have its last records cut off or written over by the directory or the tables, so rather than keep part
+    // of it and say nothing, the whole file is emptied, along with its directory, and has to be loaded again.
+
+    unsigned int stored_area_end = eeprom_end();
+    unsigned int shorter_area_end;
+
+    if (EEPROM.read(tle_file_layout_eeprom_start) == TLE_FILE_LAYOUT_MAGIC){
+      stored_area_end = (EEPROM.read(tle_file_layout_eeprom_start + 1) * 256) + EEPROM.read(tle_file_layout_eeprom_start + 2);
+    }
+
+    if (stored_area_end != tle_file_eeprom_memory_area_end){
+      shorter_area_end = min(stored_area_end, tle_file_eeprom_memory_area_end);
+      if ((shorter_area_end <= tle_file_eeprom_memory_area_start) || (!tle_file_ends_before(shorter_area_end - tle_file_eeprom_memory_area_start))){
+        #if defined(DEBUG_EEPROM)
+          debug.println("check_tle_file_eeprom_layout: TLE file doesn't fit the new TLE file area, emptying it");
+        #endif
+        if (control_port){
+          control_port->println(F("TLE file area changed and the stored TLE file didn't fit, please load it again"));
+        }
+        tle_catalog_write(0,0xFF);  // end of file
+        invalidate_tle_file_directory();
+      }
+    }
+
+    if (EEPROM.read(tle_file_layout_eeprom_start) != TLE_FILE_LAYOUT_MAGIC){EEPROM.write(tle_file_layout_eeprom_start,TLE_FILE_LAYOUT_MAGIC);}
+    if (EEPROM.read(tle_file_layout_eeprom_start + 1) != highByte(tle_file_eeprom_memory_area_end)){EEPROM.write(tle_file_layout_eeprom_start + 1,highByte(tle_file_eeprom_memory_area_end));}
+    if (EEPROM.read(tle_file_layout_eeprom_start + 2) != lowByte(tle_file_eeprom_memory_area_end)){EEPROM.write(tle_file_layout_eeprom_start + 2,lowByte(tle_file_eeprom_memory_area_end));}
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING)
+  byte load_tle_file_directory(){
+
+    // returns 1 if there is a valid directory in EEPROM, 0 if not
+
+    byte checksum = 0;
+
+    tle_file_directory_valid = 0;
+    tle_file_directory_count = (tle_catalog_directory_read(1) * 256) + tle_catalog_directory_read(2);
+    tle_file_directory_flags = tle_catalog_directory_read(3);
+
+    if ((tle_catalog_directory_read(0) != TLE_FILE_DIRECTORY_MAGIC) || (tle_file_directory_count > TLE_FILE_DIRECTORY_LENGTH)){
+      tle_file_directory_count = 0;
+      tle_file_directory_flags = 0;
+      return 0;
+    }
+
+    checksum = highByte(tle_file_directory_count) + lowByte(tle_file_directory_count) + tle_file_directory_flags;
+    for (unsigned long x = 0;x < ((unsigned long)tle_file_directory_count * TLE_FILE_DIRECTORY_ENTRY_SIZE);x++){
+      checksum = checksum + tle_catalog_directory_read(TLE_FILE_DIRECTORY_HEADER_SIZE + x);
+    }
+
+    if (checksum != tle_catalog_directory_read(4)){
+      tle_file_directory_count = 0;
+      tle_file_directory_flags = 0;
+      return 0;
+    }
+
+    tle_file_directory_valid = 1;
+    return 1;
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING)
+  void write_tle_file_directory(){
+
+    // Scan the TLE file once and write a directory entry (name hash, offset, length) for each satellite record
+    // so readers can go straight to a record rather than scanning the file
+
+    unsigned long file_location = 0;
+    unsigned long record_start = 0;
+    unsigned long directory_location;
+    unsigned long file_size = tle_catalog_size();
+    byte file_byte;
+    byte line_number = 0;
+    byte hash = 0;
+    byte checksum = 0;
+    byte name_length;
+
+    invalidate_tle_file_directory();
+
+    while (file_location < file_size){
+      file_byte = tle_catalog_read(file_location);
+      if (file_byte == 0xFF){  // end of file
+        file_location = file_size;
+      } else {
+        if ((file_location == record_start) && (file_byte == TLE_FILE_PACKED_RECORD_MARKER) && ((file_location + 1) < file_size)){
+          // packed record, the length comes from the name length so skip straight to its last byte
+          name_length = tle_catalog_read(file_location + 1);
+          if ((name_length > (SATELLITE_NAME_LENGTH - 1)) || ((file_location + TLE_FILE_PACKED_RECORD_SIZE(name_length)) > file_size)){
+            break;  // corrupt, don't index anything past it
+          }
+          for (byte x = 0;x < name_length;x++){
+            hash = (hash * 31) + tle_catalog_read(file_location + 2 + x);
+          }
+          file_location = file_location + TLE_FILE_PACKED_RECORD_SIZE(name_length) - 1;
+          line_number = 2;  // and let its last byte close the record like the end of a text record's line 2
+          file_byte = 254;
+        }
+        if (file_byte == 254){
+          line_number++;
+          if (line_number > 2){  // end of a record
+            if (tle_file_directory_count < TLE_FILE_DIRECTORY_LENGTH){
+              if ((file_location - record_start) < 255){
+                directory_location = TLE_FILE_DIRECTORY_HEADER_SIZE + ((unsigned long)tle_file_directory_count * TLE_FILE_DIRECTORY_ENTRY_SIZE);
+                tle_catalog_directory_write(directory_location,hash);
+                checksum = checksum + hash;
+                for (byte x = TLE_FILE_DIRECTORY_OFFSET_SIZE;x > 0;x--){
+                  tle_catalog_directory_write(directory_location + x,(record_start >> (8 * (TLE_FILE_DIRECTORY_OFFSET_SIZE - x))) & 0xFF);
+                  checksum = checksum + ((record_start >> (8 * (TLE_FILE_DIRECTORY_OFFSET_SIZE - x))) & 0xFF);
+                }
+                tle_catalog_directory_write(directory_location + TLE_FILE_DIRECTORY_OFFSET_SIZE + 1,(file_location - record_start) + 1);
+                checksum = checksum + (file_location - record_start) + 1;
+                tle_file_directory_count++;
+              } else {  // too long for the length byte, leave it to a file scan
+                tle_file_directory_flags = tle_file_directory_flags | TLE_FILE_DIRECTORY_INCOMPLETE;
+              }
+            } else {
+              tle_file_directory_flags = tle_file_directory_flags | TLE_FILE_DIRECTORY_INCOMPLETE;
+            }
+            line_number = 0;
+            hash = 0;
+            record_start = file_location + 1;
+          }
+        } else {
+          if ((line_number == 0) && (file_byte != '\n')){
+            hash = (hash * 31) + file_byte;
+          }
+        }
+        file_location++;
+      }
+    }
+
+    checksum = checksum + highByte(tle_file_directory_count) + lowByte(tle_file_directory_count) + tle_file_directory_flags;
+    tle_catalog_directory_write(1,highByte(tle_file_directory_count));
+    tle_catalog_directory_write(2,lowByte(tle_file_directory_count));
+    tle_catalog_directory_write(3,tle_file_directory_flags);
+    tle_catalog_directory_write(4,checksum);
+    tle_catalog_flush();
+    tle_catalog_directory_write(0,TLE_FILE_DIRECTORY_MAGIC);  // write this last so an interrupted write leaves the directory invalid
+    tle_catalog_flush();
+    tle_file_directory_valid = 1;
+
+    #if defined(DEBUG_SATELLITE_TLE_EEPROM)
+      debug.print(F("write_tle_file_directory: entries:"));
+      debug.print(tle_file_directory_count);
+      debug.print(F(" flags:"));
+      debug.println(tle_file_directory_flags);
+    #endif
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING)
+  byte tle_lines_valid(char* tle_line1,char* tle_line2){
+
+    // TLE error checking
+    //           11111111112222222222333333333334444444444555555555566666666
+    // 012345678901234567890123456789012345678901234567890123456789012345678
+    // Max Valier Sat
+    // 1 42778U 17036P   20205.42106858  .00000564  00000-0  27122-4 0  9991
+    // 2 42778 097.3024 258.0582 0010470 253.0928 106.9161 15.22670617171208
+
+    if ((tle_line1[0] != '1') || (tle_line1[7] != 'U') || (tle_line1[18] != '2') || (tle_line2[0] != '2')){return 0;}
+    if ((tle_line1[17] != ' ') || (tle_line1[23] != '.') || (tle_line1[32] != ' ') || (tle_line1[34] != '.')  || (tle_line1[43] != ' ')){return 0;}
+    if ((tle_line2[7] != ' ') || (tle_line2[11] != '.') || (tle_line2[16] != ' ') || (tle_line2[20] != '.')  || (tle_line2[25] != ' ')){return 0;}
+    if ((tle_line2[33] != ' ') || (tle_line2[37] != '.') || (tle_line2[42] != ' ') || (tle_line2[46] != '.')  || (tle_line2[51] != ' ') || (tle_line2[54] != '.')){return 0;}
+
+    return 1;
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING)
+  byte pull_satellite_tle_and_activate(char* satellite_to_find,byte verbose,byte where_to_activate_it){
+
+    // returns
+    // 1 = found it
+    // 0 = didn't find it
+ 
+    byte get_line_result;
+    byte stop_looping1 = 0;
+    byte stop_looping2 = 0;
+    char tle_line1[SATELLITE_TLE_CHAR_SIZE];
+    SatElements elements;
+    byte found_it = 0;
+    byte invalid = 0;
+    byte pass = 0;
+    byte string_pointer = 0;
+    char alternate_satellite_search_string[SATELLITE_NAME_LENGTH];
+    byte search_hash;
+    unsigned int directory_entry;
+
+    #if defined(DEBUG_SATELLITE_TRACKING_LOAD)
+      debug.println(F("pull_satellite_tle_and_activate: start"));
+    #endif
+
+    if (verbose == _VERBOSE_){
+      control_port->print(F("Loading satellite "));
+      control_port->println(satellite_to_find);
+    }
+
+    for (int x = 0;x < SATELLITE_NAME_LENGTH;x++){
+      if ((satellite_to_find[x] != ' ') && (satellite_to_find[x] != '-') && (satellite_to_find[x] != '/')){
+        alternate_satellite_search_string[string_pointer] = satellite_to_find[x];
+        string_pointer++;
+      }
+      if (satellite_to_find[x] == 0){
+        x = SATELLITE_NAME_LENGTH;
+      }
+    }
+
+    // if we have a directory, probe it for the name hash, then try the alternate name matches against just the
+    // directory's name lines; only scan the whole file if the directory couldn't hold every satellite in it
+
+    if (tle_file_directory_valid){
+      search_hash = tle_name_hash(satellite_to_find);
+      for (pass = 0;(pass < 3) && (!found_it);pass++){
+        for (directory_entry = 0;(directory_entry < tle_file_directory_count) && (!found_it);directory_entry++){
+          if ((pass > 0) || (tle_catalog_directory_read(TLE_FILE_DIRECTORY_HEADER_SIZE + ((unsigned long)directory_entry * TLE_FILE_DIRECTORY_ENTRY_SIZE)) == search_hash)){
+            seek_tle_file_eeprom(directory_entry);
+            if (get_line_from_tle_file_eeprom(tle_line1,0) == 0){
+              if ( ((pass == 0) && (strcmp(tle_line1,satellite_to_find) == 0)) || 
+                   ((pass == 1) && (strcmp(tle_line1,alternate_satellite_search_string) == 0)) || 
+                   ((pass == 2) && (strncmp(tle_line1,satellite_to_find,4) == 0))
+                   ){
+                #if defined(DEBUG_SATELLITE_TRACKING_LOAD)
+                  debug.println(F("pull_satellite_tle_and_activate: found TLE in directory"));
+                #endif
+                strcpy(satellite_to_find,tle_line1);
+                if (get_elements_from_tle_file_eeprom(elements) != 0){invalid = 1;}
+                found_it = 1;
+              }
+            }
+          }
+        }
+      }
+      if ((found_it) || (!(tle_file_directory_flags & TLE_FILE_DIRECTORY_INCOMPLETE))){
+        stop_looping2 = 1;  // no need for the full file scan below
+      }
+      pass = 0;
+    }
+
+    while(!stop_looping2){
+
+      get_line_from_tle_file_eeprom(NULL,1);
+
+      stop_looping1 = 0;
+
+      while(!stop_looping1){
+        
         get_line_result = get_line_from_tle_file_eeprom(tle_line1,0);
         if (get_line_result == 0){
             if ( ((pass == 0) && (strcmp(tle_line1,satellite_to_find) == 0)) || 
@@ -7682,21 +8771,7 @@ void write_settings_to_eeprom(){
 
               strcpy(satellite_to_find,tle_line1);
 
-              // if (verbose == _VERBOSE_){   
-              //   control_port->println(tle_line1);
-              // }             
-
-              get_line_from_tle_file_eeprom(tle_line1,0);
-
-              // if (verbose == _VERBOSE_){
-              //   control_port->println(tle_line1);
-              // }
-
-              get_line_from_tle_file_eeprom(tle_line2,0);
-
-              // if (verbose == _VERBOSE_){
-              //   control_port->println(tle_line2);  
-              // }
+              if (get_elements_from_tle_file_eeprom(elements) != 0){invalid = 1;}
 
               stop_looping1 = 1; 
               stop_looping2 = 1;       
@@ -7718,18 +8793,6 @@ void write_settings_to_eeprom(){
 
     if (found_it){
 
-      // TLE error checking
-      //           11111111112222222222333333333334444444444555555555566666666
-      // 012345678901234567890123456789012345678901234567890123456789012345678
-      // Max Valier Sat
-      // 1 42778U 17036P   20205.42106858  .00000564  00000-0  27122-4 0  9991
-      // 2 42778 097.3024 258.0582 0010470 253.0928 106.9161 15.22670617171208
-
-      if ((tle_line1[0] != '1') || (tle_line1[7] != 'U') || (tle_line1[18] != '2') || (tle_line2[0] != '2')){invalid = 1;}
-      if ((tle_line1[17] != ' ') || (tle_line1[23] != '.') || (tle_line1[32] != ' ') || (tle_line1[34] != '.')  || (tle_line1[43] != ' ')){invalid = 1;}
-      if ((tle_line2[7] != ' ') || (tle_line2[11] != '.') || (tle_line2[16] != ' ') || (tle_line2[20] != '.')  || (tle_line2[25] != ' ')){invalid = 1;}
-      if ((tle_line2[33] != ' ') || (tle_line2[37] != '.') || (tle_line2[42] != ' ') || (tle_line2[46] != '.')  || (tle_line2[51] != ' ') || (tle_line2[54] != '.')){invalid = 1;}
-
       if (!invalid){
 
         #if defined(DEBUG_SATELLITE_TRACKING_LOAD)
@@ -7737,11 +8800,11 @@ void write_settings_to_eeprom(){
         #endif
 
         if (where_to_activate_it == MAKE_IT_THE_CURRENT_SATELLITE){
-          load_satellite_tle_into_P13(satellite_to_find,tle_line1,tle_line2,DO_NOT_LOAD_HARDCODED_TLE,MAKE_IT_THE_CURRENT_SATELLITE);  
+          load_satellite_tle_into_P13(satellite_to_find,&elements,DO_NOT_LOAD_HARDCODED_TLE,MAKE_IT_THE_CURRENT_SATELLITE);  
           service_calc_satellite_data(current_satellite_position_in_array,1,UPDATE_SAT_ARRAY_SLOT_AZ_EL_NEXT_AOS_LOS,SERVICE_CALC_DO_NOT_PRINT_HEADER,SERVICE_CALC_INITIALIZE,SERVICE_CALC_DO_NOT_PRINT_DONE,0);
           configuration_dirty = 1; 
         } else {
-          load_satellite_tle_into_P13(satellite_to_find,tle_line1,tle_line2,DO_NOT_LOAD_HARDCODED_TLE,DO_NOT_MAKE_IT_THE_CURRENT_SATELLITE); 
+          load_satellite_tle_into_P13(satellite_to_find,&elements,DO_NOT_LOAD_HARDCODED_TLE,DO_NOT_MAKE_IT_THE_CURRENT_SATELLITE); 
         }
         return 1;  
       } else {
@@ -7762,66 +8825,28 @@ void write_settings_to_eeprom(){
 #if defined(FEATURE_SATELLITE_TRACKING)
 const char* get_satellite_from_tle_file(byte initialize_me_dude){
 
+    // returns the satellite name of the next record in the TLE file directory, or "" when we run out
 
-    static unsigned int eeprom_location;
-    byte eeprom_byte;
-    char eeprom_read[2];
     static char tle_line[SATELLITE_TLE_CHAR_SIZE];
-    static byte tle_line_number;
-    byte char_counter = 0;
-    byte get_out = 0;
+    static unsigned int directory_entry;
 
+    if (initialize_me_dude){
+      directory_entry = 0;
+      return NULL;
+    }
 
-    // I hope I never have to figure out what I did here when I'm 80 and trying to debug something.
+    strcpy(tle_line,"");
 
-    if ((EEPROM.read(tle_file_eeprom_memory_area_start) == 0xFF) || ((tle_line_number == 99) && (!initialize_me_dude))){
-      strcpy(tle_line,"");
-      tle_line_number = 99;
+    if ((!tle_file_directory_valid) || (directory_entry >= tle_file_directory_count)){
       return(tle_line);
-    }  
-
-    if (initialize_me_dude){
-      eeprom_location = tle_file_eeprom_memory_area_start;
-      tle_line_number = 0;
-      return NULL;
-    } else {
+    }
 
-      strcpy(tle_line,"");
-      eeprom_read[1] = 0;
-   
-      while ((eeprom_location < tle_file_eeprom_memory_area_end) && (get_out == 0) && (char_counter < 71)){
-        eeprom_byte = EEPROM.read(eeprom_location);
-        eeprom_read[0] = eeprom_byte;
-        char_counter++;
-        if (eeprom_byte == 254){
-          if (tle_line_number == 0){
-            get_out = 1;
-            tle_line_number++;
-          } else {
-            tle_line_number++;
-            if (tle_line_number > 2){tle_line_number = 0;}
-            char_counter = 0;
-            strcpy(tle_line,"");
-          }
-        } else {
-          if (eeprom_byte == 0xFF){  // hit the end of the file
-            get_out = 1;
-            #if defined(DEBUG_SATELLITE_TLE_EEPROM)
-              debug.println("get_satellite_from_tle_file: hit end");
-            #endif
-          } else {
-            if ((eeprom_read[0] != '\n') && (tle_line_number == 0)){
-              strcat(tle_line,eeprom_read);
-            }
-          }
-        }  
-        eeprom_location++;
-      }
-    }  
+    seek_tle_file_eeprom(directory_entry);
+    directory_entry++;
 
-    if ((eeprom_location >= tle_file_eeprom_memory_area_end) || (char_counter > 70) || (tle_line == "") || (eeprom_byte == 0xFF)){
+    if (get_line_from_tle_file_eeprom(tle_line,0) != 0){
       strcpy(tle_line,"");
-      tle_line_number = 99;
+      directory_entry = tle_file_directory_count;
     }
 
     if (strlen(tle_line) >= SATELLITE_NAME_LENGTH){  // something is wrong, line is too long to be a satellite name
@@ -7846,6 +8871,10 @@ const char* get_satellite_from_tle_file(byte initialize_me_dude){
     char sat_name[SATELLITE_NAME_LENGTH];
     byte hit_the_end = 0;
 
+    if (!load_tle_file_directory()){  // no directory, or it's from a file stored before we had directories
+      write_tle_file_directory();
+    }
+
     get_satellite_from_tle_file(1);
     for (int z = 0;z < SATELLITE_LIST_LENGTH;z++){
       strcpy(sat_name,get_satellite_from_tle_file(0));
@@ -7854,20 +8883,32 @@ const char* get_satellite_from_tle_file(byte initialize_me_dude){
       #endif      
       if ((strlen(sat_name) > 2) && (sat_name[0] != 0)){
         strcpy(satellite[z].name,sat_name);
+        satellite[z].catalog_entry = z;  // get_satellite_from_tle_file() goes through the directory in order
         satellite[z].next_pass_max_el = 0;
-        satellite[z].status = satellite[z].status & B11111000; // clear aos (1), timeout (2), and AOS/LOS state change (4) flags
+        satellite[z].status = satellite[z].status & B11100000; // clear aos (1), timeout (2), AOS/LOS state change (4), and never / always visible (8, 16) flags
         cleartime(&satellite[z].next_aos);
         cleartime(&satellite[z].next_los);
         satellite[z].order = 254;  // 254 = valid slot, but no order placed on it yet
       } else {
         hit_the_end = 1;
       }
+      #if !defined(OPTION_USE_OLD_TIME_CODE)
+        clear_satellite_passes(z);
+        clear_satellite_refresh_schedule(z);
+      #endif
       if (hit_the_end){
         satellite[z].order = 255; // 255 = invalid slot in the array
+        satellite[z].catalog_entry = TLE_FILE_DIRECTORY_NOT_FOUND;
       }
     }  
+    #if !defined(OPTION_USE_OLD_TIME_CODE)
+      clear_satellite_track();
+      update_satellite_array_order();
+    #endif
     satellite_array_data_ready = 0;
 
+    populate_satellite_element_cache();
+
   }
 
 
@@ -7879,86 +8920,903 @@ const char* get_satellite_from_tle_file(byte initialize_me_dude){
 #endif //FEATURE_SATELLITE_TRACKING
 // --------------------------------------------------------------
 #if defined(FEATURE_SATELLITE_TRACKING)
-  char print_tle_file_area_eeprom(){
+  byte put_satellite_in_array(char* satellite_name){
 
-    unsigned int eeprom_location;
-    byte eeprom_read;
+    // the array only holds the first SATELLITE_LIST_LENGTH satellites in the TLE file; put one from further down the
+    // file in an empty slot, or over the last one, and return the slot it's in
 
-    if (EEPROM.read(tle_file_eeprom_memory_area_start) == 0xFF){
-      control_port->println(F("<empty>"));
-    } else {
-      for (eeprom_location = tle_file_eeprom_memory_area_start; eeprom_location < tle_file_eeprom_memory_area_end; eeprom_location++) {
-        eeprom_read = EEPROM.read(eeprom_location);
-        if (eeprom_read != 0xFF){
-          if (eeprom_read == 254 /*'\r'*/){
-            control_port->println();
-          } else {
-            control_port->write(eeprom_read);
-          }
-        } else {
-          eeprom_location = tle_file_eeprom_memory_area_end;
-        }
+    byte satellite_array_position = SATELLITE_LIST_LENGTH - 1;
+
+    for (int z = 0;z < SATELLITE_LIST_LENGTH;z++){
+      if ((satellite[z].order == 255) || (strlen(satellite[z].name) < 3)){
+        satellite_array_position = z;
+        z = SATELLITE_LIST_LENGTH;
       }
     }
-  
-  }
-#endif //FEATURE_SATELLITE_TRACKING
-// --------------------------------------------------------------
 
-void az_check_operation_timeout(){
+    #if defined(DEBUG_SATELLITE_TRACKING_LOAD)
+      debug.print(F("put_satellite_in_array: "));
+      debug.print(satellite_name);
+      debug.print(F(" -> "));
+      debug.println(satellite_array_position);
+    #endif
 
-  // check if the last executed rotation operation has been going on too long
+    strncpy(satellite[satellite_array_position].name,satellite_name,SATELLITE_NAME_LENGTH-1);
+    satellite[satellite_array_position].name[SATELLITE_NAME_LENGTH-1] = 0;
+    satellite[satellite_array_position].catalog_entry = tle_file_directory_find(satellite[satellite_array_position].name);
+    satellite[satellite_array_position].azimuth = 0;
+    satellite[satellite_array_position].elevation = 0;
+    satellite[satellite_array_position].next_pass_max_el = 0;
+    satellite[satellite_array_position].status = 0;
+    cleartime(&satellite[satellite_array_position].next_aos);
+    cleartime(&satellite[satellite_array_position].next_los);
+    satellite[satellite_array_position].order = 254;
+    forget_satellite_element_cache_slot(satellite_array_position);
+    #if !defined(OPTION_USE_OLD_TIME_CODE)
+      clear_satellite_passes(satellite_array_position);
+      clear_satellite_refresh_schedule(satellite_array_position);
+      update_satellite_array_order();
+    #endif
 
+    return satellite_array_position;
 
-  if (((millis() - az_last_rotate_initiation) > OPERATION_TIMEOUT) && (az_state != IDLE)) {
-    submit_request(AZ, REQUEST_KILL, 0, 78);
-    #ifdef DEBUG_AZ_CHECK_OPERATION_TIMEOUT
-      debug.println("az_check_operation_timeout: timeout reached, aborting rotation");
-    #endif // DEBUG_AZ_CHECK_OPERATION_TIMEOUT
   }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING)
+  void invalidate_satellite_element_cache(){
 
+    for (int z = 0;z < SATELLITE_ELEMENT_CACHE_LENGTH;z++){
+      satellite_elements_slot[z] = 255;
+      satellite_elements_lru[z] = z;
+    }
 
-}
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING)
+  void forget_satellite_element_cache_slot(byte satellite_array_position){
+
+    // a satellite[] slot is getting a different satellite, drop what we had cached for it
+
+    for (int z = 0;z < SATELLITE_ELEMENT_CACHE_LENGTH;z++){
+      if (satellite_elements_slot[z] == satellite_array_position){
+        satellite_elements_slot[z] = 255;
+      }
+    }
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING)
+  byte satellite_element_cache_entry(byte satellite_array_position, byte* pinned_entries){
+
+    // returns the satellite_elements[] cache entry with the parsed TLE for a satellite[] slot, reading it in from the
+    // TLE file over the least recently used entry if it's not cached; entries flagged in pinned_entries (if not NULL)
+    // are never the ones thrown out
+    // returns 255 if it's not in the directory or there's nothing that can be thrown out
+
+    char tle_name[SATELLITE_TLE_CHAR_SIZE];
+    byte cache_entry = 255;
+    byte lru_position = 255;
+
+    for (byte z = 0;z < SATELLITE_ELEMENT_CACHE_LENGTH;z++){
+      if (satellite_elements_slot[satellite_elements_lru[z]] == satellite_array_position){
+        lru_position = z;
+        cache_entry = satellite_elements_lru[z];
+        z = SATELLITE_ELEMENT_CACHE_LENGTH;
+      }
+    }
+
+    if (cache_entry == 255){  // not cached, page it in
+      if ((!tle_file_directory_valid) || (satellite[satellite_array_position].catalog_entry >= tle_file_directory_count)){return 255;}
+      for (byte z = SATELLITE_ELEMENT_CACHE_LENGTH;z > 0;z--){
+        if ((pinned_entries == NULL) || (!pinned_entries[satellite_elements_lru[z-1]])){
+          lru_position = z-1;
+          cache_entry = satellite_elements_lru[z-1];
+          z = 1;
+        }
+      }
+      if (cache_entry == 255){return 255;}
+      seek_tle_file_eeprom(satellite[satellite_array_position].catalog_entry);
+      if ((get_line_from_tle_file_eeprom(tle_name,0) != 0) || (strcmp(satellite[satellite_array_position].name,tle_name) != 0)){return 255;}
+      if (get_elements_from_tle_file_eeprom(satellite_elements[cache_entry]) != 0){return 255;}
+      satellite_elements_slot[cache_entry] = satellite_array_position;
+      #if defined(DEBUG_SATELLITE_POPULATE_LIST_ARRAY)
+        debug.print(F("satellite_element_cache_entry: "));
+        debug.print(satellite[satellite_array_position].name);
+        debug.print(F(" -> "));
+        debug.println(cache_entry);
+      #endif
+    }
+
+    // move it to the front of the LRU list
+    for (byte z = lru_position;z > 0;z--){
+      satellite_elements_lru[z] = satellite_elements_lru[z-1];
+    }
+    satellite_elements_lru[0] = cache_entry;
+
+    return cache_entry;
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING)
+  void populate_satellite_element_cache(){
+
+    // parse as many of the satellites in the array as fit into satellite_elements[] up front so the first array refreshes
+    // don't have to go back to the TLE file
+
+    invalidate_satellite_element_cache();
+
+    for (int z = (min(SATELLITE_LIST_LENGTH,SATELLITE_ELEMENT_CACHE_LENGTH) - 1);z >= 0;z--){
+      if (satellite[z].order != 255){
+        satellite_element_cache_entry(z,NULL);
+      }
+    }
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING)
+  byte load_satellite_from_element_cache(byte satellite_array_position){
+
+    // returns
+    // 1 = satellite loaded into sat
+    // 0 = couldn't load it
+
+    byte cache_entry;
+
+    if (satellite_array_position >= SATELLITE_LIST_LENGTH){return 0;}
+
+    cache_entry = satellite_element_cache_entry(satellite_array_position,NULL);
+    if (cache_entry != 255){
+      sat.elements(satellite[satellite_array_position].name,satellite_elements[cache_entry]);
+      return 1;
+    }
+
+    // not in the directory, do it the hard way
+    if (pull_satellite_tle_and_activate(satellite[satellite_array_position].name,NOT_VERBOSE,DO_NOT_MAKE_IT_THE_CURRENT_SATELLITE)){
+      return 1;
+    }
+
+    return 0;
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING)
+  void update_satellite_array_slot_position(int satellite_array_position,double calc_satellite_elevation,double calc_satellite_azimuth,double calc_satellite_latitude,double calc_satellite_longitude){
+
+    // store a fresh az, el, lat, and long for a satellite[] slot and update its AOS flags; also the result function for Satellite::predict_all()
+
+    satellite[satellite_array_position].azimuth = (calc_satellite_azimuth * 100.0) + 0.5;
+    satellite[satellite_array_position].elevation = (calc_satellite_elevation * 100.0) + ((calc_satellite_elevation < 0) ? -0.5 : 0.5);
+    satellite[satellite_array_position].latitude = calc_satellite_latitude;
+    satellite[satellite_array_position].longitude = calc_satellite_longitude;  
+    if (current_satellite_position_in_array == satellite_array_position){
+      current_satellite_elevation = calc_satellite_elevation;
+      current_satellite_azimuth = calc_satellite_azimuth;
+      current_satellite_latitude = calc_satellite_latitude;
+      current_satellite_longitude = calc_satellite_longitude;                   
+    }
+
+    if (calc_satellite_elevation >= SATELLITE_AOS_ELEVATION_MIN){  // are we in AOS?
+      if ((satellite[satellite_array_position].status & 1) != 1){ // we were not in AOS before, set the state change flag
+        satellite[satellite_array_position].status = satellite[satellite_array_position].status | 4;
+      }
+      satellite[satellite_array_position].status = satellite[satellite_array_position].status | 1; // set AOS flag
+    } else { //no, we're in LOS
+      if ((satellite[satellite_array_position].status & 1) != 0){ // we were not in LOS before, set the state change flag
+        satellite[satellite_array_position].status = satellite[satellite_array_position].status | 4;
+      }
+      satellite[satellite_array_position].status = satellite[satellite_array_position].status & B11111110; // unset AOS flag
+    }
+
+    #if !defined(OPTION_USE_OLD_TIME_CODE)
+      if ((satellite[satellite_array_position].status & 4) == 4){place_satellite_in_order(satellite_array_position);}
+    #endif
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING)
+  void refresh_satellite_array_positions(){
+
+    // az, el, lat, and long for every satellite in the array that's due, all for the same moment in one pass;
+    // this uses sat and sat_datetime, so only call it when service_calc_satellite_data() is idle
+
+    // refresh_due[] is by element cache entry; a due satellite whose TLE can't be paged in without throwing out
+    // another one that's due this time just stays due for the next pass
+
+    byte refresh_due[SATELLITE_ELEMENT_CACHE_LENGTH];
+    byte cache_entry;
+
+    #if defined(DEBUG_SATELLITE_SERVICE)
+      debug.println(F("refresh_satellite_array_positions"));
+    #endif
+
+    obs.update_location("",latitude,longitude,altitude_m);
+
+    for (int z = 0;z < SATELLITE_ELEMENT_CACHE_LENGTH;z++){
+      refresh_due[z] = 0;
+    }
+
+    #if defined(OPTION_USE_OLD_TIME_CODE)
+      sat_datetime.settime(current_clock.year,current_clock.month,current_clock.day,current_clock.hours,current_clock.minutes,current_clock.seconds);
+      for (int z = 0;z < SATELLITE_LIST_LENGTH;z++){
+        if ((satellite[z].order != 255) && (strlen(satellite[z].name) > 2)){
+          cache_entry = satellite_element_cache_entry(z,refresh_due);
+          if (cache_entry != 255){refresh_due[cache_entry] = 1;}
+        }
+      }
+    #else
+      sat_datetime.setjulian(astro_now.julian_day,astro_now.day_fraction);
+
+      for (int z = 0;z < SATELLITE_LIST_LENGTH;z++){
+        if ((satellite[z].order != 255) && (strlen(satellite[z].name) > 2)){
+          if ((satellite_refresh[z].countdown <= 1) || (z == current_satellite_position_in_array)){
+            cache_entry = satellite_element_cache_entry(z,refresh_due);
+            if (cache_entry != 255){refresh_due[cache_entry] = 1;}
+          } else {
+            satellite_refresh[z].countdown--;
+          }
+        }
+      }
+    #endif
+
+    Satellite::predict_all(sat_datetime,obs,satellite_elements,refresh_due,SATELLITE_ELEMENT_CACHE_LENGTH,refresh_satellite_array_slot_position);
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING)
+  void refresh_satellite_array_slot_position(int cache_entry,double calc_satellite_elevation,double calc_satellite_azimuth,double calc_satellite_latitude,double calc_satellite_longitude){
+
+    // the result function for Satellite::predict_all() in refresh_satellite_array_positions(), which goes by element cache entry:
+    // store the new position and work out when this satellite is due again from how far it moved since the last refresh
+
+    byte satellite_array_position = satellite_elements_slot[cache_entry];
+
+    #if defined(OPTION_USE_OLD_TIME_CODE)
+      update_satellite_array_slot_position(satellite_array_position,calc_satellite_elevation,calc_satellite_azimuth,calc_satellite_latitude,calc_satellite_longitude);
+    #else
+    double azimuth_moved = fabs(calc_satellite_azimuth - (satellite[satellite_array_position].azimuth / 100.0));
+    double elevation_moved = fabs(calc_satellite_elevation - (satellite[satellite_array_position].elevation / 100.0));
+
+    if (azimuth_moved > 180){azimuth_moved = 360 - azimuth_moved;}
+    azimuth_moved = azimuth_moved * cos(calc_satellite_elevation * DEG_TO_RAD);
+
+    update_satellite_array_slot_position(satellite_array_position,calc_satellite_elevation,calc_satellite_azimuth,calc_satellite_latitude,calc_satellite_longitude);
+
+    satellite_refresh[satellite_array_position].refreshes++;
+    satellite_refresh[satellite_array_position].interval = satellite_array_slot_refresh_ticks(satellite_array_position,max(azimuth_moved,elevation_moved));
+    satellite_refresh[satellite_array_position].countdown = satellite_refresh[satellite_array_position].interval;
+    #endif //OPTION_USE_OLD_TIME_CODE
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING) && !defined(OPTION_USE_OLD_TIME_CODE)
+  byte satellite_array_slot_refresh_ticks(byte satellite_array_position, double degrees_moved){
+
+    // How many SATELLITE_ARRAY_AZ_EL_REFRESH_MS ticks a satellite can go before its az and el are refreshed again.  The
+    // satellite we're on and anything with an AOS / LOS state change waiting to be calculated get every tick.  One that's
+    // up gets as long as it takes to move SATELLITE_ARRAY_AZ_EL_REFRESH_DEGREES at the rate it's been moving.  Either way
+    // it's no more than half the time left to the next AOS or LOS, so the refreshes close in on the horizon crossing.
+
+    unsigned long ticks = SATELLITE_ARRAY_AZ_EL_REFRESH_MAX_MS / SATELLITE_ARRAY_AZ_EL_REFRESH_MS;
+    unsigned long rate_ticks;
+    time_t next_event = 0;
+    long seconds_to_event;
+
+    if ((satellite_array_position == current_satellite_position_in_array) || ((satellite[satellite_array_position].status & 4) == 4)){return 1;}
+
+    if ((satellite[satellite_array_position].status & 1) == 1){
+      // don't let a satellite that hardly moved stretch its interval by more than 2x at a time
+      if (degrees_moved < (SATELLITE_ARRAY_AZ_EL_REFRESH_DEGREES / 2.0)){degrees_moved = SATELLITE_ARRAY_AZ_EL_REFRESH_DEGREES / 2.0;}
+      rate_ticks = (satellite_refresh[satellite_array_position].interval * (double)SATELLITE_ARRAY_AZ_EL_REFRESH_DEGREES) / degrees_moved;
+      if (rate_ticks < ticks){ticks = rate_ticks;}
+      next_event = satellite[satellite_array_position].next_los;
+    } else {
+      next_event = satellite[satellite_array_position].next_aos;
+    }
+
+    if (next_event != 0){
+      seconds_to_event = next_event - now();
+      if (seconds_to_event <= 0){return 1;}
+      if ((unsigned long)seconds_to_event < ((ticks * SATELLITE_ARRAY_AZ_EL_REFRESH_MS) / 500)){
+        ticks = ((unsigned long)seconds_to_event * 500) / SATELLITE_ARRAY_AZ_EL_REFRESH_MS;
+      }
+    }
+
+    if (ticks < 1){ticks = 1;}
+    if (ticks > 255){ticks = 255;}
+
+    return ticks;
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING) && !defined(OPTION_USE_OLD_TIME_CODE)
+  void clear_satellite_refresh_schedule(byte satellite_array_position){
+
+    if (satellite_array_position >= SATELLITE_LIST_LENGTH){return;}
+
+    satellite_refresh[satellite_array_position].countdown = 0;
+    satellite_refresh[satellite_array_position].interval = 1;
+    satellite_refresh[satellite_array_position].refreshes = 0;
+    satellite_refresh[satellite_array_position].calcs = 0;
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING) && !defined(OPTION_USE_OLD_TIME_CODE)
+  byte next_satellite_array_slot_to_calc(byte &calc_task, byte include_timed_out){
+
+    // Pick the satellite[] slot to calculate next.  Slots with an AOS / LOS state change or without a next AOS get a full
+    // next AOS / LOS calculation first, then pass tables get topped up, and last of all (if include_timed_out) slots whose
+    // last calculation timed out get another go.  Within each of those the soonest next AOS / LOS goes first.
+
+    // returns
+    // the slot, with calc_task set to UPDATE_SAT_ARRAY_SLOT_AZ_EL_NEXT_AOS_LOS or UPDATE_SAT_ARRAY_SLOT_NEXT_PASS
+    // 255 = nothing to do
+
+    byte best_slot = 255;
+    byte best_rank = 255;
+    time_t best_event = 0;
+    byte rank;
+    time_t next_event;
+
+    for (int z = 0;z < SATELLITE_LIST_LENGTH;z++){
+      if (strlen(satellite[z].name) > 2){
+        if (((satellite[z].status & 4) == 4) || ((satellite[z].next_aos == 0) && ((satellite[z].status & 2) == 0))){
+          rank = 0;
+        } else if (satellite[z].next_aos == 0){
+          if (!include_timed_out){continue;}
+          rank = 2;
+        } else {
+          expire_satellite_passes(z);
+          if ((satellite_pass_count[z] >= SATELLITE_PASS_TABLE_LENGTH) || ((satellite[z].status & 2) == 2)){continue;}
+          rank = 1;
+        }
+        if (rank == 2){
+          next_event = satellite_refresh[z].calcs;  // no next AOS to go by, take turns
+        } else if (((satellite[z].status & 1) == 1) && (satellite[z].next_los != 0)){
+          next_event = satellite[z].next_los;
+        } else {
+          next_event = satellite[z].next_aos;
+        }
+        if ((rank < best_rank) || ((rank == best_rank) && (next_event < best_event))){
+          best_slot = z;
+          best_rank = rank;
+          best_event = next_event;
+        }
+      }
+    }
+
+    if (best_rank == 1){
+      calc_task = UPDATE_SAT_ARRAY_SLOT_NEXT_PASS;
+    } else {
+      calc_task = UPDATE_SAT_ARRAY_SLOT_AZ_EL_NEXT_AOS_LOS;
+    }
+
+    return best_slot;
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING) && !defined(OPTION_USE_OLD_TIME_CODE)
+  void clear_satellite_passes(byte satellite_array_position){
+
+    if (satellite_array_position >= SATELLITE_LIST_LENGTH){return;}
+
+    satellite_pass_first[satellite_array_position] = 0;
+    satellite_pass_count[satellite_array_position] = 0;
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING) && !defined(OPTION_USE_OLD_TIME_CODE)
+  void expire_satellite_passes(byte satellite_array_position){
+
+    // drop the passes at the front of the ring that are over
+
+    time_t time_now = now();
+    satellite_pass* first_pass;
+
+    if (satellite_array_position >= SATELLITE_LIST_LENGTH){return;}
+
+    while (satellite_pass_count[satellite_array_position] > 0){
+      first_pass = &satellite_passes[satellite_array_position][satellite_pass_first[satellite_array_position]];
+      if ((first_pass->aos + first_pass->los) >= time_now){return;}
+      satellite_pass_first[satellite_array_position] = (satellite_pass_first[satellite_array_position] + 1) % SATELLITE_PASS_TABLE_LENGTH;
+      satellite_pass_count[satellite_array_position]--;
+    }
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING) && !defined(OPTION_USE_OLD_TIME_CODE)
+  satellite_pass* get_satellite_pass(byte satellite_array_position, byte pass_number){
+
+    // pass_number 0 is the pass in progress or the next one
+
+    if ((satellite_array_position >= SATELLITE_LIST_LENGTH) || (pass_number >= satellite_pass_count[satellite_array_position])){return NULL;}
+
+    return &satellite_passes[satellite_array_position][(satellite_pass_first[satellite_array_position] + pass_number) % SATELLITE_PASS_TABLE_LENGTH];
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING) && !defined(OPTION_USE_OLD_TIME_CODE)
+  void add_satellite_pass(byte satellite_array_position, time_t aos, long los_seconds, long max_el_seconds, double aos_az, double los_az, double max_el){
+
+    satellite_pass* new_pass;
+
+    if ((satellite_array_position >= SATELLITE_LIST_LENGTH) || (satellite_pass_count[satellite_array_position] >= SATELLITE_PASS_TABLE_LENGTH)){return;}
+
+    new_pass = &satellite_passes[satellite_array_position][(satellite_pass_first[satellite_array_position] + satellite_pass_count[satellite_array_position]) % SATELLITE_PASS_TABLE_LENGTH];
+    new_pass->aos = aos;
+    new_pass->los = los_seconds;
+    if (max_el_seconds < 0){max_el_seconds = 0;}
+    new_pass->max_el_time = max_el_seconds;
+    new_pass->aos_az = aos_az;
+    new_pass->los_az = los_az;
+    new_pass->max_el = max_el;
+    satellite_pass_count[satellite_array_position]++;
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING) && !defined(OPTION_USE_OLD_TIME_CODE)
+  void print_satellite_pass_event(time_t event_time, int event_az){
+
+    control_port->print(year(event_time));
+    control_port->print("-");
+    if (month(event_time) < 10){control_port->print("0");}
+    control_port->print(month(event_time));
+    control_port->print("-");
+    if (day(event_time) < 10){control_port->print("0");}
+    control_port->print(day(event_time));
+    control_port->print(" ");
+    if (hour(event_time) < 10){control_port->print("0");}
+    control_port->print(hour(event_time));
+    control_port->print(":");
+    if (minute(event_time) < 10){control_port->print("0");}
+    control_port->print(minute(event_time));
+    control_port->print("   ");
+    if (event_az < 10){control_port->print(" ");}
+    if (event_az < 100){control_port->print(" ");}
+    control_port->print(event_az);
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING) && !defined(OPTION_USE_OLD_TIME_CODE)
+  void print_satellite_passes(byte satellite_array_position, byte number_of_passes){
+
+    // same output as the PRINT_AOS_LOS_TABULAR_REPORT in service_calc_satellite_data(), straight from the pass table
+
+    satellite_pass* pass;
+
+    control_port->println(F("\r\n                         AOS                          LOS"));
+    control_port->println(F("                ----------------------       ----------------------    el"));
+    control_port->println(F(" Sat               Date     UTC     az          Date     UTC     az    max"));
+    control_port->println(F("--------------------------------------------------------------------------"));
+
+    for (byte x = 0;x < number_of_passes;x++){
+      pass = get_satellite_pass(satellite_array_position,x);
+      if (pass == NULL){break;}
+      control_port->print(satellite[satellite_array_position].name);
+      control_port->print("\t");
+      if (strlen(satellite[satellite_array_position].name) < 8){control_port->print("\t");}
+      if (pass->aos <= now()){
+        control_port->print(F("******   now    ****** "));
+      } else {
+        print_satellite_pass_event(pass->aos,pass->aos_az);
+        control_port->print(" ");
+      }
+      control_port->print("  -   ");
+      print_satellite_pass_event(pass->aos + pass->los,pass->los_az);
+      control_port->print("    ");
+      if (pass->max_el < 10){control_port->print(" ");}
+      if (pass->max_el < 100){control_port->print(" ");}
+      control_port->println(pass->max_el);
+    }
+    control_port->println(F("Done."));
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING) && !defined(OPTION_USE_OLD_TIME_CODE)
+  void clear_satellite_track(){
+
+    satellite_track_satellite = 255;
+    satellite_track_knot_count = 0;
+    satellite_track_complete = 0;
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING) && !defined(OPTION_USE_OLD_TIME_CODE)
+  byte service_satellite_track(){
+
+    // While we're tracking a satellite that's up, precompute its pass as knots every SATELLITE_TRACK_KNOT_INTERVAL_SECS, one
+    // knot per call, so satellite_track_position() can hand out tracking targets without running the propagation.
+    // This uses sat and sat_datetime, so only call it when service_calc_satellite_data() is idle.
+
+    // returns
+    // 1 = calculated a knot
+    // 0 = nothing to do
+
+    byte track_satellite = current_satellite_position_in_array;
+    time_t knot_time;
+    double r, range_x, range_y, range_z;
+
+    if ((!satellite_tracking_active) || (track_satellite >= SATELLITE_LIST_LENGTH) || ((satellite[track_satellite].status & 1) == 0)){
+      if (satellite_track_satellite != 255){clear_satellite_track();}
+      return 0;
+    }
+
+    if (satellite_track_satellite != track_satellite){  // new pass, start one knot back so there's something to interpolate from right away
+      clear_satellite_track();
+      satellite_track_satellite = track_satellite;
+      satellite_track_start = now() - SATELLITE_TRACK_KNOT_INTERVAL_SECS;
+    }
+
+    if (satellite_track_knot_count == SATELLITE_TRACK_KNOTS){  // long pass, slide along dropping the knots we're done with
+      long drop = ((now() - satellite_track_start) / SATELLITE_TRACK_KNOT_INTERVAL_SECS) - 1;
+      if (drop > 0){
+        if (drop > satellite_track_knot_count){drop = satellite_track_knot_count;}
+        memmove(&satellite_track_knots[0],&satellite_track_knots[drop],(satellite_track_knot_count - drop) * sizeof(satellite_track_knot));
+        satellite_track_knot_count = satellite_track_knot_count - drop;
+        satellite_track_start = satellite_track_start + (drop * SATELLITE_TRACK_KNOT_INTERVAL_SECS);
+      }
+    }
+
+    if ((satellite_track_complete) || (satellite_track_knot_count >= SATELLITE_TRACK_KNOTS)){return 0;}
+
+    if (!load_satellite_from_element_cache(track_satellite)){return 0;}
+
+    knot_time = satellite_track_start + ((long)satellite_track_knot_count * SATELLITE_TRACK_KNOT_INTERVAL_SECS);
+    astro_time& knot_astro_time = astro_time_at(knot_time);
+    sat_datetime.setjulian(knot_astro_time.julian_day,knot_astro_time.day_fraction);
+    sat.predict(sat_datetime);
+
+    range_x = sat.S[0] - obs.O[0];
+    range_y = sat.S[1] - obs.O[1];
+    range_z = sat.S[2] - obs.O[2];
+    r = sqrt((range_x * range_x) + (range_y * range_y) + (range_z * range_z));
+    satellite_track_knots[satellite_track_knot_count].east = 32767.0 * ((range_x * obs.E[0]) + (range_y * obs.E[1]) + (range_z * obs.E[2])) / r;
+    satellite_track_knots[satellite_track_knot_count].north = 32767.0 * ((range_x * obs.N[0]) + (range_y * obs.N[1]) + (range_z * obs.N[2])) / r;
+    satellite_track_knots[satellite_track_knot_count].up = 32767.0 * ((range_x * obs.U[0]) + (range_y * obs.U[1]) + (range_z * obs.U[2])) / r;
+    satellite_track_knot_count++;
+
+    // two knots in a row below the horizon and we've got everything through LOS
+    if (satellite_track_knot_count > 2){
+      int horizon = 32767.0 * sin(SATELLITE_AOS_ELEVATION_MIN * DEG_TO_RAD);
+      if ((satellite_track_knots[satellite_track_knot_count-1].up < horizon) && (satellite_track_knots[satellite_track_knot_count-2].up < horizon)){
+        satellite_track_complete = 1;
+      }
+    }
+
+    #if defined(DEBUG_SATELLITE_TRACKING)
+      if (satellite_track_complete){
+        debug.print(F("service_satellite_track: knots:"));
+        debug.print(satellite_track_knot_count);
+        debug.println("");
+      }
+    #endif
+
+    return 1;
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING) && !defined(OPTION_USE_OLD_TIME_CODE)
+  double catmull_rom(int p0, int p1, int p2, int p3, double u){
+
+    // cubic through p1 (u = 0) and p2 (u = 1), with the slopes taken from the neighbours
+
+    return p1 + (0.5 * u * ((p2 - p0) + (u * (((2.0 * p0) - (5.0 * p1) + (4.0 * p2) - p3) + (u * ((3.0 * (p1 - p2)) + p3 - p0))))));
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING) && !defined(OPTION_USE_OLD_TIME_CODE)
+  byte satellite_track_position(double seconds_ahead, double &track_azimuth, double &track_elevation){
+
+    // az and el of the satellite being tracked seconds_ahead from now, interpolated from the knots laid down by service_satellite_track().
+    // The direction vector is interpolated rather than az and el, so passes near the zenith come out right.
+
+    // returns
+    // 1 = track_azimuth and track_elevation set
+    // 0 = no knots for right now, track_azimuth and track_elevation left alone
+
+    static time_t last_second = 0;
+    static unsigned long last_second_millis = 0;
+    double elapsed, u, east, north, up;
+    int knot;
+
+    if ((satellite_track_satellite != current_satellite_position_in_array) || (satellite_track_satellite == 255)){return 0;}
+
+    time_t time_now = now();
+    if (time_now != last_second){  // millis() gets us in between seconds
+      last_second = time_now;
+      last_second_millis = millis();
+    }
+    elapsed = (time_now - satellite_track_start) + (min(millis() - last_second_millis,999UL) / 1000.0) + seconds_ahead;
+
+    knot = elapsed / SATELLITE_TRACK_KNOT_INTERVAL_SECS;
+    if ((elapsed < 0) || (knot < 1) || ((knot + 2) >= satellite_track_knot_count)){return 0;}
+    u = (elapsed - ((long)knot * SATELLITE_TRACK_KNOT_INTERVAL_SECS)) / SATELLITE_TRACK_KNOT_INTERVAL_SECS;
+
+    east = catmull_rom(satellite_track_knots[knot-1].east,satellite_track_knots[knot].east,satellite_track_knots[knot+1].east,satellite_track_knots[knot+2].east,u);
+    north = catmull_rom(satellite_track_knots[knot-1].north,satellite_track_knots[knot].north,satellite_track_knots[knot+1].north,satellite_track_knots[knot+2].north,u);
+    up = catmull_rom(satellite_track_knots[knot-1].up,satellite_track_knots[knot].up,satellite_track_knots[knot+1].up,satellite_track_knots[knot+2].up,u);
+
+    track_azimuth = atan2(east,north) * RAD_TO_DEG;
+    if (track_azimuth < 0){track_azimuth = track_azimuth + 360.0;}
+    track_elevation = atan2(up,sqrt((east * east) + (north * north))) * RAD_TO_DEG;
+
+    return 1;
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING) && !defined(OPTION_USE_OLD_TIME_CODE)
+  byte satellite_position_at(time_t when, double &position_azimuth, double &position_elevation){
+
+    // az and el of the current satellite at some other time; from the precomputed pass if it covers it, otherwise
+    // propagate it, as long as the AOS/LOS calculation doesn't have sat tied up
+
+    if (satellite_track_position(when - now(),position_azimuth,position_elevation)){return 1;}
+
+    if (service_calc_satellite_data(0,0,0,0,SERVICE_CALC_REPORT_STATE,0,0) != SERVICE_IDLE){return 0;}
+    if (!load_satellite_from_element_cache(current_satellite_position_in_array)){return 0;}
+
+    astro_time& position_time = astro_time_at(when);
+    sat_datetime.setjulian(position_time.julian_day,position_time.day_fraction);
+    sat.predict(sat_datetime);
+    sat.altaz(obs,position_elevation,position_azimuth);
+
+    return 1;
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING)
+  byte tle_upload_flow_control(unsigned int buffer_in_pointer,unsigned int buffer_out_pointer,unsigned int buffer_size,byte sender_stopped){
+
+    // XON/XOFF flow control for the TLE file uploads: tell the sender to stop before the upload buffer fills up
+    // while we're waiting on EEPROM writes, and to carry on once it has drained
+
+    // returns 1 if the sender has been told to stop
+
+    unsigned int bytes_waiting;
+
+    if (buffer_in_pointer >= buffer_out_pointer){
+      bytes_waiting = buffer_in_pointer - buffer_out_pointer;
+    } else {
+      bytes_waiting = (buffer_size - buffer_out_pointer) + buffer_in_pointer;
+    }
+
+    if ((!sender_stopped) && (bytes_waiting >= SATELLITE_TLE_UPLOAD_XOFF_LEVEL)){
+      control_port->write(0x13);  // XOFF
+      return 1;
+    }
+    if ((sender_stopped) && (bytes_waiting <= SATELLITE_TLE_UPLOAD_XON_LEVEL)){
+      control_port->write(0x11);  // XON
+      return 0;
+    }
+
+    return sender_stopped;
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING)
+  void print_tle_upload_statistics(unsigned long bytes_received,unsigned long first_byte_time,unsigned long last_write_time){
+
+    // upload throughput, from the first byte received to the last one stored
+
+    unsigned long upload_time = 0;
+
+    if (last_write_time > first_byte_time){
+      upload_time = last_write_time - first_byte_time;
+    }
+
+    control_port->print(bytes_received);
+    control_port->print(F(" bytes in "));
+    control_port->print(upload_time);
+    control_port->print(F(" mS"));
+    if (upload_time > 0){
+      control_port->print(F(", "));
+      control_port->print((bytes_received * 1000) / upload_time);
+      control_port->print(F(" bytes/S"));
+    }
+    control_port->print(F(", "));
+    control_port->print(tle_catalog_bytes_written);
+    control_port->print(F(" written, "));
+    control_port->print(tle_catalog_bytes_unchanged);
+    control_port->println(F(" unchanged"));
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING)
+  void print_tle_packed_value(unsigned long value,byte decimal_places,byte print_whole_part){
+
+    // print a scaled integer from a packed record with its decimal point put back in
+
+    unsigned long divisor = 1;
+
+    for (byte x = 0;x < decimal_places;x++){
+      divisor = divisor * 10;
+    }
+    if (print_whole_part){
+      control_port->print(value / divisor);
+    }
+    control_port->print(".");
+    value = value % divisor;
+    for (divisor = divisor / 10;(divisor > 1) && (value < divisor);divisor = divisor / 10){
+      control_port->print("0");
+    }
+    control_port->print(value);
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING)
+  unsigned long print_tle_file_packed_record(unsigned long record_start){
+
+    // print a packed record's name and elements, returns the location after the record
+
+    byte name_length = tle_catalog_read(record_start + 1);
+    unsigned long location = record_start + 2 + name_length;
+    int32_t decay;
+
+    for (unsigned long x = record_start + 2;x < location;x++){
+      control_port->write(tle_catalog_read(x));
+    }
+    control_port->print(F("\r\n  packed: epoch "));
+    if (tle_catalog_read(location) < 10){control_port->print("0");}
+    control_port->print(tle_catalog_read(location));
+    if (tle_catalog_read_packed(location + 1,2) < 100){control_port->print("0");}
+    if (tle_catalog_read_packed(location + 1,2) < 10){control_port->print("0");}
+    control_port->print(tle_catalog_read_packed(location + 1,2));
+    print_tle_packed_value(tle_catalog_read_packed(location + 3,4),8,0);
+    control_port->print(F(" decay "));
+    decay = tle_catalog_read_packed(location + 26,4);
+    if (decay < 0){
+      control_port->print("-");
+      decay = -decay;
+    }
+    print_tle_packed_value(decay,8,1);
+    control_port->print(F("\r\n  inc "));
+    print_tle_packed_value(tle_catalog_read_packed(location + 7,3),4,1);
+    control_port->print(F(" raan "));
+    print_tle_packed_value(tle_catalog_read_packed(location + 10,3),4,1);
+    control_port->print(F(" ecc "));
+    print_tle_packed_value(tle_catalog_read_packed(location + 13,3),7,1);
+    control_port->print(F(" argp "));
+    print_tle_packed_value(tle_catalog_read_packed(location + 16,3),4,1);
+    control_port->print(F(" ma "));
+    print_tle_packed_value(tle_catalog_read_packed(location + 19,3),4,1);
+    control_port->print(F(" mm "));
+    print_tle_packed_value(tle_catalog_read_packed(location + 22,4),8,1);
+    control_port->print(F(" rev "));
+    control_port->println(tle_catalog_read_packed(location + 30,3));
+
+    return location + SAT_ELEMENTS_PACKED_SIZE + 1;
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING)
+  char print_tle_file_area_eeprom(){
+
+    unsigned long eeprom_location;
+    unsigned long record_end;
+    unsigned long file_size = tle_catalog_size();
+    byte eeprom_read;
+    byte line_number = 0;
+
+    if (tle_catalog_read(0) == 0xFF){
+      control_port->println(F("<empty>"));
+    } else if ((tle_file_directory_valid) && (!(tle_file_directory_flags & TLE_FILE_DIRECTORY_INCOMPLETE))){
+      for (unsigned int directory_entry = 0;directory_entry < tle_file_directory_count;directory_entry++){
+        seek_tle_file_eeprom(directory_entry);
+        record_end = tle_file_eeprom_read_location + tle_catalog_directory_read(TLE_FILE_DIRECTORY_HEADER_SIZE + ((unsigned long)directory_entry * TLE_FILE_DIRECTORY_ENTRY_SIZE) + TLE_FILE_DIRECTORY_OFFSET_SIZE + 1);
+        if (tle_catalog_read(tle_file_eeprom_read_location) == TLE_FILE_PACKED_RECORD_MARKER){
+          print_tle_file_packed_record(tle_file_eeprom_read_location);
+        } else {
+          for (eeprom_location = tle_file_eeprom_read_location; eeprom_location < record_end; eeprom_location++) {
+            eeprom_read = tle_catalog_read(eeprom_location);
+            if (eeprom_read == 254 /*'\r'*/){
+              control_port->println();
+            } else {
+              control_port->write(eeprom_read);
+            }
+          }
+        }
+      }
+    } else {
+      for (eeprom_location = 0; eeprom_location < file_size; eeprom_location++) {
+        eeprom_read = tle_catalog_read(eeprom_location);
+        if (eeprom_read != 0xFF){
+          if ((line_number == 0) && (eeprom_read == TLE_FILE_PACKED_RECORD_MARKER) && ((eeprom_location + TLE_FILE_PACKED_RECORD_SIZE(tle_catalog_read(eeprom_location + 1))) <= file_size)){
+            eeprom_location = print_tle_file_packed_record(eeprom_location) - 1;
+          } else if (eeprom_read == 254 /*'\r'*/){
+            control_port->println();
+            line_number++;
+            if (line_number > 2){line_number = 0;}
+          } else {
+            control_port->write(eeprom_read);
+          }
+        } else {
+          eeprom_location = file_size;
+        }
+      }
+    }
+  
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+// --------------------------------------------------------------
+
+void az_check_operation_timeout(){
+
+  // check if the last executed rotation operation has been going on too long
+
+
+  if (((millis() - az_last_rotate_initiation) > OPERATION_TIMEOUT) && (az_state != IDLE)) {
+    submit_request(AZ, REQUEST_KILL, 0, 78);
+    #ifdef DEBUG_AZ_CHECK_OPERATION_TIMEOUT
+      debug.println("az_check_operation_timeout: timeout reached, aborting rotation");
+    #endif // DEBUG_AZ_CHECK_OPERATION_TIMEOUT
+  }
+
+
+}
 
 // --------------------------------------------------------------
 #if defined(FEATURE_AZ_ROTATION_STALL_DETECTION)
 void az_check_rotation_stall(){
 
-  // check if rotation has stalled
+  // check if rotation has stalled: the estimated velocity hasn't reached STALL_CHECK_DEGREES_THRESHOLD_AZ
+  // per STALL_CHECK_FREQUENCY_MS_AZ for that long
 
-  static unsigned long last_check_time = 0;
-  static int last_raw_azimuth = 0;
+  static unsigned long last_moving_time = 0;
   static byte rotation_stall_pin_active = 0;
 
   if (az_state != IDLE){
-    if (last_check_time == 0){
-      last_raw_azimuth = raw_azimuth;
-      last_check_time = millis();
+    if (last_moving_time == 0){
+      last_moving_time = millis();
       if (rotation_stall_pin_active){
         digitalWriteEnhanced(az_rotation_stall_detected,LOW);
         rotation_stall_pin_active = 0;
       }
     } else {
-      if ((millis() - last_check_time) > STALL_CHECK_FREQUENCY_MS_AZ){
-        if ((abs((raw_azimuth - last_raw_azimuth))) < STALL_CHECK_DEGREES_THRESHOLD_AZ){
-          #ifdef DEBUG_ROTATION_STALL_DETECTION
-            debug.println("az_check_rotation_stall: REQUEST_KILL");
-          #endif
-          #ifdef OPTION_ROTATION_STALL_DETECTION_SERIAL_MESSAGE
-            control_port->println(F("AZ Rotation Stall Detected"));
-          #endif  
-          submit_request(AZ, REQUEST_KILL, 0, 78);
-          digitalWriteEnhanced(az_rotation_stall_detected,HIGH);
-          rotation_stall_pin_active = 1;
-          last_check_time = 0;
-        } else {
-          last_raw_azimuth = raw_azimuth;
-          last_check_time = millis();
-        }
+      if (((millis() - azimuth_estimate.time) < HEADING_ESTIMATE_MAX_INTERVAL_MS) &&
+          (abs(azimuth_estimate.velocity) >= (STALL_CHECK_DEGREES_THRESHOLD_AZ * 1000.0 / STALL_CHECK_FREQUENCY_MS_AZ))){
+        last_moving_time = millis();
+      }
+      if ((millis() - last_moving_time) > STALL_CHECK_FREQUENCY_MS_AZ){
+        #ifdef DEBUG_ROTATION_STALL_DETECTION
+          debug.println("az_check_rotation_stall: REQUEST_KILL");
+        #endif
+        #ifdef OPTION_ROTATION_STALL_DETECTION_SERIAL_MESSAGE
+          control_port->println(F("AZ Rotation Stall Detected"));
+        #endif  
+        submit_request(AZ, REQUEST_KILL, 0, 78);
+        digitalWriteEnhanced(az_rotation_stall_detected,HIGH);
+        rotation_stall_pin_active = 1;
+        last_moving_time = 0;
       }
     }
   } else {
-    last_check_time = 0;
+    last_moving_time = 0;
   }
 }
 #endif //FEATURE_AZ_ROTATION_STALL_DETECTION
@@ -7966,41 +9824,39 @@ void az_check_rotation_stall(){
 #if defined(FEATURE_EL_ROTATION_STALL_DETECTION) && defined(FEATURE_ELEVATION_CONTROL)
 void el_check_rotation_stall(){
 
-  // check if rotation has stalled
+  // check if rotation has stalled: the estimated velocity hasn't reached STALL_CHECK_DEGREES_THRESHOLD_EL
+  // per STALL_CHECK_FREQUENCY_MS_EL for that long
 
-  static unsigned long last_check_time = 0;
-  static int last_elevation = 0;
+  static unsigned long last_moving_time = 0;
   static byte rotation_stall_pin_active = 0;
 
   if (el_state != IDLE){
-    if (last_check_time == 0){
-      last_elevation = elevation;
-      last_check_time = millis();
+    if (last_moving_time == 0){
+      last_moving_time = millis();
       if (rotation_stall_pin_active){
         digitalWriteEnhanced(el_rotation_stall_detected,LOW);
         rotation_stall_pin_active = 0;
       }
     } else {
-      if ((millis() - last_check_time) > STALL_CHECK_FREQUENCY_MS_EL){
-        if ((abs((elevation - last_elevation))) < STALL_CHECK_DEGREES_THRESHOLD_AZ){
-          #ifdef DEBUG_ROTATION_STALL_DETECTION
-            debug.println("el_check_rotation_stall: REQUEST_KILL");
-          #endif
-          #ifdef OPTION_ROTATION_STALL_DETECTION_SERIAL_MESSAGE
-            control_port->println(F("EL Rotation Stall Detected"));
-          #endif            
-          submit_request(EL, REQUEST_KILL, 0, 78);
-          digitalWriteEnhanced(el_rotation_stall_detected,HIGH);
-          rotation_stall_pin_active = 1;
-          last_check_time = 0;
-        } else {
-          last_elevation = elevation;
-          last_check_time = millis();
-        }
+      if (((millis() - elevation_estimate.time) < HEADING_ESTIMATE_MAX_INTERVAL_MS) &&
+          (abs(elevation_estimate.velocity) >= (STALL_CHECK_DEGREES_THRESHOLD_EL * 1000.0 / STALL_CHECK_FREQUENCY_MS_EL))){
+        last_moving_time = millis();
+      }
+      if ((millis() - last_moving_time) > STALL_CHECK_FREQUENCY_MS_EL){
+        #ifdef DEBUG_ROTATION_STALL_DETECTION
+          debug.println("el_check_rotation_stall: REQUEST_KILL");
+        #endif
+        #ifdef OPTION_ROTATION_STALL_DETECTION_SERIAL_MESSAGE
+          control_port->println(F("EL Rotation Stall Detected"));
+        #endif            
+        submit_request(EL, REQUEST_KILL, 0, 78);
+        digitalWriteEnhanced(el_rotation_stall_detected,HIGH);
+        rotation_stall_pin_active = 1;
+        last_moving_time = 0;
       }
     }
   } else {
-    last_check_time = 0;
+    last_moving_time = 0;
   }
 }
 #endif //FEATURE_EL_ROTATION_STALL_DETECTION
@@ -8091,58 +9947,265 @@ void check_timed_interval(){
 } /* check_timed_interval */
 #endif // FEATURE_TIMED_BUFFER
 // --------------------------------------------------------------
-#if !defined(FEATURE_CALIBRATION)
-void apply_azimuth_offset(){
+// --------------------------------------------------------------
+#if defined(OPTION_POTENTIOMETER_ADC_OVERSAMPLING) && (defined(FEATURE_AZ_POSITION_POTENTIOMETER) || defined(FEATURE_EL_POSITION_POTENTIOMETER))
+void initialize_potentiometer_sampler(){
+
+  #if defined(FEATURE_AZ_POSITION_POTENTIOMETER)
+    potentiometer_sampler[POTENTIOMETER_SAMPLER_AZIMUTH].pin = rotator_analog_az;
+  #endif
+  #if defined(FEATURE_EL_POSITION_POTENTIOMETER)
+    potentiometer_sampler[POTENTIOMETER_SAMPLER_ELEVATION].pin = rotator_analog_el;
+  #endif
+  potentiometer_sampler_current = (potentiometer_sampler[POTENTIOMETER_SAMPLER_AZIMUTH].pin == 255) ? POTENTIOMETER_SAMPLER_ELEVATION : POTENTIOMETER_SAMPLER_AZIMUTH;
+  potentiometer_sampler_running = 1;
 
-  if (configuration.azimuth_offset < 0){
-    raw_azimuth = raw_azimuth + (2.0 * configuration.azimuth_offset);
+  #if defined(__AVR__)
+    potentiometer_sampler_start_conversion();
+  #endif
+
+}
+#endif // OPTION_POTENTIOMETER_ADC_OVERSAMPLING
+// --------------------------------------------------------------
+#if defined(OPTION_POTENTIOMETER_ADC_OVERSAMPLING) && (defined(FEATURE_AZ_POSITION_POTENTIOMETER) || defined(FEATURE_EL_POSITION_POTENTIOMETER))
+void potentiometer_sampler_add(byte sampler, int sample){
+
+  // add up POTENTIOMETER_OVERSAMPLING_SAMPLES ADC samples and keep the last POTENTIOMETER_MEDIAN_LENGTH sums, decimated
+  // (called from the ADC interrupt on AVR)
+
+  potentiometer_sampler[sampler].sum += sample;
+  potentiometer_sampler[sampler].samples++;
+  if (potentiometer_sampler[sampler].samples >= (1 << POTENTIOMETER_OVERSAMPLING_SHIFT)){
+    potentiometer_sampler[sampler].readings[potentiometer_sampler[sampler].reading_in] = potentiometer_sampler[sampler].sum >> (POTENTIOMETER_OVERSAMPLING_SHIFT - POTENTIOMETER_OVERSAMPLING_EXTRA_BITS);
+    potentiometer_sampler[sampler].reading_in++;
+    if (potentiometer_sampler[sampler].reading_in >= POTENTIOMETER_MEDIAN_LENGTH){
+      potentiometer_sampler[sampler].reading_in = 0;
+    }
+    if (potentiometer_sampler[sampler].readings_stored < POTENTIOMETER_MEDIAN_LENGTH){
+      potentiometer_sampler[sampler].readings_stored++;
+    }
+    potentiometer_sampler[sampler].sum = 0;
+    potentiometer_sampler[sampler].samples = 0;
   }
 
 }
-#endif
+#endif // OPTION_POTENTIOMETER_ADC_OVERSAMPLING
 // --------------------------------------------------------------
+#if defined(OPTION_POTENTIOMETER_ADC_OVERSAMPLING) && (defined(FEATURE_AZ_POSITION_POTENTIOMETER) || defined(FEATURE_EL_POSITION_POTENTIOMETER)) && defined(__AVR__)
+void potentiometer_sampler_start_conversion(){
+
+  // same register setup as analogRead(), but let the conversion complete interrupt pick up the result
 
+  byte channel = potentiometer_sampler[potentiometer_sampler_current].pin;
 
-float float_map(float x, float in_min, float in_max, float out_min, float out_max) {
+  if (channel >= A0){channel = channel - A0;}
+  #if defined(MUX5)
+    ADCSRB = (ADCSRB & ~(1 << MUX5)) | (((channel >> 3) & 0x01) << MUX5);
+  #endif
+  #if defined(OPTION_EXTERNAL_ANALOG_REFERENCE)
+    ADMUX = (channel & 0x07);
+  #else
+    ADMUX = (1 << REFS0) | (channel & 0x07);
+  #endif
+  ADCSRA |= (1 << ADIF) | (1 << ADIE) | (1 << ADSC);
+
+}
+#endif // OPTION_POTENTIOMETER_ADC_OVERSAMPLING && __AVR__
+// --------------------------------------------------------------
+#if defined(OPTION_POTENTIOMETER_ADC_OVERSAMPLING) && (defined(FEATURE_AZ_POSITION_POTENTIOMETER) || defined(FEATURE_EL_POSITION_POTENTIOMETER)) && defined(__AVR__)
+ISR(ADC_vect){
 
-  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+  // a conversion is done; store it and start the next one on the other pot, if there is one
+
+  potentiometer_sampler_add(potentiometer_sampler_current, ADC);
+  if (potentiometer_sampler[potentiometer_sampler_current ^ 1].pin != 255){
+    potentiometer_sampler_current = potentiometer_sampler_current ^ 1;
+  }
+  if (potentiometer_sampler_running){
+    potentiometer_sampler_start_conversion();
+  }
 
 }
+#endif // OPTION_POTENTIOMETER_ADC_OVERSAMPLING && __AVR__
+// --------------------------------------------------------------
+#if defined(OPTION_POTENTIOMETER_ADC_OVERSAMPLING) && (defined(FEATURE_AZ_POSITION_POTENTIOMETER) || defined(FEATURE_EL_POSITION_POTENTIOMETER)) && !defined(__AVR__)
+void service_potentiometer_sampler(){
+
+  // no conversion complete interrupt to hang this on, so take a sample of each pot every POTENTIOMETER_SAMPLE_INTERVAL_MS;
+  // analogRead() blocks, and on the UNO R4 every time through the loop would be most of the loop
+
+  static unsigned long last_sample_time = 0;
 
+  if (!potentiometer_sampler_running){return;}
+  if ((millis() - last_sample_time) < POTENTIOMETER_SAMPLE_INTERVAL_MS){return;}
+  last_sample_time = millis();
+  for (byte sampler = 0; sampler < 2; sampler++){
+    if (potentiometer_sampler[sampler].pin != 255){
+      potentiometer_sampler_add(sampler, analogReadEnhanced(potentiometer_sampler[sampler].pin));
+    }
+  }
+
+}
+#endif // OPTION_POTENTIOMETER_ADC_OVERSAMPLING && !__AVR__
 // --------------------------------------------------------------
+#if defined(OPTION_POTENTIOMETER_ADC_OVERSAMPLING) && (defined(FEATURE_AZ_POSITION_POTENTIOMETER) || defined(FEATURE_EL_POSITION_POTENTIOMETER))
+int read_potentiometer_sampler(byte sampler){
 
+  // returns the median of the last POTENTIOMETER_MEDIAN_LENGTH decimated readings, in ADC counts << POTENTIOMETER_OVERSAMPLING_EXTRA_BITS
 
-void convert_raw_azimuth_to_real_azimuth(){
+  int readings[POTENTIOMETER_MEDIAN_LENGTH];
+  byte readings_stored;
+  int reading;
+  byte y;
 
-  [[maybe_unused]] float temp_azimuth = raw_azimuth;
+  #if defined(__AVR__)
+    noInterrupts();
+  #endif
+  readings_stored = potentiometer_sampler[sampler].readings_stored;
+  for (byte x = 0; x < readings_stored; x++){
+    readings[x] = potentiometer_sampler[sampler].readings[x];
+  }
+  #if defined(__AVR__)
+    interrupts();
+  #endif
 
-  if (raw_azimuth >= 360){
-    azimuth = raw_azimuth - float(int(raw_azimuth / 360) * 360.0);
-  } else {
-    if (raw_azimuth < 0){
-      azimuth = raw_azimuth + 360.0;
+  if (readings_stored == 0){  // nothing decimated yet, right after boot
+    return analogReadEnhanced(potentiometer_sampler[sampler].pin) << POTENTIOMETER_OVERSAMPLING_EXTRA_BITS;
+  }
+
+  // insertion sort, there's only a handful
+  for (byte x = 1; x < readings_stored; x++){
+    reading = readings[x];
+    for (y = x; (y > 0) && (readings[y - 1] > reading); y--){
+      readings[y] = readings[y - 1];
+    }
+    readings[y] = reading;
+  }
+  return readings[readings_stored / 2];
+
+}
+#endif // OPTION_POTENTIOMETER_ADC_OVERSAMPLING
+// --------------------------------------------------------------
+//
+// The heading pipeline runs in integer hundredths of a degree (centidegrees).  A sensor reading is
+// brought into centidegrees once, then mapping, correction, offset, smoothing, and the 0 - 359 wrap
+// are all long integer math with the scale factors worked out ahead of time, rather than software
+// floating point at every step.  raw_azimuth, azimuth, and elevation are set from the result.
+// The parts with no configuration behind them (mapping, smoothing, wrap) are in lib/centidegrees.
+
+// --------------------------------------------------------------
+#if !defined(FEATURE_CALIBRATION)
+long apply_azimuth_offset_centidegrees(long raw_centidegrees){
+
+  static float last_azimuth_offset = 0;
+  static long offset_centidegrees = 0;
+
+  if (configuration.azimuth_offset != last_azimuth_offset){
+    last_azimuth_offset = configuration.azimuth_offset;
+    if (configuration.azimuth_offset < 0){
+      offset_centidegrees = degrees_to_centidegrees(2.0 * configuration.azimuth_offset);
     } else {
-      azimuth = raw_azimuth;
+      offset_centidegrees = 0;
     }
   }
 
+  return raw_centidegrees + offset_centidegrees;
+
+}
+#endif
+// --------------------------------------------------------------
+#if defined(FEATURE_ELEVATION_CONTROL)
+long apply_elevation_offset_centidegrees(long centidegrees){
+
+  static float last_elevation_offset = 0;
+  static long offset_centidegrees = 0;
+
+  if (configuration.elevation_offset != last_elevation_offset){
+    last_elevation_offset = configuration.elevation_offset;
+    offset_centidegrees = degrees_to_centidegrees(configuration.elevation_offset);
+  }
+
+  return centidegrees + offset_centidegrees;
+
 }
+#endif // FEATURE_ELEVATION_CONTROL
+// --------------------------------------------------------------
+#if defined(FEATURE_AZIMUTH_CORRECTION)
+long correct_azimuth_centidegrees(long raw_centidegrees){
 
+  return correct_centidegrees(&azimuth_correction_lut, azimuth_correction_lut_to, raw_centidegrees);
+
+}
+#endif // FEATURE_AZIMUTH_CORRECTION
 // --------------------------------------------------------------
+#if defined(FEATURE_ELEVATION_CORRECTION)
+long correct_elevation_centidegrees(long centidegrees){
 
-void read_azimuth(byte force_read){
+  return correct_centidegrees(&elevation_correction_lut, elevation_correction_lut_to, centidegrees);
 
+}
+#endif // FEATURE_ELEVATION_CORRECTION
+// --------------------------------------------------------------
 
-  #ifdef FEATURE_AZ_POSITION_INCREMENTAL_ENCODER
-    read_azimuth_lock = 1;
-  #endif
+void convert_raw_azimuth_centidegrees_to_real_azimuth(long raw_centidegrees){
+
+  raw_azimuth = centidegrees_to_degrees(raw_centidegrees);
+  azimuth = centidegrees_to_degrees(wrap_centidegrees(raw_centidegrees));
+
+}
 
+// --------------------------------------------------------------
+
+void update_heading_estimate(struct heading_estimate &estimate, float measurement, unsigned long measurement_time){
+
+  // alpha-beta filter: predict the heading from the last position and velocity, then pull both part way
+  // towards the measurement.  Stall detection, slow down, and the tracking lead all work from this.
+  // Only call this with a new measurement, measurement_time being the millis() it was taken at.
+
+  float interval;
+  float residual;
+
+  if ((estimate.valid) && ((measurement_time - estimate.time) < HEADING_ESTIMATE_MIN_INTERVAL_MS)){return;}
+
+  if ((!estimate.valid) || ((measurement_time - estimate.time) > HEADING_ESTIMATE_MAX_INTERVAL_MS)){
+    estimate.position = measurement;
+    estimate.velocity = 0;
+    estimate.valid = 1;
+  } else {
+    interval = (measurement_time - estimate.time) / 1000.0;
+    estimate.position = estimate.position + (estimate.velocity * interval);
+    residual = measurement - estimate.position;
+    if (residual > 180){           // the sensor wrapped around 0 / 360
+      estimate.position = estimate.position + 360;
+    }
+    if (residual < -180){
+      estimate.position = estimate.position - 360;
+    }
+    residual = measurement - estimate.position;
+    estimate.position = estimate.position + (HEADING_ESTIMATE_ALPHA * residual);
+    estimate.velocity = estimate.velocity + ((HEADING_ESTIMATE_BETA / interval) * residual);
+  }
+  estimate.time = measurement_time;
+
+}
+
+// --------------------------------------------------------------
+
+void read_azimuth(byte force_read){
 
   unsigned int previous_raw_azimuth = raw_azimuth;
+  long raw_azimuth_centidegrees = 0;
   static unsigned long last_measurement_time = 0;
+  unsigned long measurement_time = 0;
+  byte new_measurement = 0;
+
+  #if defined(FEATURE_AZ_POSITION_POTENTIOMETER) && defined(OPTION_POTENTIOMETER_ADC_OVERSAMPLING)
+    int analog_az_oversampled;
+  #endif
 
   #ifdef FEATURE_AZ_POSITION_INCREMENTAL_ENCODER
     static unsigned int incremental_encoder_previous_raw_azimuth = raw_azimuth;
+    long encoder_position;
   #endif // FEATURE_AZ_POSITION_INCREMENTAL_ENCODER
 
   if (heading_reading_inhibit_pin) {
@@ -8167,24 +10230,33 @@ void read_azimuth(byte force_read){
     if (1) {
   #endif
 
+    measurement_time = millis();
+    new_measurement = 1;
+
     #ifdef FEATURE_AZ_POSITION_POTENTIOMETER
-      analog_az = analogReadEnhanced(rotator_analog_az);
-      raw_azimuth = float_map(analog_az, configuration.analog_az_full_ccw, configuration.analog_az_full_cw, configuration.azimuth_starting_point, (configuration.azimuth_starting_point + configuration.azimuth_rotation_capability));
+      #if defined(OPTION_POTENTIOMETER_ADC_OVERSAMPLING)
+        // already sampled in the background; the extra bits go into the mapping, analog_az stays in ADC counts for calibrating
+        analog_az_oversampled = read_potentiometer_sampler(POTENTIOMETER_SAMPLER_AZIMUTH);
+        analog_az = (analog_az_oversampled + ((1 << POTENTIOMETER_OVERSAMPLING_EXTRA_BITS) >> 1)) >> POTENTIOMETER_OVERSAMPLING_EXTRA_BITS;
+        raw_azimuth_centidegrees = map_analog_to_centidegrees(azimuth_analog_map, analog_az_oversampled, configuration.analog_az_full_ccw << POTENTIOMETER_OVERSAMPLING_EXTRA_BITS, configuration.analog_az_full_cw << POTENTIOMETER_OVERSAMPLING_EXTRA_BITS, configuration.azimuth_starting_point * 100L, (configuration.azimuth_starting_point + configuration.azimuth_rotation_capability) * 100L, POTENTIOMETER_FULL_SCALE);
+      #else
+        analog_az = analogReadEnhanced(rotator_analog_az);
+        raw_azimuth_centidegrees = map_analog_to_centidegrees(azimuth_analog_map, analog_az, configuration.analog_az_full_ccw, configuration.analog_az_full_cw, configuration.azimuth_starting_point * 100L, (configuration.azimuth_starting_point + configuration.azimuth_rotation_capability) * 100L, POTENTIOMETER_FULL_SCALE);
+      #endif
 
       #ifdef FEATURE_AZIMUTH_CORRECTION
-        raw_azimuth = correct_azimuth(raw_azimuth);
+        raw_azimuth_centidegrees = correct_azimuth_centidegrees(raw_azimuth_centidegrees);
       #endif // FEATURE_AZIMUTH_CORRECTION
   
       #if !defined(FEATURE_CALIBRATION)
-      apply_azimuth_offset();
+      raw_azimuth_centidegrees = apply_azimuth_offset_centidegrees(raw_azimuth_centidegrees);
       #endif
 
       if (AZIMUTH_SMOOTHING_FACTOR > 0) {
-        if (raw_azimuth < 0){raw_azimuth = 0;}
-        raw_azimuth = (raw_azimuth * ((float)1 - ((float)AZIMUTH_SMOOTHING_FACTOR / (float)100))) + ((float)previous_raw_azimuth * ((float)AZIMUTH_SMOOTHING_FACTOR / (float)100));
+        raw_azimuth_centidegrees = smooth_centidegrees(raw_azimuth_centidegrees, previous_raw_azimuth * 100L, AZIMUTH_SMOOTHING_WEIGHT);
       }
  
-      convert_raw_azimuth_to_real_azimuth();
+      convert_raw_azimuth_centidegrees_to_real_azimuth(raw_azimuth_centidegrees);
 
 
     #endif // FEATURE_AZ_POSITION_POTENTIOMETER
@@ -8208,23 +10280,22 @@ void read_azimuth(byte force_read){
               }
             }
           #endif // DEBUG_HEADING_READING_TIME
-          raw_azimuth = remote_unit_azimuth_float;
+          raw_azimuth_centidegrees = degrees_to_centidegrees(remote_unit_azimuth_float);
 
 
           #ifdef FEATURE_AZIMUTH_CORRECTION
-            raw_azimuth = correct_azimuth(raw_azimuth);
+            raw_azimuth_centidegrees = correct_azimuth_centidegrees(raw_azimuth_centidegrees);
           #endif // FEATURE_AZIMUTH_CORRECTION
 
           #if !defined(FEATURE_CALIBRATION)          
-          apply_azimuth_offset();
+          raw_azimuth_centidegrees = apply_azimuth_offset_centidegrees(raw_azimuth_centidegrees);
           #endif
 
           if (AZIMUTH_SMOOTHING_FACTOR > 0) {
-            if (raw_azimuth < 0){raw_azimuth = 0;}
-            raw_azimuth = (raw_azimuth * ((float)1 - ((float)AZIMUTH_SMOOTHING_FACTOR / (float)100))) + ((float)previous_raw_azimuth * ((float)AZIMUTH_SMOOTHING_FACTOR / (float)100));
+            raw_azimuth_centidegrees = smooth_centidegrees(raw_azimuth_centidegrees, previous_raw_azimuth * 100L, AZIMUTH_SMOOTHING_WEIGHT);
           }
 
-          convert_raw_azimuth_to_real_azimuth();
+          convert_raw_azimuth_centidegrees_to_real_azimuth(raw_azimuth_centidegrees);
 
           // remote_unit_command_results_available = 0;
         /*} else {
@@ -8274,13 +10345,13 @@ void read_azimuth(byte force_read){
           }
         #endif // OPTION_AZ_POSITION_ROTARY_ENCODER_HARD_LIMIT
 
-        raw_azimuth = configuration.last_azimuth;
+        raw_azimuth_centidegrees = degrees_to_centidegrees(configuration.last_azimuth);
 
         #ifdef FEATURE_AZIMUTH_CORRECTION
-          raw_azimuth = correct_azimuth(raw_azimuth);
+          raw_azimuth_centidegrees = correct_azimuth_centidegrees(raw_azimuth_centidegrees);
         #endif // FEATURE_AZIMUTH_CORRECTION
 
-        convert_raw_azimuth_to_real_azimuth();
+        convert_raw_azimuth_centidegrees_to_real_azimuth(raw_azimuth_centidegrees);
 
         configuration_dirty = 1;  // TODO: a better way to handle configuration writes; these are very frequent
       }
@@ -8326,13 +10397,13 @@ void read_azimuth(byte force_read){
         #endif // OPTION_AZ_POSITION_ROTARY_ENCODER_HARD_LIMIT
 
         //debug.print(" Calculating raw_azimuth : ");
-        raw_azimuth = configuration.last_azimuth;
+        raw_azimuth_centidegrees = degrees_to_centidegrees(configuration.last_azimuth);
 
         #ifdef FEATURE_AZIMUTH_CORRECTION
-          raw_azimuth = correct_azimuth(raw_azimuth);
+          raw_azimuth_centidegrees = correct_azimuth_centidegrees(raw_azimuth_centidegrees);
         #endif // FEATURE_AZIMUTH_CORRECTION
 
-        convert_raw_azimuth_to_real_azimuth();
+        convert_raw_azimuth_centidegrees_to_real_azimuth(raw_azimuth_centidegrees);
 
         configuration_dirty = 1;
                   
@@ -8357,17 +10428,17 @@ void read_azimuth(byte force_read){
       // Correct for when signs are reversed.
       if (heading < 0) heading += 2 * PI;
       if (heading > 2 * PI) heading -= 2 * PI;
-      raw_azimuth = (heading * RAD_TO_DEG); // radians to degree
+      raw_azimuth_centidegrees = degrees_to_centidegrees(heading * RAD_TO_DEG); // radians to degree
       if (AZIMUTH_SMOOTHING_FACTOR > 0) {
-        if (raw_azimuth < 0){raw_azimuth = 0;}
-        raw_azimuth = (raw_azimuth * ((float)1 - ((float)AZIMUTH_SMOOTHING_FACTOR / (float)100))) + ((float)previous_raw_azimuth * ((float)AZIMUTH_SMOOTHING_FACTOR / (float)100));
+        raw_azimuth_centidegrees = smooth_centidegrees(raw_azimuth_centidegrees, previous_raw_azimuth * 100L, AZIMUTH_SMOOTHING_WEIGHT);
       }
       #ifdef FEATURE_AZIMUTH_CORRECTION
-        raw_azimuth = correct_azimuth(raw_azimuth);
+        raw_azimuth_centidegrees = correct_azimuth_centidegrees(raw_azimuth_centidegrees);
       #endif // FEATURE_AZIMUTH_CORRECTION
       #if !defined(FEATURE_CALIBRATION)  
-      apply_azimuth_offset();
+      raw_azimuth_centidegrees = apply_azimuth_offset_centidegrees(raw_azimuth_centidegrees);
       #endif
+      raw_azimuth = centidegrees_to_degrees(raw_azimuth_centidegrees);
       azimuth = raw_azimuth;
     #endif // FEATURE_AZ_POSITION_HMC5883L
 
@@ -8403,18 +10474,18 @@ void read_azimuth(byte force_read){
       }
 
       // Convert to degrees
-      raw_azimuth = heading * 180 / M_PI; 
+      raw_azimuth_centidegrees = degrees_to_centidegrees(heading * 180 / M_PI);
 
       if (AZIMUTH_SMOOTHING_FACTOR > 0) {
-        if (raw_azimuth < 0){raw_azimuth = 0;}
-        raw_azimuth = (raw_azimuth * ((float)1 - ((float)AZIMUTH_SMOOTHING_FACTOR / (float)100))) + ((float)previous_raw_azimuth * ((float)AZIMUTH_SMOOTHING_FACTOR / (float)100));
+        raw_azimuth_centidegrees = smooth_centidegrees(raw_azimuth_centidegrees, previous_raw_azimuth * 100L, AZIMUTH_SMOOTHING_WEIGHT);
       }
       #ifdef FEATURE_AZIMUTH_CORRECTION
-        raw_azimuth = correct_azimuth(raw_azimuth);
+        raw_azimuth_centidegrees = correct_azimuth_centidegrees(raw_azimuth_centidegrees);
       #endif // FEATURE_AZIMUTH_CORRECTION
       #if !defined(FEATURE_CALIBRATION)  
-      apply_azimuth_offset();
+      raw_azimuth_centidegrees = apply_azimuth_offset_centidegrees(raw_azimuth_centidegrees);
       #endif
+      raw_azimuth = centidegrees_to_degrees(raw_azimuth_centidegrees);
       azimuth = raw_azimuth;
     #endif // FEATURE_AZ_POSITION_HMC5883L_USING_JARZEBSKI_LIBRARY
 
@@ -8451,18 +10522,18 @@ void read_azimuth(byte force_read){
       }
 
       // Convert to degrees
-      raw_azimuth = heading * 180 / M_PI; 
+      raw_azimuth_centidegrees = degrees_to_centidegrees(heading * 180 / M_PI);
 
       if (AZIMUTH_SMOOTHING_FACTOR > 0) {
-        if (raw_azimuth < 0){raw_azimuth = 0;}
-        raw_azimuth = (raw_azimuth * ((float)1 - ((float)AZIMUTH_SMOOTHING_FACTOR / (float)100))) + ((float)previous_raw_azimuth * ((float)AZIMUTH_SMOOTHING_FACTOR / (float)100));
+        raw_azimuth_centidegrees = smooth_centidegrees(raw_azimuth_centidegrees, previous_raw_azimuth * 100L, AZIMUTH_SMOOTHING_WEIGHT);
       }
       #ifdef FEATURE_AZIMUTH_CORRECTION
-        raw_azimuth = correct_azimuth(raw_azimuth);
+        raw_azimuth_centidegrees = correct_azimuth_centidegrees(raw_azimuth_centidegrees);
       #endif // FEATURE_AZIMUTH_CORRECTION
       #if !defined(FEATURE_CALIBRATION)  
-      apply_azimuth_offset();
+      raw_azimuth_centidegrees = apply_azimuth_offset_centidegrees(raw_azimuth_centidegrees);
       #endif
+      raw_azimuth = centidegrees_to_degrees(raw_azimuth_centidegrees);
       azimuth = raw_azimuth;
     #endif //FEATURE_AZ_POSITION_DFROBOT_QMC5883
 
@@ -8492,18 +10563,18 @@ void read_azimuth(byte force_read){
         mecha_azimuth -= 360;
       }
 
-      raw_azimuth = mecha_azimuth;
+      raw_azimuth_centidegrees = mecha_azimuth * 100L;
 
       if (AZIMUTH_SMOOTHING_FACTOR > 0) {
-        if (raw_azimuth < 0){raw_azimuth = 0;}
-        raw_azimuth = (raw_azimuth * ((float)1 - ((float)AZIMUTH_SMOOTHING_FACTOR / (float)100))) + ((float)previous_raw_azimuth * ((float)AZIMUTH_SMOOTHING_FACTOR / (float)100));
+        raw_azimuth_centidegrees = smooth_centidegrees(raw_azimuth_centidegrees, previous_raw_azimuth * 100L, AZIMUTH_SMOOTHING_WEIGHT);
       }
       #ifdef FEATURE_AZIMUTH_CORRECTION
-        raw_azimuth = correct_azimuth(raw_azimuth);
+        raw_azimuth_centidegrees = correct_azimuth_centidegrees(raw_azimuth_centidegrees);
       #endif // FEATURE_AZIMUTH_CORRECTION
       #if !defined(FEATURE_CALIBRATION)  
-      apply_azimuth_offset();
+      raw_azimuth_centidegrees = apply_azimuth_offset_centidegrees(raw_azimuth_centidegrees);
       #endif
+      raw_azimuth = centidegrees_to_degrees(raw_azimuth_centidegrees);
       azimuth = raw_azimuth;
     #endif //FEATURE_AZ_POSITION_MECHASOLUTION_QMC5883
 
@@ -8516,17 +10587,17 @@ void read_azimuth(byte force_read){
       // Correct for when signs are reversed.
       if (heading < 0) heading += 2 * PI;
       if (heading > 2 * PI) heading -= 2 * PI;
-      raw_azimuth = (heading * RAD_TO_DEG); // radians to degree
+      raw_azimuth_centidegrees = degrees_to_centidegrees(heading * RAD_TO_DEG); // radians to degree
       #ifdef FEATURE_AZIMUTH_CORRECTION
-        raw_azimuth = correct_azimuth(raw_azimuth);
+        raw_azimuth_centidegrees = correct_azimuth_centidegrees(raw_azimuth_centidegrees);
       #endif // FEATURE_AZIMUTH_CORRECTION
       #if !defined(FEATURE_CALIBRATION)  
-      apply_azimuth_offset();
+      raw_azimuth_centidegrees = apply_azimuth_offset_centidegrees(raw_azimuth_centidegrees);
       #endif
       if (AZIMUTH_SMOOTHING_FACTOR > 0) {
-        if (raw_azimuth < 0){raw_azimuth = 0;}
-        raw_azimuth = (raw_azimuth * ((float)1 - ((float)AZIMUTH_SMOOTHING_FACTOR / (float)100))) + ((float)previous_raw_azimuth * ((float)AZIMUTH_SMOOTHING_FACTOR / (float)100));
+        raw_azimuth_centidegrees = smooth_centidegrees(raw_azimuth_centidegrees, previous_raw_azimuth * 100L, AZIMUTH_SMOOTHING_WEIGHT);
       }
+      raw_azimuth = centidegrees_to_degrees(raw_azimuth_centidegrees);
       azimuth = raw_azimuth;
     #endif // FEATURE_AZ_POSITION_ADAFRUIT_LSM303
 
@@ -8573,19 +10644,19 @@ void read_azimuth(byte force_read){
       /*
       if (heading < 0) heading += 2 * PI;
       if (heading > 2 * PI) heading -= 2 * PI;
-      raw_azimuth = (heading * RAD_TO_DEG); // radians to degree
+      raw_azimuth_centidegrees = degrees_to_centidegrees(heading * RAD_TO_DEG); // radians to degree
       */
-      raw_azimuth = heading ;  // pololu library returns float value of actual heading.
+      raw_azimuth_centidegrees = degrees_to_centidegrees(heading);  // pololu library returns float value of actual heading.
       #ifdef FEATURE_AZIMUTH_CORRECTION
-        raw_azimuth = correct_azimuth(raw_azimuth);
+        raw_azimuth_centidegrees = correct_azimuth_centidegrees(raw_azimuth_centidegrees);
       #endif // FEATURE_AZIMUTH_CORRECTION
       #if !defined(FEATURE_CALIBRATION)  
-      apply_azimuth_offset();
+      raw_azimuth_centidegrees = apply_azimuth_offset_centidegrees(raw_azimuth_centidegrees);
       #endif
       if (AZIMUTH_SMOOTHING_FACTOR > 0) {
-        if (raw_azimuth < 0){raw_azimuth = 0;}
-        raw_azimuth = (raw_azimuth * ((float)1 - ((float)AZIMUTH_SMOOTHING_FACTOR / (float)100))) + ((float)previous_raw_azimuth * ((float)AZIMUTH_SMOOTHING_FACTOR / (float)100));
+        raw_azimuth_centidegrees = smooth_centidegrees(raw_azimuth_centidegrees, previous_raw_azimuth * 100L, AZIMUTH_SMOOTHING_WEIGHT);
       }
+      raw_azimuth = centidegrees_to_degrees(raw_azimuth_centidegrees);
       azimuth = raw_azimuth;
     #endif // FEATURE_AZ_POSITION_POLOLU_LSM303
 
@@ -8614,37 +10685,37 @@ void read_azimuth(byte force_read){
         configuration.last_azimuth = az_position_pulse_input_azimuth;
         configuration_dirty = 1;
         last_az_position_pulse_input_azimuth = az_position_pulse_input_azimuth;
-        raw_azimuth = configuration.last_azimuth;
+        raw_azimuth_centidegrees = degrees_to_centidegrees(configuration.last_azimuth);
         #ifdef FEATURE_AZIMUTH_CORRECTION
-          raw_azimuth = correct_azimuth(raw_azimuth);
+          raw_azimuth_centidegrees = correct_azimuth_centidegrees(raw_azimuth_centidegrees);
         #endif // FEATURE_AZIMUTH_CORRECTION
         #if !defined(FEATURE_CALIBRATION)  
-        apply_azimuth_offset();
+        raw_azimuth_centidegrees = apply_azimuth_offset_centidegrees(raw_azimuth_centidegrees);
         #endif
-        convert_raw_azimuth_to_real_azimuth();
+        convert_raw_azimuth_centidegrees_to_real_azimuth(raw_azimuth_centidegrees);
       }
     #endif // FEATURE_AZ_POSITION_PULSE_INPUT
 
     #ifdef FEATURE_AZ_POSITION_HH12_AS5045_SSI
       #if defined(OPTION_REVERSE_AZ_HH12_AS5045)
-        raw_azimuth = 360.0 - azimuth_hh12.heading() + (float)configuration.azimuth_starting_point;
+        raw_azimuth_centidegrees = degrees_to_centidegrees(360.0 - azimuth_hh12.heading()) + (configuration.azimuth_starting_point * 100L);
       #else
-        raw_azimuth = azimuth_hh12.heading() + (float)configuration.azimuth_starting_point;
+        raw_azimuth_centidegrees = degrees_to_centidegrees(azimuth_hh12.heading()) + (configuration.azimuth_starting_point * 100L);
       #endif
       #ifdef DEBUG_HH12
         if ((millis() - last_hh12_debug) > 5000) {
           debug.print(F("read_azimuth: HH-12 raw: "));
-          control_port->println(raw_azimuth);
+          control_port->println(centidegrees_to_degrees(raw_azimuth_centidegrees));
           last_hh12_debug = millis();
         }
       #endif // DEBUG_HH12
       #ifdef FEATURE_AZIMUTH_CORRECTION
-        raw_azimuth = correct_azimuth(raw_azimuth);
+        raw_azimuth_centidegrees = correct_azimuth_centidegrees(raw_azimuth_centidegrees);
       #endif // FEATURE_AZIMUTH_CORRECTION
       #if !defined(FEATURE_CALIBRATION)  
-      apply_azimuth_offset();
+      raw_azimuth_centidegrees = apply_azimuth_offset_centidegrees(raw_azimuth_centidegrees);
       #endif
-      convert_raw_azimuth_to_real_azimuth();
+      convert_raw_azimuth_centidegrees_to_real_azimuth(raw_azimuth_centidegrees);
     #endif // FEATURE_AZ_POSITION_HH12_AS5045_SSI
 
 // zzzzzz
@@ -8735,35 +10806,41 @@ void read_azimuth(byte force_read){
       //   }
       // #endif // DEBUG_HH12
 
+      raw_azimuth_centidegrees = degrees_to_centidegrees(raw_azimuth);
       #ifdef FEATURE_AZIMUTH_CORRECTION
-        raw_azimuth = correct_azimuth(raw_azimuth);
+        raw_azimuth_centidegrees = correct_azimuth_centidegrees(raw_azimuth_centidegrees);
       #endif // FEATURE_AZIMUTH_CORRECTION
       #if !defined(FEATURE_CALIBRATION)  
-        apply_azimuth_offset();
+        raw_azimuth_centidegrees = apply_azimuth_offset_centidegrees(raw_azimuth_centidegrees);
       #endif
-      convert_raw_azimuth_to_real_azimuth();
+      convert_raw_azimuth_centidegrees_to_real_azimuth(raw_azimuth_centidegrees);
       hh12_last_reading = hh12_current_reading;
     #endif // FEATURE_AZ_POSITION_HH12_AS5045_SSI_RELATIVE
 
     #ifdef FEATURE_AZ_POSITION_INCREMENTAL_ENCODER
+      noInterrupts();
+      encoder_position = az_incremental_encoder_position;
+      az_incremental_encoder_moved = 0;
+      interrupts();
+      // 36000 centidegrees per PULSES_PER_REV*4 counts
       if (configuration.azimuth_starting_point == 0) {
-        raw_azimuth = (((((az_incremental_encoder_position) / (AZ_POSITION_INCREMENTAL_ENCODER_PULSES_PER_REV*4.)) * 360.0)));
+        raw_azimuth_centidegrees = (encoder_position * 9000L) / AZ_POSITION_INCREMENTAL_ENCODER_PULSES_PER_REV;
       } else {
-        if (az_incremental_encoder_position > (AZ_POSITION_INCREMENTAL_ENCODER_PULSES_PER_REV*4.)) {
-          raw_azimuth = (((((az_incremental_encoder_position - (AZ_POSITION_INCREMENTAL_ENCODER_PULSES_PER_REV*4.)) / (AZ_POSITION_INCREMENTAL_ENCODER_PULSES_PER_REV*4.)) * 360.0)));
+        if (encoder_position > (AZ_POSITION_INCREMENTAL_ENCODER_PULSES_PER_REV*4L)) {
+          raw_azimuth_centidegrees = ((encoder_position - (AZ_POSITION_INCREMENTAL_ENCODER_PULSES_PER_REV*4L)) * 9000L) / AZ_POSITION_INCREMENTAL_ENCODER_PULSES_PER_REV;
         } else {
-          raw_azimuth = (((((az_incremental_encoder_position + (AZ_POSITION_INCREMENTAL_ENCODER_PULSES_PER_REV*4.)) / (AZ_POSITION_INCREMENTAL_ENCODER_PULSES_PER_REV*4.)) * 360.0)));
+          raw_azimuth_centidegrees = ((encoder_position + (AZ_POSITION_INCREMENTAL_ENCODER_PULSES_PER_REV*4L)) * 9000L) / AZ_POSITION_INCREMENTAL_ENCODER_PULSES_PER_REV;
         }
       }
       #ifdef FEATURE_AZIMUTH_CORRECTION
-        raw_azimuth = (correct_azimuth(raw_azimuth));
+        raw_azimuth_centidegrees = correct_azimuth_centidegrees(raw_azimuth_centidegrees);
       #endif // FEATURE_AZIMUTH_CORRECTION
       #if !defined(FEATURE_CALIBRATION)  
-      apply_azimuth_offset();
+      raw_azimuth_centidegrees = apply_azimuth_offset_centidegrees(raw_azimuth_centidegrees);
       #endif
-      convert_raw_azimuth_to_real_azimuth();
+      convert_raw_azimuth_centidegrees_to_real_azimuth(raw_azimuth_centidegrees);
       if (raw_azimuth != incremental_encoder_previous_raw_azimuth) {
-        configuration.last_az_incremental_encoder_position = az_incremental_encoder_position;
+        configuration.last_az_incremental_encoder_position = encoder_position;
         configuration_dirty = 1;
         incremental_encoder_previous_raw_azimuth = raw_azimuth;
       }
@@ -8774,20 +10851,20 @@ void read_azimuth(byte force_read){
 
 
   #ifdef FEATURE_AZ_POSITION_A2_ABSOLUTE_ENCODER
-    raw_azimuth = az_a2_encoder;
+    raw_azimuth_centidegrees = degrees_to_centidegrees(az_a2_encoder);
     #ifdef FEATURE_AZIMUTH_CORRECTION
-      raw_azimuth = (correct_azimuth(raw_azimuth));
+      raw_azimuth_centidegrees = correct_azimuth_centidegrees(raw_azimuth_centidegrees);
     #endif // FEATURE_AZIMUTH_CORRECTION
     #if !defined(FEATURE_CALIBRATION)  
-    apply_azimuth_offset();
+    raw_azimuth_centidegrees = apply_azimuth_offset_centidegrees(raw_azimuth_centidegrees);
     #endif
+    raw_azimuth = centidegrees_to_degrees(raw_azimuth_centidegrees);
     azimuth = raw_azimuth;
   #endif //FEATURE_AZ_POSITION_A2_ABSOLUTE_ENCODER  
 
-  #ifdef FEATURE_AZ_POSITION_INCREMENTAL_ENCODER
-    read_azimuth_lock = 0;
-  #endif
-
+  if (new_measurement){
+    update_heading_estimate(azimuth_estimate,raw_azimuth,measurement_time);
+  }
 
 
 } /* read_azimuth */
@@ -9186,6 +11263,17 @@ void output_debug(){
         #if (defined(FEATURE_AZ_POSITION_INCREMENTAL_ENCODER) && defined(DEBUG_AZ_POSITION_INCREMENTAL_ENCODER)) || (defined(FEATURE_EL_POSITION_INCREMENTAL_ENCODER) && defined(DEBUG_EL_POSITION_INCREMENTAL_ENCODER))
           debug.println("");
         #endif
+        #if defined(FEATURE_AZ_POSITION_INCREMENTAL_ENCODER)
+          debug.print("\taz_incremental_encoder_missed_transitions:");
+          debug.print(az_incremental_encoder_missed_transitions);
+        #endif // FEATURE_AZ_POSITION_INCREMENTAL_ENCODER
+        #if defined(FEATURE_EL_POSITION_INCREMENTAL_ENCODER) && defined(FEATURE_ELEVATION_CONTROL)
+          debug.print("\tel_incremental_encoder_missed_transitions:");
+          debug.print(el_incremental_encoder_missed_transitions);
+        #endif // FEATURE_EL_POSITION_INCREMENTAL_ENCODER
+        #if defined(FEATURE_AZ_POSITION_INCREMENTAL_ENCODER) || (defined(FEATURE_EL_POSITION_INCREMENTAL_ENCODER) && defined(FEATURE_ELEVATION_CONTROL))
+          debug.println("");
+        #endif
 
         #ifdef FEATURE_MOON_TRACKING
           update_moon_position();
@@ -9375,19 +11463,9 @@ void output_debug(){
 
           #else //OPTION_USE_OLD_TIME_CODE
 
-          debug.print(satellite[current_satellite_position_in_array].next_aos.Year+1970);
-          debug.print("-");
-          if (satellite[current_satellite_position_in_array].next_aos.Month < 10){debug.print("0");}
-          debug.print(satellite[current_satellite_position_in_array].next_aos.Month);
-          debug.print("-");    
-          if (satellite[current_satellite_position_in_array].next_aos.Day < 10){debug.print("0");}
-          debug.print(satellite[current_satellite_position_in_array].next_aos.Day);
+          debug.print(tm_date_string(&satellite[current_satellite_position_in_array].next_aos));
           debug.print(" ");
-          if (satellite[current_satellite_position_in_array].next_aos.Hour < 10){debug.print("0");}
-          debug.print(satellite[current_satellite_position_in_array].next_aos.Hour);
-          debug.print(":");
-          if (satellite[current_satellite_position_in_array].next_aos.Minute < 10){debug.print("0");}
-          debug.print(satellite[current_satellite_position_in_array].next_aos.Minute);
+          debug.print(tm_time_string_short(&satellite[current_satellite_position_in_array].next_aos));
 
 
           debug.print(" ");
@@ -9398,19 +11476,9 @@ void output_debug(){
           if (current_satellite_next_aos_el > 0){debug.print(" ");}
           debug.print(current_satellite_next_aos_el);
           debug.print("  LOS:");
-          debug.print(satellite[current_satellite_position_in_array].next_los.Year+1970);
-          debug.print("-");
-          if (satellite[current_satellite_position_in_array].next_los.Month < 10){debug.print("0");}
-          debug.print(satellite[current_satellite_position_in_array].next_los.Month);
-          debug.print("-");    
-          if (satellite[current_satellite_position_in_array].next_los.Day < 10){debug.print("0");}
-          debug.print(satellite[current_satellite_position_in_array].next_los.Day);
+          debug.print(tm_date_string(&satellite[current_satellite_position_in_array].next_los));
           debug.print(" ");
-          if (satellite[current_satellite_position_in_array].next_los.Hour < 10){debug.print("0");}
-          debug.print(satellite[current_satellite_position_in_array].next_los.Hour);
-          debug.print(":");
-          if (satellite[current_satellite_position_in_array].next_los.Minute < 10){debug.print("0");}
-          debug.print(satellite[current_satellite_position_in_array].next_los.Minute);
+          debug.print(tm_time_string_short(&satellite[current_satellite_position_in_array].next_los));
           debug.print(" ");
           if (current_satellite_next_los_az < 10){debug.print(" ");}
           if (current_satellite_next_los_az < 100){debug.print(" ");}
@@ -9569,16 +11637,19 @@ void el_check_operation_timeout(){
 #ifdef FEATURE_ELEVATION_CONTROL
 void read_elevation(byte force_read){
 
-  #ifdef FEATURE_EL_POSITION_INCREMENTAL_ENCODER
-    read_elevation_lock = 1;
-  #endif
-
-
   unsigned int previous_elevation = elevation;
+  long elevation_centidegrees = 0;
   static unsigned long last_measurement_time = 0;
+  unsigned long measurement_time = 0;
+  byte new_measurement = 0;
+
+  #if defined(FEATURE_EL_POSITION_POTENTIOMETER) && defined(OPTION_POTENTIOMETER_ADC_OVERSAMPLING)
+    int analog_el_oversampled;
+  #endif
 
   #ifdef FEATURE_EL_POSITION_INCREMENTAL_ENCODER
     static unsigned int incremental_encoder_previous_elevation = elevation;
+    long encoder_position;
   #endif
 
   if (heading_reading_inhibit_pin) {
@@ -9603,22 +11674,31 @@ void read_elevation(byte force_read){
   if (1) {
   #endif
 
+    measurement_time = millis();
+    new_measurement = 1;
+
     #ifdef FEATURE_EL_POSITION_POTENTIOMETER
-      analog_el = analogReadEnhanced(rotator_analog_el);
-      elevation = float_map(analog_el, configuration.analog_el_0_degrees, configuration.analog_el_max_elevation, 0, ELEVATION_MAXIMUM_DEGREES);
+      #if defined(OPTION_POTENTIOMETER_ADC_OVERSAMPLING)
+        analog_el_oversampled = read_potentiometer_sampler(POTENTIOMETER_SAMPLER_ELEVATION);
+        analog_el = (analog_el_oversampled + ((1 << POTENTIOMETER_OVERSAMPLING_EXTRA_BITS) >> 1)) >> POTENTIOMETER_OVERSAMPLING_EXTRA_BITS;
+        elevation_centidegrees = map_analog_to_centidegrees(elevation_analog_map, analog_el_oversampled, configuration.analog_el_0_degrees << POTENTIOMETER_OVERSAMPLING_EXTRA_BITS, configuration.analog_el_max_elevation << POTENTIOMETER_OVERSAMPLING_EXTRA_BITS, 0, ELEVATION_MAXIMUM_DEGREES * 100L, POTENTIOMETER_FULL_SCALE);
+      #else
+        analog_el = analogReadEnhanced(rotator_analog_el);
+        elevation_centidegrees = map_analog_to_centidegrees(elevation_analog_map, analog_el, configuration.analog_el_0_degrees, configuration.analog_el_max_elevation, 0, ELEVATION_MAXIMUM_DEGREES * 100L, POTENTIOMETER_FULL_SCALE);
+      #endif
       #ifdef FEATURE_ELEVATION_CORRECTION
-        elevation = correct_elevation(elevation);
+        elevation_centidegrees = correct_elevation_centidegrees(elevation_centidegrees);
       #endif // FEATURE_ELEVATION_CORRECTION
       #if !defined(FEATURE_CALIBRATION)  
-      elevation = elevation + (configuration.elevation_offset);
+      elevation_centidegrees = apply_elevation_offset_centidegrees(elevation_centidegrees);
       #endif
       if (ELEVATION_SMOOTHING_FACTOR > 0) {
-        if (elevation < 0){elevation = 0;}
-        elevation = (elevation * ((float)1 - ((float)ELEVATION_SMOOTHING_FACTOR / (float)100))) + ((float)previous_elevation * ((float)ELEVATION_SMOOTHING_FACTOR / (float)100));
+        elevation_centidegrees = smooth_centidegrees(elevation_centidegrees, previous_elevation * 100L, ELEVATION_SMOOTHING_WEIGHT);
       }
-      if (elevation < 0) {
-        elevation = 0;
+      if (elevation_centidegrees < 0) {
+        elevation_centidegrees = 0;
       }
+      elevation = centidegrees_to_degrees(elevation_centidegrees);
     #endif // FEATURE_EL_POSITION_POTENTIOMETER
 
 
@@ -9651,10 +11731,11 @@ void read_elevation(byte force_read){
               configuration.last_elevation = ELEVATION_MAXIMUM_DEGREES;
             }
           #endif
-        elevation = configuration.last_elevation;
+        elevation_centidegrees = degrees_to_centidegrees(configuration.last_elevation);
         #ifdef FEATURE_ELEVATION_CORRECTION
-          elevation = correct_elevation(elevation);
+          elevation_centidegrees = correct_elevation_centidegrees(elevation_centidegrees);
         #endif // FEATURE_ELEVATION_CORRECTION
+        elevation = centidegrees_to_degrees(elevation_centidegrees);
         configuration_dirty = 1;
       }
     #endif // FEATURE_EL_POSITION_ROTARY_ENCODER
@@ -9688,10 +11769,11 @@ void read_elevation(byte force_read){
           }
         #endif
             
-        elevation = configuration.last_elevation;
+        elevation_centidegrees = degrees_to_centidegrees(configuration.last_elevation);
         #ifdef FEATURE_ELEVATION_CORRECTION
-          elevation = correct_elevation(elevation);
+          elevation_centidegrees = correct_elevation_centidegrees(elevation_centidegrees);
         #endif // FEATURE_ELEVATION_CORRECTION
+        elevation = centidegrees_to_degrees(elevation_centidegrees);
         configuration_dirty = 1;
         
          #ifdef OPTION_EL_POSITION_ROTARY_ENCODER_HARD_LIMIT
@@ -9703,12 +11785,13 @@ void read_elevation(byte force_read){
           }
         #endif
             
-        elevation = configuration.last_elevation;
+        elevation_centidegrees = degrees_to_centidegrees(configuration.last_elevation);
 
         #ifdef FEATURE_ELEVATION_CORRECTION
-          elevation = correct_elevation(elevation);
+          elevation_centidegrees = correct_elevation_centidegrees(elevation_centidegrees);
         #endif // FEATURE_ELEVATION_CORRECTION
 
+        elevation = centidegrees_to_degrees(elevation_centidegrees);
         configuration_dirty = 1; 
           
       }
@@ -9725,17 +11808,17 @@ void read_elevation(byte force_read){
           debug.println(raw.ZAxis);
         }
       #endif // DEBUG_ACCEL
-      elevation = (atan2(scaled.YAxis, scaled.ZAxis) * 180) / M_PI;
+      elevation_centidegrees = degrees_to_centidegrees((atan2(scaled.YAxis, scaled.ZAxis) * 180) / M_PI);
       #ifdef FEATURE_ELEVATION_CORRECTION
-        elevation = correct_elevation(elevation);
+        elevation_centidegrees = correct_elevation_centidegrees(elevation_centidegrees);
       #endif // FEATURE_ELEVATION_CORRECTION
       #if !defined(FEATURE_CALIBRATION)  
-      elevation = elevation + (configuration.elevation_offset);
+      elevation_centidegrees = apply_elevation_offset_centidegrees(elevation_centidegrees);
       #endif
       if (ELEVATION_SMOOTHING_FACTOR > 0) {
-        if (elevation < 0){elevation = 0;}
-        elevation = (elevation * ((float)1 - ((float)ELEVATION_SMOOTHING_FACTOR / (float)100))) + ((float)previous_elevation * ((float)ELEVATION_SMOOTHING_FACTOR / (float)100));
+        elevation_centidegrees = smooth_centidegrees(elevation_centidegrees, previous_elevation * 100L, ELEVATION_SMOOTHING_WEIGHT);
       }
+      elevation = centidegrees_to_degrees(elevation_centidegrees);
     #endif // FEATURE_EL_POSITION_ADXL345_USING_LOVE_ELECTRON_LIB
 
     #ifdef FEATURE_EL_POSITION_ADXL345_USING_ADAFRUIT_LIB
@@ -9749,13 +11832,14 @@ void read_elevation(byte force_read){
           debug.println(event.acceleration.z);
         }
       #endif // DEBUG_ACCEL
-      elevation = (atan2(event.acceleration.y, event.acceleration.z) * 180) / M_PI;
+      elevation_centidegrees = degrees_to_centidegrees((atan2(event.acceleration.y, event.acceleration.z) * 180) / M_PI);
       #ifdef FEATURE_ELEVATION_CORRECTION
-        elevation = correct_elevation(elevation);
+        elevation_centidegrees = correct_elevation_centidegrees(elevation_centidegrees);
       #endif // FEATURE_ELEVATION_CORRECTION
       #if !defined(FEATURE_CALIBRATION)  
-      elevation = elevation + (configuration.elevation_offset);
+      elevation_centidegrees = apply_elevation_offset_centidegrees(elevation_centidegrees);
       #endif
+      elevation = centidegrees_to_degrees(elevation_centidegrees);
     #endif // FEATURE_EL_POSITION_ADXL345_USING_ADAFRUIT_LIB
 
 
@@ -9770,13 +11854,14 @@ void read_elevation(byte force_read){
             control_port->println(lsm.accelData.z);
           }
       #endif // DEBUG_ACCEL
-      elevation = (atan2(lsm.accelData.y, lsm.accelData.z) * 180) / M_PI;
+      elevation_centidegrees = degrees_to_centidegrees((atan2(lsm.accelData.y, lsm.accelData.z) * 180) / M_PI);
       #ifdef FEATURE_ELEVATION_CORRECTION
-        elevation = correct_elevation(elevation);
+        elevation_centidegrees = correct_elevation_centidegrees(elevation_centidegrees);
       #endif // FEATURE_ELEVATION_CORRECTION
       #if !defined(FEATURE_CALIBRATION)  
-      elevation = elevation + (configuration.elevation_offset);
+      elevation_centidegrees = apply_elevation_offset_centidegrees(elevation_centidegrees);
       #endif
+      elevation = centidegrees_to_degrees(elevation_centidegrees);
     #endif // FEATURE_EL_POSITION_ADAFRUIT_LSM303
 
     #ifdef FEATURE_EL_POSITION_POLOLU_LSM303
@@ -9789,13 +11874,14 @@ void read_elevation(byte force_read){
           control_port->println(compass.a.z);
         }
       #endif // DEBUG_ACCEL
-      elevation = (atan2(compass.a.x, compass.a.z) * -180) / M_PI; //lsm.accelData.y
+      elevation_centidegrees = degrees_to_centidegrees((atan2(compass.a.x, compass.a.z) * -180) / M_PI); //lsm.accelData.y
       #ifdef FEATURE_ELEVATION_CORRECTION
-        elevation = correct_elevation(elevation);
+        elevation_centidegrees = correct_elevation_centidegrees(elevation_centidegrees);
       #endif // FEATURE_ELEVATION_CORRECTION
       #if !defined(FEATURE_CALIBRATION)  
-      elevation = elevation + (configuration.elevation_offset);
+      elevation_centidegrees = apply_elevation_offset_centidegrees(elevation_centidegrees);
       #endif
+      elevation = centidegrees_to_degrees(elevation_centidegrees);
     #endif // FEATURE_EL_POSITION_POLOLU_LSM303
 
 
@@ -9820,13 +11906,14 @@ void read_elevation(byte force_read){
       configuration.last_elevation = el_position_pulse_input_elevation;
       configuration_dirty = 1;
       last_el_position_pulse_input_elevation = el_position_pulse_input_elevation;
-      elevation = configuration.last_elevation;
+      elevation_centidegrees = degrees_to_centidegrees(configuration.last_elevation);
       #ifdef FEATURE_ELEVATION_CORRECTION
-        elevation = correct_elevation(elevation);
+        elevation_centidegrees = correct_elevation_centidegrees(elevation_centidegrees);
       #endif //FEATURE_ELEVATION_CORRECTION
       #if !defined(FEATURE_CALIBRATION)  
-      elevation = elevation + configuration.elevation_offset;
+      elevation_centidegrees = apply_elevation_offset_centidegrees(elevation_centidegrees);
       #endif
+      elevation = centidegrees_to_degrees(elevation_centidegrees);
     }
     #endif // FEATURE_EL_POSITION_PULSE_INPUT
 
@@ -9848,17 +11935,17 @@ void read_elevation(byte force_read){
         }
       }
       #endif // DEBUG_HEADING_READING_TIME
-      elevation = remote_unit_elevation_float;
+      elevation_centidegrees = degrees_to_centidegrees(remote_unit_elevation_float);
       #ifdef FEATURE_ELEVATION_CORRECTION
-        elevation = correct_elevation(elevation);
+        elevation_centidegrees = correct_elevation_centidegrees(elevation_centidegrees);
       #endif // FEATURE_ELEVATION_CORRECTION
       #if !defined(FEATURE_CALIBRATION)  
-        elevation = elevation + (configuration.elevation_offset);
+        elevation_centidegrees = apply_elevation_offset_centidegrees(elevation_centidegrees);
       #endif
       if (ELEVATION_SMOOTHING_FACTOR > 0) {
-        if (elevation < 0){elevation = 0;}
-        elevation = (elevation * ((float)1 - ((float)ELEVATION_SMOOTHING_FACTOR / (float)100))) + ((float)previous_elevation * ((float)ELEVATION_SMOOTHING_FACTOR / (float)100));
+        elevation_centidegrees = smooth_centidegrees(elevation_centidegrees, previous_elevation * 100L, ELEVATION_SMOOTHING_WEIGHT);
       }
+      elevation = centidegrees_to_degrees(elevation_centidegrees);
       // remote_unit_command_results_available = 0;
     /*} else {
       // is it time to request the elevation?
@@ -9874,44 +11961,51 @@ void read_elevation(byte force_read){
 
     #ifdef FEATURE_EL_POSITION_HH12_AS5045_SSI
       #if defined(OPTION_REVERSE_EL_HH12_AS5045) 
-        elevation = 360.0 - elevation_hh12.heading();
+        elevation_centidegrees = degrees_to_centidegrees(360.0 - elevation_hh12.heading());
       #else
-        elevation = elevation_hh12.heading();
+        elevation_centidegrees = degrees_to_centidegrees(elevation_hh12.heading());
       #endif
       #ifdef DEBUG_HH12
         if ((millis() - last_hh12_debug) > 5000) {
           debug.print(F("read_elevation: HH-12 from device: "));
           debug.print(elevation_hh12.heading());
           debug.print(F(" uncorrected: "));
-          debug.println(elevation);
+          debug.println(centidegrees_to_degrees(elevation_centidegrees));
           // control_port->println(elevation);
           last_hh12_debug = millis();
         }
       #endif // DEBUG_HH12
       #ifdef FEATURE_ELEVATION_CORRECTION
-        elevation = correct_elevation(elevation);
+        elevation_centidegrees = correct_elevation_centidegrees(elevation_centidegrees);
       #endif // FEATURE_ELEVATION_CORRECTION
       #if !defined(FEATURE_CALIBRATION)  
-      elevation = elevation + configuration.elevation_offset;
+      elevation_centidegrees = apply_elevation_offset_centidegrees(elevation_centidegrees);
       #endif
-      if (elevation > 180) {
-        elevation = elevation - 360.0;
+      if (elevation_centidegrees > 18000) {
+        elevation_centidegrees = elevation_centidegrees - 36000;
       }
+      elevation = centidegrees_to_degrees(elevation_centidegrees);
     #endif // FEATURE_EL_POSITION_HH12_AS5045_SSI
 
 
     #ifdef FEATURE_EL_POSITION_INCREMENTAL_ENCODER
-      elevation = ((((el_incremental_encoder_position) / (EL_POSITION_INCREMENTAL_ENCODER_PULSES_PER_REV*4.)) * 360.0));
+      noInterrupts();
+      encoder_position = el_incremental_encoder_position;
+      el_incremental_encoder_moved = 0;
+      interrupts();
+      elevation_centidegrees = (encoder_position * 9000L) / EL_POSITION_INCREMENTAL_ENCODER_PULSES_PER_REV;  // 36000 centidegrees per PULSES_PER_REV*4 counts
     #ifdef FEATURE_ELEVATION_CORRECTION
-    elevation = correct_elevation(elevation);
+    elevation_centidegrees = correct_elevation_centidegrees(elevation_centidegrees);
     #endif // FEATURE_ELEVATION_CORRECTION
+    elevation = centidegrees_to_degrees(elevation_centidegrees);
     if (incremental_encoder_previous_elevation != elevation) {
-      configuration.last_el_incremental_encoder_position = el_incremental_encoder_position;
+      configuration.last_el_incremental_encoder_position = encoder_position;
       configuration_dirty = 1;
       incremental_encoder_previous_elevation = elevation;
     }
     #if !defined(FEATURE_CALIBRATION)  
-    elevation = elevation + (configuration.elevation_offset);
+    elevation_centidegrees = apply_elevation_offset_centidegrees(elevation_centidegrees);
+    elevation = centidegrees_to_degrees(elevation_centidegrees);
     #endif
     #endif // FEATURE_EL_POSITION_INCREMENTAL_ENCODER
 
@@ -9924,30 +12018,30 @@ void read_elevation(byte force_read){
     debug.print(pulseY);
     debug.println("");
     #endif //DEBUG_MEMSIC_2125
-    elevation = Yangle;    
+    elevation_centidegrees = degrees_to_centidegrees(Yangle);
     #ifdef FEATURE_ELEVATION_CORRECTION
-    elevation = correct_elevation(elevation);
+    elevation_centidegrees = correct_elevation_centidegrees(elevation_centidegrees);
     #endif //FEATURE_ELEVATION_CORRECTION
+    elevation = centidegrees_to_degrees(elevation_centidegrees);
     #endif //FEATURE_EL_POSITION_MEMSIC_2125
 
     last_measurement_time = millis();
   }
 
   #ifdef FEATURE_EL_POSITION_A2_ABSOLUTE_ENCODER
-    elevation = el_a2_encoder;
+    elevation_centidegrees = degrees_to_centidegrees(el_a2_encoder);
     #ifdef FEATURE_ELEVATION_CORRECTION
-    elevation = correct_elevation(elevation);
+    elevation_centidegrees = correct_elevation_centidegrees(elevation_centidegrees);
     #endif //FEATURE_ELEVATION_CORRECTION
     #if !defined(FEATURE_CALIBRATION)  
-    elevation = elevation + (configuration.elevation_offset);
+    elevation_centidegrees = apply_elevation_offset_centidegrees(elevation_centidegrees);
     #endif
+    elevation = centidegrees_to_degrees(elevation_centidegrees);
   #endif //FEATURE_EL_POSITION_A2_ABSOLUTE_ENCODER  
 
-
-  #ifdef FEATURE_EL_POSITION_INCREMENTAL_ENCODER
-  read_elevation_lock = 0;
-  #endif
-
+  if (new_measurement){
+    update_heading_estimate(elevation_estimate,elevation,measurement_time);
+  }
 
 } /* read_elevation */
 #endif /* ifdef FEATURE_ELEVATION_CONTROL */
@@ -10650,6 +12744,10 @@ void initialize_interrupts(){
     control_port->flush();
   #endif // DEBUG_LOOP
 
+  #if defined(OPTION_POTENTIOMETER_ADC_OVERSAMPLING) && (defined(FEATURE_AZ_POSITION_POTENTIOMETER) || defined(FEATURE_EL_POSITION_POTENTIOMETER))
+    initialize_potentiometer_sampler();
+  #endif
+
   #ifdef FEATURE_AZ_POSITION_PULSE_INPUT
     attachInterrupt(AZ_POSITION_PULSE_PIN_INTERRUPT, az_position_pulse_interrupt_handler, FALLING);
   #endif // FEATURE_AZ_POSITION_PULSE_INPUT
@@ -11278,6 +13376,10 @@ void initialize_peripherals(){
     ethernetserver0.begin();
   #endif //FEATURE_ETHERNET
 
+  #if defined(FEATURE_SATELLITE_TLE_CATALOG_SD)
+    initialize_tle_catalog();
+  #endif
+
   #ifdef SET_I2C_BUS_SPEED
      TWBR = ((F_CPU / SET_I2C_BUS_SPEED) - 16) / 2;
   #endif
@@ -11355,6 +13457,29 @@ void submit_request(byte axis, byte request, float parm, byte called_by){
 
 } /* submit_request */
 // --------------------------------------------------------------
+float slow_down_distance(byte axis){
+
+  // how far out from the target to start slowing down: the fixed SLOW_DOWN_BEFORE_TARGET degrees, or further
+  // out if the rotator is moving fast enough to cover more than that in SLOW_DOWN_BEFORE_TARGET_SECS
+
+  float distance = 0;
+
+  if (axis == AZ){
+    distance = abs(azimuth_estimate.velocity) * SLOW_DOWN_BEFORE_TARGET_SECS_AZ;
+    if (distance < SLOW_DOWN_BEFORE_TARGET_AZ){distance = SLOW_DOWN_BEFORE_TARGET_AZ;}
+  }
+
+  #ifdef FEATURE_ELEVATION_CONTROL
+    if (axis == EL){
+      distance = abs(elevation_estimate.velocity) * SLOW_DOWN_BEFORE_TARGET_SECS_EL;
+      if (distance < SLOW_DOWN_BEFORE_TARGET_EL){distance = SLOW_DOWN_BEFORE_TARGET_EL;}
+    }
+  #endif // FEATURE_ELEVATION_CONTROL
+
+  return distance;
+
+}
+// --------------------------------------------------------------
 void service_rotation(){
 
   #ifdef DEBUG_LOOP
@@ -11367,10 +13492,6 @@ void service_rotation(){
   #endif      
 
 
-  #if defined(FEATURE_AZ_POSITION_INCREMENTAL_ENCODER) || defined(FEATURE_EL_POSITION_INCREMENTAL_ENCODER)
-    service_rotation_lock = 1;
-  #endif
-
   static byte az_direction_change_flag = 0;
   static byte az_initial_slow_down_voltage = 0;
 
@@ -11539,7 +13660,7 @@ void service_rotation(){
   if ((az_state == SLOW_DOWN_CW) || (az_state == SLOW_DOWN_CCW)) {
 
     // is it time to do another step down?
-    if (abs((target_raw_azimuth - raw_azimuth)) <= (((float)SLOW_DOWN_BEFORE_TARGET_AZ * ((float)az_slow_down_step / (float)AZ_SLOW_DOWN_STEPS)))) {
+    if (abs((target_raw_azimuth - raw_azimuth)) <= ((az_slow_down_distance * ((float)az_slow_down_step / (float)AZ_SLOW_DOWN_STEPS)))) {
       #ifdef DEBUG_SERVICE_ROTATION
       debug.print("service_rotation: step down: ");
       debug.print(az_slow_down_step);
@@ -11556,7 +13677,7 @@ void service_rotation(){
   // if slow down is enabled, see if we're ready to go into slowdown
   //if (((az_state == NORMAL_CW) || (az_state == SLOW_START_CW) || (az_state == NORMAL_CCW) || (az_state == SLOW_START_CCW)) &&
   if (((az_state == NORMAL_CW) || (az_state == NORMAL_CCW)) && 
-      (az_request_queue_state == IN_PROGRESS_TO_TARGET) && az_slowdown_active && (abs((target_raw_azimuth - raw_azimuth)) <= SLOW_DOWN_BEFORE_TARGET_AZ)) {
+      (az_request_queue_state == IN_PROGRESS_TO_TARGET) && az_slowdown_active && (abs((target_raw_azimuth - raw_azimuth)) <= slow_down_distance(AZ))) {
 
     byte az_state_was = az_state;
 
@@ -11564,6 +13685,7 @@ void service_rotation(){
     debug.print("service_rotation: SLOW_DOWN_C");
     #endif // DEBUG_SERVICE_ROTATION
     az_slow_down_step = AZ_SLOW_DOWN_STEPS - 1;
+    az_slow_down_distance = slow_down_distance(AZ);
     if ((az_state == NORMAL_CW) || (az_state == SLOW_START_CW)) {
       az_state = SLOW_DOWN_CW;
       #ifdef DEBUG_SERVICE_ROTATION
@@ -11824,7 +13946,7 @@ void service_rotation(){
   // slow down ---------------------------------------------------------------------------------------------------------------
   if ((el_state == SLOW_DOWN_UP) || (el_state == SLOW_DOWN_DOWN)) {
     // is it time to do another step down?
-    if (abs((target_elevation - elevation)) <= (((float)SLOW_DOWN_BEFORE_TARGET_EL * ((float)el_slow_down_step / (float)EL_SLOW_DOWN_STEPS)))) {
+    if (abs((target_elevation - elevation)) <= ((el_slow_down_distance * ((float)el_slow_down_step / (float)EL_SLOW_DOWN_STEPS)))) {
       #ifdef DEBUG_SERVICE_ROTATION
       debug.print("service_rotation: step down: ");
       debug.print(el_slow_down_step);
@@ -11840,7 +13962,7 @@ void service_rotation(){
   // normal -------------------------------------------------------------------------------------------------------------------
   // if slow down is enabled, see if we're ready to go into slowdown
   if (((el_state == NORMAL_UP) || (el_state == SLOW_START_UP) || (el_state == NORMAL_DOWN) || (el_state == SLOW_START_DOWN)) &&
-      (el_request_queue_state == IN_PROGRESS_TO_TARGET) && el_slowdown_active && (abs((target_elevation - elevation)) <= SLOW_DOWN_BEFORE_TARGET_EL)) {
+      (el_request_queue_state == IN_PROGRESS_TO_TARGET) && el_slowdown_active && (abs((target_elevation - elevation)) <= slow_down_distance(EL))) {
     
     byte el_state_was = el_state;
 
@@ -11849,6 +13971,7 @@ void service_rotation(){
     debug.print("service_rotation: SLOW_DOWN_");
     #endif // DEBUG_SERVICE_ROTATION
     el_slow_down_step = EL_SLOW_DOWN_STEPS - 1;
+    el_slow_down_distance = slow_down_distance(EL);
     if ((el_state == NORMAL_UP) || (el_state == SLOW_START_UP)) {
       el_state = SLOW_DOWN_UP;
       #ifdef DEBUG_SERVICE_ROTATION
@@ -11949,10 +14072,6 @@ void service_rotation(){
 
   #endif // FEATURE_ELEVATION_CONTROL
 
-  #if defined(FEATURE_AZ_POSITION_INCREMENTAL_ENCODER) || defined(FEATURE_EL_POSITION_INCREMENTAL_ENCODER)
-    service_rotation_lock = 0;
-  #endif
-
 
   #ifdef DEBUG_PROCESSES
     service_process_debug(DEBUG_PROCESSES_PROCESS_EXIT,PROCESS_SERVICE_ROTATION);
@@ -12730,57 +14849,458 @@ void el_position_pulse_interrupt_handler(){
   }
   #endif //OPTION_EL_PULSE_DEBOUNCE --------------------------
 
-  #ifdef OPTION_EL_POSITION_PULSE_HARD_LIMIT
-  if (el_position_pulse_input_elevation < 0) {
-    el_position_pulse_input_elevation = 0;
+  #ifdef OPTION_EL_POSITION_PULSE_HARD_LIMIT
+  if (el_position_pulse_input_elevation < 0) {
+    el_position_pulse_input_elevation = 0;
+  }
+  if (el_position_pulse_input_elevation > ELEVATION_MAXIMUM_DEGREES) {
+    el_position_pulse_input_elevation = ELEVATION_MAXIMUM_DEGREES;
+  }
+  #endif // OPTION_EL_POSITION_PULSE_HARD_LIMIT
+
+
+} /* el_position_pulse_interrupt_handler */
+#endif // FEATURE_EL_POSITION_PULSE_INPUT
+#endif // FEATURE_ELEVATION_CONTROL
+// --------------------------------------------------------------------------
+// --------------------------------------------------------------------------
+#if defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+unsigned int correction_table_eeprom_address(byte table){
+
+  #if defined(FEATURE_AZIMUTH_CORRECTION)
+    if (table == CORRECTION_TABLE_ELEVATION){
+      return correction_table_eeprom_start + azimuth_correction_table_eeprom_size;
+    }
+  #endif
+  return correction_table_eeprom_start;
+
+}
+#endif // defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+// --------------------------------------------------------------------------
+#if defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+byte correction_table_eeprom_max_points(byte table){
+
+  #if defined(FEATURE_AZIMUTH_CORRECTION)
+    if (table == CORRECTION_TABLE_AZIMUTH){return AZIMUTH_CORRECTION_EEPROM_POINTS;}
+  #endif
+  #if defined(FEATURE_ELEVATION_CORRECTION)
+    if (table == CORRECTION_TABLE_ELEVATION){return ELEVATION_CORRECTION_EEPROM_POINTS;}
+  #endif
+  return 0;
+
+}
+#endif // defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+// --------------------------------------------------------------------------
+#if defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+long correction_table_eeprom_read_long(unsigned int address){
+
+  long value = (signed char)EEPROM.read(address + 3);  // the sign is in the top byte
+
+  for (byte x = 3; x > 0; x--){
+    value = (value << 8) | EEPROM.read(address + x - 1);
+  }
+  return value;
+
+}
+#endif // defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+// --------------------------------------------------------------------------
+#if defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+void correction_table_eeprom_write_byte(unsigned int address, byte byte_to_write){
+
+  if (EEPROM.read(address) != byte_to_write){
+    EEPROM.write(address, byte_to_write);
+  }
+
+}
+#endif // defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+// --------------------------------------------------------------------------
+#if defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+void correction_table_eeprom_write_long(unsigned int address, long value){
+
+  for (byte x = 0; x < 4; x++){
+    correction_table_eeprom_write_byte(address + x, (byte)(value & 0xff));
+    value = value >> 8;
+  }
+
+}
+#endif // defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+// --------------------------------------------------------------------------
+#if defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+byte correction_table_eeprom_checksum(byte table, byte points){
+
+  unsigned int address = correction_table_eeprom_address(table) + CORRECTION_TABLE_EEPROM_HEADER_SIZE;
+  unsigned int bytes = points * CORRECTION_TABLE_EEPROM_POINT_SIZE;
+  byte checksum = points;
+
+  for (unsigned int x = 0; x < bytes; x++){
+    checksum = checksum + EEPROM.read(address + x);
+  }
+  return checksum;
+
+}
+#endif // defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+// --------------------------------------------------------------------------
+#if defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+byte correction_table_eeprom_valid(byte table){
+
+  // returns
+  // 1 = a table has been loaded into EEPROM with \> and it checks out
+  // 0 = use the compiled in table
+
+  unsigned int address = correction_table_eeprom_address(table);
+  byte points = EEPROM.read(address + 1);
+
+  if ((EEPROM.read(address) != CORRECTION_TABLE_EEPROM_MAGIC) || (points > correction_table_eeprom_max_points(table))){
+    return 0;
+  }
+  return (correction_table_eeprom_checksum(table, points) == EEPROM.read(address + 2));
+
+}
+#endif // defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+// --------------------------------------------------------------------------
+#if defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+byte correction_table_points(byte table, byte in_eeprom){
+
+  if (in_eeprom){
+    return EEPROM.read(correction_table_eeprom_address(table) + 1);
+  }
+
+  // the compiled in table; the _FROM_ and _TO_ arrays have to be the same length
+  #if defined(FEATURE_AZIMUTH_CORRECTION)
+    if (table == CORRECTION_TABLE_AZIMUTH){
+      if (sizeof(azimuth_calibration_from) != sizeof(azimuth_calibration_to)){return 0;}
+      return (byte)min(sizeof(azimuth_calibration_from) / sizeof(azimuth_calibration_from[0]), (size_t)255);
+    }
+  #endif
+  #if defined(FEATURE_ELEVATION_CORRECTION)
+    if (table == CORRECTION_TABLE_ELEVATION){
+      if (sizeof(elevation_calibration_from) != sizeof(elevation_calibration_to)){return 0;}
+      return (byte)min(sizeof(elevation_calibration_from) / sizeof(elevation_calibration_from[0]), (size_t)255);
+    }
+  #endif
+  return 0;
+
+}
+#endif // defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+// --------------------------------------------------------------------------
+#if defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+void correction_table_point(byte table, byte in_eeprom, byte point, long * from_centidegrees, long * to_centidegrees){
+
+  unsigned int address;
+
+  if (in_eeprom){
+    address = correction_table_eeprom_address(table) + CORRECTION_TABLE_EEPROM_HEADER_SIZE + (point * CORRECTION_TABLE_EEPROM_POINT_SIZE);
+    *from_centidegrees = correction_table_eeprom_read_long(address);
+    *to_centidegrees = correction_table_eeprom_read_long(address + 4);
+    return;
+  }
+
+  #if defined(FEATURE_AZIMUTH_CORRECTION)
+    if (table == CORRECTION_TABLE_AZIMUTH){
+      *from_centidegrees = degrees_to_centidegrees(azimuth_calibration_from[point]);
+      *to_centidegrees = degrees_to_centidegrees(azimuth_calibration_to[point]);
+    }
+  #endif
+  #if defined(FEATURE_ELEVATION_CORRECTION)
+    if (table == CORRECTION_TABLE_ELEVATION){
+      *from_centidegrees = degrees_to_centidegrees(elevation_calibration_from[point]);
+      *to_centidegrees = degrees_to_centidegrees(elevation_calibration_to[point]);
+    }
+  #endif
+
+}
+#endif // defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+// --------------------------------------------------------------------------
+#if defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+void build_correction_lut(byte table){
+
+  // resample the calibration table (EEPROM if one's been loaded, otherwise the compiled in arrays) into the lookup table
+
+  struct correction_lut_state * lut = 0;
+  long * lut_to = 0;
+  byte lut_size = 0;
+  byte in_eeprom = correction_table_eeprom_valid(table);
+  byte points = correction_table_points(table, in_eeprom);
+  long from_start, to_start, from_end, to_end;
+  long from_0, to_0, from_1, to_1;
+  long span, x;
+  float interpolated;
+  byte step_shift = 0;
+  byte lut_points;
+  byte segment = 0;
+
+  #if defined(FEATURE_AZIMUTH_CORRECTION)
+    if (table == CORRECTION_TABLE_AZIMUTH){
+      lut = &azimuth_correction_lut;
+      lut_to = azimuth_correction_lut_to;
+      lut_size = AZIMUTH_CORRECTION_LUT_SIZE;
+    }
+  #endif
+  #if defined(FEATURE_ELEVATION_CORRECTION)
+    if (table == CORRECTION_TABLE_ELEVATION){
+      lut = &elevation_correction_lut;
+      lut_to = elevation_correction_lut_to;
+      lut_size = ELEVATION_CORRECTION_LUT_SIZE;
+    }
+  #endif
+  if (!lut){return;}
+
+  lut->points = 0;
+  if ((points < 2) || (lut_size < 2)){return;}
+
+  // the table has to go in order of increasing from degrees, otherwise leave the headings alone
+  correction_table_point(table, in_eeprom, 0, &from_start, &to_start);
+  from_end = from_start;
+  for (byte point = 1; point < points; point++){
+    correction_table_point(table, in_eeprom, point, &x, &to_end);
+    if (x <= from_end){
+      #if defined(DEBUG_EEPROM)
+        debug.print("build_correction_lut: table out of order at point ");
+        debug.println(point);
+      #endif
+      return;
+    }
+    from_end = x;
+  }
+
+  // smallest power of two step that covers the table in lut_size points
+  span = from_end - from_start;
+  while ((((long)(lut_size - 1)) << step_shift) < span){
+    step_shift++;
+  }
+  lut_points = ((span + (1L << step_shift) - 1) >> step_shift) + 1;
+
+  correction_table_point(table, in_eeprom, 0, &from_0, &to_0);
+  correction_table_point(table, in_eeprom, 1, &from_1, &to_1);
+  for (byte lut_point = 0; lut_point < lut_points; lut_point++){
+    x = from_start + ((long)lut_point << step_shift);
+    while ((x > from_1) && (segment < (points - 2))){
+      segment++;
+      from_0 = from_1;
+      to_0 = to_1;
+      correction_table_point(table, in_eeprom, segment + 1, &from_1, &to_1);
+    }
+    // past the end of the table the last point carries on the last segment, so interpolating up to from_end comes out right
+    interpolated = ((float)(x - from_0) / (float)(from_1 - from_0)) * (float)(to_1 - to_0);
+    lut_to[lut_point] = to_0 + (long)((interpolated < 0) ? (interpolated - 0.5) : (interpolated + 0.5));
+  }
+
+  lut->from_start = from_start;
+  lut->from_end = from_end;
+  lut->step_shift = step_shift;
+  lut->points = lut_points;
+
+}
+#endif // defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+// --------------------------------------------------------------------------
+#if defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+void initialize_correction_tables(){
+
+  #if defined(FEATURE_AZIMUTH_CORRECTION)
+    build_correction_lut(CORRECTION_TABLE_AZIMUTH);
+  #endif
+  #if defined(FEATURE_ELEVATION_CORRECTION)
+    build_correction_lut(CORRECTION_TABLE_ELEVATION);
+  #endif
+
+}
+#endif // defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+// --------------------------------------------------------------------------
+#if defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+long correct_centidegrees(struct correction_lut_state * lut, long lut_to[], long centidegrees){
+
+  unsigned long from_start_difference;
+  byte lut_point;
+  long fraction;
+  long difference;
+
+  // outside the table the heading is left alone, as it always has been
+  if ((lut->points < 2) || (centidegrees < lut->from_start) || (centidegrees > lut->from_end)){
+    return centidegrees;
   }
-  if (el_position_pulse_input_elevation > ELEVATION_MAXIMUM_DEGREES) {
-    el_position_pulse_input_elevation = ELEVATION_MAXIMUM_DEGREES;
+
+  from_start_difference = centidegrees - lut->from_start;
+  lut_point = from_start_difference >> lut->step_shift;
+  fraction = from_start_difference & ((1L << lut->step_shift) - 1);
+  if (lut_point >= (lut->points - 1)){  // right on the last point
+    lut_point = lut->points - 2;
+    fraction = 1L << lut->step_shift;
   }
-  #endif // OPTION_EL_POSITION_PULSE_HARD_LIMIT
 
+  difference = lut_to[lut_point + 1] - lut_to[lut_point];
+  if (labs(difference) < (0x7fffffffL >> lut->step_shift)){
+    return lut_to[lut_point] + (((difference * fraction) + ((1L << lut->step_shift) >> 1)) >> lut->step_shift);
+  } else {  // a very steep table
+    return lut_to[lut_point] + (long)((((long long)difference * fraction) + ((1L << lut->step_shift) >> 1)) >> lut->step_shift);
+  }
 
-} /* el_position_pulse_interrupt_handler */
-#endif // FEATURE_EL_POSITION_PULSE_INPUT
-#endif // FEATURE_ELEVATION_CONTROL
-// --------------------------------------------------------------------------
+}
+#endif // defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
 // --------------------------------------------------------------------------
-#ifdef FEATURE_AZIMUTH_CORRECTION
-float correct_azimuth(float azimuth_in){
+#if defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+byte add_correction_table_point(byte table, long from_centidegrees, long to_centidegrees){
+
+  // add a point to the table in EEPROM, keeping it in order, or change the to degrees of a point that's already there
+  // returns
+  // 1 = done
+  // 0 = the table is full
+
+  unsigned int address = correction_table_eeprom_address(table);
+  unsigned int point_address;
+  byte points;
+  byte insert_point = 0;
 
-  if (sizeof(azimuth_calibration_from) != sizeof(azimuth_calibration_to)) {
-    return azimuth_in;
+  if (!correction_table_eeprom_valid(table)){  // start a new table rather than add to the compiled in one
+    clear_correction_table(table, KEEP_EEPROM_CORRECTION_TABLE);
   }
-  for (unsigned int x = 0; x < (sizeof(azimuth_calibration_from) - 2); x++) {
-    if ((azimuth_in >= azimuth_calibration_from[x]) && (azimuth_in <= azimuth_calibration_from[x + 1])) {
-      //return (map(azimuth_in * 10, azimuth_calibration_from[x] * 10, azimuth_calibration_from[x + 1] * 10, azimuth_calibration_to[x] * 10, azimuth_calibration_to[x + 1] * 10)) / 10.0;
-      return (azimuth_in - azimuth_calibration_from[x]) * (azimuth_calibration_to[x+1] - azimuth_calibration_to[x]) / (azimuth_calibration_from[x + 1] - azimuth_calibration_from[x]) + azimuth_calibration_to[x];
+  points = EEPROM.read(address + 1);
+
+  while ((insert_point < points) && (correction_table_eeprom_read_long(address + CORRECTION_TABLE_EEPROM_HEADER_SIZE + (insert_point * CORRECTION_TABLE_EEPROM_POINT_SIZE)) < from_centidegrees)){
+    insert_point++;
+  }
+  point_address = address + CORRECTION_TABLE_EEPROM_HEADER_SIZE + (insert_point * CORRECTION_TABLE_EEPROM_POINT_SIZE);
+
+  if ((insert_point == points) || (correction_table_eeprom_read_long(point_address) != from_centidegrees)){
+    if (points >= correction_table_eeprom_max_points(table)){
+      return 0;
     }
+    // make room; loading the table in order only ever adds on the end
+    for (unsigned int x = (points - insert_point) * CORRECTION_TABLE_EEPROM_POINT_SIZE; x > 0; x--){
+      correction_table_eeprom_write_byte(point_address + CORRECTION_TABLE_EEPROM_POINT_SIZE + x - 1, EEPROM.read(point_address + x - 1));
+    }
+    points++;
   }
-  return(azimuth_in);
+  correction_table_eeprom_write_long(point_address, from_centidegrees);
+  correction_table_eeprom_write_long(point_address + 4, to_centidegrees);
+  correction_table_eeprom_write_byte(address + 1, points);
+  correction_table_eeprom_write_byte(address + 2, correction_table_eeprom_checksum(table, points));
+
+  build_correction_lut(table);
+
+  return 1;
 
 }
-#endif // FEATURE_AZIMUTH_CORRECTION
+#endif // defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
 // --------------------------------------------------------------------------
-#ifdef FEATURE_ELEVATION_CORRECTION
-float correct_elevation(float elevation_in){
+#if defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+void clear_correction_table(byte table, byte revert_to_compiled_table){
+
+  // KEEP_EEPROM_CORRECTION_TABLE = leave an empty table in EEPROM (no correction until it has two points)
+  // REVERT_TO_COMPILED_CORRECTION_TABLE = drop the EEPROM table and go back to AZIMUTH_CALIBRATION_FROM_ARRAY, etc.
 
+  unsigned int address = correction_table_eeprom_address(table);
 
-  if (sizeof(elevation_calibration_from) != sizeof(elevation_calibration_to)) {
-    return elevation_in;
+  if (revert_to_compiled_table){
+    correction_table_eeprom_write_byte(address, 0);
+  } else {
+    correction_table_eeprom_write_byte(address, CORRECTION_TABLE_EEPROM_MAGIC);
+    correction_table_eeprom_write_byte(address + 1, 0);
+    correction_table_eeprom_write_byte(address + 2, correction_table_eeprom_checksum(table, 0));
   }
-  for (int x = 0; x < (sizeof(elevation_calibration_from) - 2); x++) {
-    if ((elevation_in >= elevation_calibration_from[x]) && (elevation_in <= elevation_calibration_from[x + 1])) {
-      // changed this from map() 2015-03-28 due to it blowing up at compile time in Arduino 1.6.1
-      return (elevation_in - elevation_calibration_from[x]) * (elevation_calibration_to[x+1] - elevation_calibration_to[x]) / (elevation_calibration_from[x + 1] - elevation_calibration_from[x]) + elevation_calibration_to[x];
+
+  build_correction_lut(table);
+
+}
+#endif // defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+// --------------------------------------------------------------------------
+#if defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+void print_correction_table(byte table){
+
+  struct correction_lut_state * lut = 0;
+  byte in_eeprom = correction_table_eeprom_valid(table);
+  byte points = correction_table_points(table, in_eeprom);
+  long from_centidegrees, to_centidegrees;
+
+  #if defined(FEATURE_AZIMUTH_CORRECTION)
+    if (table == CORRECTION_TABLE_AZIMUTH){
+      lut = &azimuth_correction_lut;
+      control_port->print(F("Azimuth"));
+    }
+  #endif
+  #if defined(FEATURE_ELEVATION_CORRECTION)
+    if (table == CORRECTION_TABLE_ELEVATION){
+      lut = &elevation_correction_lut;
+      control_port->print(F("Elevation"));
     }
+  #endif
+  control_port->print(F(" calibration table "));
+  if (in_eeprom){
+    control_port->print(F("(EEPROM, "));
+    control_port->print(points);
+    control_port->print(F(" of "));
+    control_port->print(correction_table_eeprom_max_points(table));
+    control_port->println(F(" points):"));
+  } else {
+    control_port->println(F("(compiled in):"));
+  }
+  for (byte point = 0; point < points; point++){
+    correction_table_point(table, in_eeprom, point, &from_centidegrees, &to_centidegrees);
+    control_port->print(F("  "));
+    control_port->print(centidegrees_to_degrees(from_centidegrees), 2);
+    control_port->print(F(" -> "));
+    control_port->println(centidegrees_to_degrees(to_centidegrees), 2);
+  }
+  if (lut->points > 1){
+    control_port->print(F("Lookup table: "));
+    control_port->print(lut->points);
+    control_port->print(F(" points, "));
+    control_port->print(centidegrees_to_degrees(1L << lut->step_shift), 2);
+    control_port->println(F(" degree steps"));
+  } else {
+    control_port->println(F("No correction"));
   }
 
-  return(elevation_in);
+}
+#endif // defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+// --------------------------------------------------------------------------
+#if defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+byte parse_correction_table_point(byte input_buffer[], int input_buffer_index, long * from_centidegrees, long * to_centidegrees){
+
+  // \>Axxx[.xx] yyy[.yy] - parse the from and to degrees starting at input_buffer[3]
+  // returns
+  // 1 = good
+  // 0 = bad format
+
+  long value[2] = {0, 0};
+  byte number = 0;
+  byte digits = 0;
+  byte decimal_places = 0;
+  byte hit_decimal = 0;
+  byte negative = 0;
+
+  for (int x = 3; x <= input_buffer_index; x++){
+    if ((x == input_buffer_index) || (input_buffer[x] == ' ')){
+      if (digits == 0){return 0;}
+      while (decimal_places < 2){
+        value[number] = value[number] * 10;
+        decimal_places++;
+      }
+      if (negative){value[number] = -value[number];}
+      number++;
+      if ((number == 2) != (x == input_buffer_index)){return 0;}  // two numbers, no more, no less
+      digits = 0;
+      decimal_places = 0;
+      hit_decimal = 0;
+      negative = 0;
+    } else if ((input_buffer[x] == '-') && (digits == 0) && (!negative) && (!hit_decimal)){
+      negative = 1;
+    } else if ((input_buffer[x] == '.') && (!hit_decimal)){
+      hit_decimal = 1;
+    } else if ((input_buffer[x] >= '0') && (input_buffer[x] <= '9') && (digits < 6) && (decimal_places < 2)){
+      value[number] = (value[number] * 10) + (input_buffer[x] - 48);
+      digits++;
+      if (hit_decimal){decimal_places++;}
+    } else {
+      return 0;
+    }
+  }
 
+  *from_centidegrees = value[0];
+  *to_centidegrees = value[1];
+  return 1;
 
 }
-#endif // FEATURE_ELEVATION_CORRECTION
+#endif // defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
 // --------------------------------------------------------------------------
 #ifdef FEATURE_JOYSTICK_CONTROL
 void check_joystick(){
@@ -13188,47 +15708,67 @@ void check_limit_sense(){
 } /* check_limit_sense */
 #endif // FEATURE_LIMIT_SENSE
 
+// --------------------------------------------------------------
+#if defined(FEATURE_AZ_POSITION_INCREMENTAL_ENCODER) || defined(FEATURE_EL_POSITION_INCREMENTAL_ENCODER)
+void initialize_incremental_encoder_pins(struct incremental_encoder_pins &pins, uint8_t phase_a_pin, uint8_t phase_b_pin, uint8_t phase_z_pin){
+
+  #if defined(__AVR__)
+    pins.phase_a_register = portInputRegister(digitalPinToPort(phase_a_pin));
+    pins.phase_b_register = portInputRegister(digitalPinToPort(phase_b_pin));
+    pins.phase_z_register = portInputRegister(digitalPinToPort(phase_z_pin));
+    pins.phase_a_mask = digitalPinToBitMask(phase_a_pin);
+    pins.phase_b_mask = digitalPinToBitMask(phase_b_pin);
+    pins.phase_z_mask = digitalPinToBitMask(phase_z_pin);
+  #else
+    pins.phase_a_pin = phase_a_pin;
+    pins.phase_b_pin = phase_b_pin;
+    pins.phase_z_pin = phase_z_pin;
+  #endif
+
+}
+#endif // defined(FEATURE_AZ_POSITION_INCREMENTAL_ENCODER) || defined(FEATURE_EL_POSITION_INCREMENTAL_ENCODER)
+// --------------------------------------------------------------
+#if defined(FEATURE_AZ_POSITION_INCREMENTAL_ENCODER) || defined(FEATURE_EL_POSITION_INCREMENTAL_ENCODER)
+byte read_incremental_encoder_phases(struct incremental_encoder_pins &pins){
+
+  // returns the pin levels as INCREMENTAL_ENCODER_PHASE_A | INCREMENTAL_ENCODER_PHASE_B | INCREMENTAL_ENCODER_PHASE_Z bits, 1 = HIGH
+
+  byte phases = 0;
+
+  #if defined(__AVR__)
+    if (*pins.phase_a_register & pins.phase_a_mask){phases |= INCREMENTAL_ENCODER_PHASE_A;}
+    if (*pins.phase_b_register & pins.phase_b_mask){phases |= INCREMENTAL_ENCODER_PHASE_B;}
+    if (*pins.phase_z_register & pins.phase_z_mask){phases |= INCREMENTAL_ENCODER_PHASE_Z;}
+  #else
+    if (digitalRead(pins.phase_a_pin)){phases |= INCREMENTAL_ENCODER_PHASE_A;}
+    if (digitalRead(pins.phase_b_pin)){phases |= INCREMENTAL_ENCODER_PHASE_B;}
+    if (digitalRead(pins.phase_z_pin)){phases |= INCREMENTAL_ENCODER_PHASE_Z;}
+  #endif
+
+  return phases;
+
+}
+#endif // defined(FEATURE_AZ_POSITION_INCREMENTAL_ENCODER) || defined(FEATURE_EL_POSITION_INCREMENTAL_ENCODER)
 // --------------------------------------------------------------
 #ifdef FEATURE_AZ_POSITION_INCREMENTAL_ENCODER
 void az_position_incremental_encoder_interrupt_handler(){
 
-  byte rotation_result = 0;
-  byte current_phase_a = digitalReadEnhanced(az_incremental_encoder_pin_phase_a);
-  byte current_phase_b = digitalReadEnhanced(az_incremental_encoder_pin_phase_b);
-  byte current_phase_z = digitalReadEnhanced(az_incremental_encoder_pin_phase_z);
+  // count only; read_headings() turns the count into a heading and service_rotation() acts on it, out in the main loop
+
+  byte phases = read_incremental_encoder_phases(az_incremental_encoder_pins);
+  signed char transition = incremental_encoder_transition[(az_incremental_encoder_last_phases << 2) | (phases & INCREMENTAL_ENCODER_PHASES_AB)];
 
   #ifdef DEBUG_AZ_POSITION_INCREMENTAL_ENCODER
     az_position_incremental_encoder_interrupt++;
   #endif // DEBUG_AZ_POSITION_INCREMENTAL_ENCODER
 
-  if ((az_3_phase_encoder_last_phase_a_state != current_phase_a) || (az_3_phase_encoder_last_phase_b_state != current_phase_b)) {
-    if (az_3_phase_encoder_last_phase_a_state == LOW) {
-      rotation_result++;
-    }
-    rotation_result = rotation_result << 1;
-    if (az_3_phase_encoder_last_phase_b_state == LOW) {
-      rotation_result++;
-    }
-    rotation_result = rotation_result << 1;
-    if (current_phase_a == LOW) {
-      rotation_result++;
-    }
-    rotation_result = rotation_result << 1;
-    if (current_phase_b == LOW) {
-      rotation_result++;
-    }
-    switch (rotation_result) {
-      case B0010: //az_incremental_encoder_position++; break;
-      case B1011: //az_incremental_encoder_position++; break;
-      case B1101: //az_incremental_encoder_position++; break;
-      case B0100: az_incremental_encoder_position++; break;
-
-      case B0001: //az_incremental_encoder_position--; break;
-      case B0111: //az_incremental_encoder_position--; break;
-      case B1110: //az_incremental_encoder_position--; break;
-      case B1000: az_incremental_encoder_position--; break;
-    }
+  if (transition == 0){return;}
 
+  if (transition == INCREMENTAL_ENCODER_MISSED_TRANSITION){
+    az_incremental_encoder_missed_transitions++;
+  } else {
+    az_incremental_encoder_position = az_incremental_encoder_position + transition;
+  }
 
   if (az_incremental_encoder_position > ((long(AZ_POSITION_INCREMENTAL_ENCODER_PULSES_PER_REV*4.) - 1) * 2)) {
     az_incremental_encoder_position = 0;
@@ -13238,35 +15778,19 @@ void az_position_incremental_encoder_interrupt_handler(){
   }
 
   #ifndef OPTION_SCANCON_2RMHF3600_INC_ENCODER
-    if ((current_phase_a == LOW) && (current_phase_b == LOW) && (current_phase_z == LOW)) {
-      if ((az_incremental_encoder_position < long((AZ_POSITION_INCREMENTAL_ENCODER_PULSES_PER_REV*4.) / 2)) || (az_incremental_encoder_position > long((AZ_POSITION_INCREMENTAL_ENCODER_PULSES_PER_REV*4.) * 1.5))) {
-        az_incremental_encoder_position = AZ_INCREMENTAL_ENCODER_ZERO_PULSE_POSITION;
-      } else {
-        az_incremental_encoder_position = long(AZ_POSITION_INCREMENTAL_ENCODER_PULSES_PER_REV*4.);
-      }
-    }
+    if (phases == 0) {  // A, B, and Z all LOW
   #else
-    if ((current_phase_a == HIGH) && (current_phase_b == HIGH) && (current_phase_z == HIGH)) {
+    if (phases == (INCREMENTAL_ENCODER_PHASES_AB | INCREMENTAL_ENCODER_PHASE_Z)) {  // A, B, and Z all HIGH
+  #endif //OPTION_SCANCON_2RMHF3600_INC_ENCODER
       if ((az_incremental_encoder_position < long((AZ_POSITION_INCREMENTAL_ENCODER_PULSES_PER_REV*4.) / 2)) || (az_incremental_encoder_position > long((AZ_POSITION_INCREMENTAL_ENCODER_PULSES_PER_REV*4.) * 1.5))) {
         az_incremental_encoder_position = AZ_INCREMENTAL_ENCODER_ZERO_PULSE_POSITION;
       } else {
         az_incremental_encoder_position = long(AZ_POSITION_INCREMENTAL_ENCODER_PULSES_PER_REV*4.);
       }
     }
-  #endif //OPTION_SCANCON_2RMHF3600_INC_ENCODER      
-  az_3_phase_encoder_last_phase_a_state = current_phase_a;
-  az_3_phase_encoder_last_phase_b_state = current_phase_b;
-
-  }
-
-  if (!read_azimuth_lock){
-    read_azimuth(1);
-    if(!service_rotation_lock){
-      service_rotation();
-    }
-  }
-  
 
+  az_incremental_encoder_last_phases = phases & INCREMENTAL_ENCODER_PHASES_AB;
+  az_incremental_encoder_moved = 1;
 
 } /* az_position_incremental_encoder_interrupt_handler */
 #endif // FEATURE_AZ_POSITION_INCREMENTAL_ENCODER
@@ -13275,90 +15799,43 @@ void az_position_incremental_encoder_interrupt_handler(){
 #if defined(FEATURE_EL_POSITION_INCREMENTAL_ENCODER) && defined(FEATURE_ELEVATION_CONTROL)
 void el_position_incremental_encoder_interrupt_handler(){
 
-  byte rotation_result = 0;
-  byte current_phase_a = digitalReadEnhanced(el_incremental_encoder_pin_phase_a);
-  byte current_phase_b = digitalReadEnhanced(el_incremental_encoder_pin_phase_b);
-  byte current_phase_z = digitalReadEnhanced(el_incremental_encoder_pin_phase_z);
+  // count only; read_headings() turns the count into a heading and service_rotation() acts on it, out in the main loop
+
+  byte phases = read_incremental_encoder_phases(el_incremental_encoder_pins);
+  signed char transition = incremental_encoder_transition[(el_incremental_encoder_last_phases << 2) | (phases & INCREMENTAL_ENCODER_PHASES_AB)];
 
   #ifdef DEBUG_EL_POSITION_INCREMENTAL_ENCODER
     el_position_incremental_encoder_interrupt++;
   #endif // DEBUG_EL_POSITION_INCREMENTAL_ENCODER
 
-  if ((el_3_phase_encoder_last_phase_a_state != current_phase_a) || (el_3_phase_encoder_last_phase_b_state != current_phase_b)) {
-    if (el_3_phase_encoder_last_phase_a_state == LOW) {
-      rotation_result++;
-    }
-    rotation_result = rotation_result << 1;
-    if (el_3_phase_encoder_last_phase_b_state == LOW) {
-      rotation_result++;
-    }
-    rotation_result = rotation_result << 1;
-    if (current_phase_a == LOW) {
-      rotation_result++;
-    }
-    rotation_result = rotation_result << 1;
-    if (current_phase_b == LOW) {
-      rotation_result++;
-    }
-    switch (rotation_result) {
-      case B0010: //el_incremental_encoder_position++; break;
-      case B1011: //el_incremental_encoder_position++; break;
-      case B1101: //el_incremental_encoder_position++; break;
-      case B0100: el_incremental_encoder_position++; break;
-
-      case B0001: //el_incremental_encoder_position--; break;
-      case B0111: //el_incremental_encoder_position--; break;
-      case B1110: //el_incremental_encoder_position--; break;
-      case B1000: el_incremental_encoder_position--; break;
-    }
-
-    
-
-    #ifndef OPTION_SCANCON_2RMHF3600_INC_ENCODER
-      if ((current_phase_a == LOW) && (current_phase_b == LOW) && (current_phase_z == LOW)) {
-        el_incremental_encoder_position = EL_INCREMENTAL_ENCODER_ZERO_PULSE_POSITION;
-      } else {
-
-        if (el_incremental_encoder_position < 0) {
-          el_incremental_encoder_position = (long(EL_POSITION_INCREMENTAL_ENCODER_PULSES_PER_REV*4.) - 1L);
-        }
-
-        if (el_incremental_encoder_position >= long(EL_POSITION_INCREMENTAL_ENCODER_PULSES_PER_REV*4.)) {
-          el_incremental_encoder_position = 0;
-        }  
-
-      } 
-    #else
-      if ((current_phase_a == HIGH) && (current_phase_b == HIGH) && (current_phase_z == HIGH)) {
-        el_incremental_encoder_position = EL_INCREMENTAL_ENCODER_ZERO_PULSE_POSITION;
-      } else {
-        if (el_incremental_encoder_position < 0) {
-          el_incremental_encoder_position = (long(EL_POSITION_INCREMENTAL_ENCODER_PULSES_PER_REV*4L) - 1L);
-        }
-        if (el_incremental_encoder_position >= long(EL_POSITION_INCREMENTAL_ENCODER_PULSES_PER_REV*4L)) {
-          el_incremental_encoder_position = 0;
-        }  
-      } 
-    #endif //OPTION_SCANCON_2RMHF3600_INC_ENCODER
-
-  
-
-
-    el_3_phase_encoder_last_phase_a_state = current_phase_a;
-    el_3_phase_encoder_last_phase_b_state = current_phase_b;
+  if (transition == 0){return;}
 
+  if (transition == INCREMENTAL_ENCODER_MISSED_TRANSITION){
+    el_incremental_encoder_missed_transitions++;
+  } else {
+    el_incremental_encoder_position = el_incremental_encoder_position + transition;
   }
 
-  if (!read_elevation_lock){
-    read_elevation(1);
-    if(!service_rotation_lock){
-      service_rotation();
-    }
-  }
+  #ifndef OPTION_SCANCON_2RMHF3600_INC_ENCODER
+    if (phases == 0) {  // A, B, and Z all LOW
+  #else
+    if (phases == (INCREMENTAL_ENCODER_PHASES_AB | INCREMENTAL_ENCODER_PHASE_Z)) {  // A, B, and Z all HIGH
+  #endif //OPTION_SCANCON_2RMHF3600_INC_ENCODER
+      el_incremental_encoder_position = EL_INCREMENTAL_ENCODER_ZERO_PULSE_POSITION;
+    } else {
+      if (el_incremental_encoder_position < 0) {
+        el_incremental_encoder_position = (long(EL_POSITION_INCREMENTAL_ENCODER_PULSES_PER_REV*4.) - 1L);
+      }
+      if (el_incremental_encoder_position >= long(EL_POSITION_INCREMENTAL_ENCODER_PULSES_PER_REV*4.)) {
+        el_incremental_encoder_position = 0;
+      }  
+    } 
 
+  el_incremental_encoder_last_phases = phases & INCREMENTAL_ENCODER_PHASES_AB;
+  el_incremental_encoder_moved = 1;
 
 } /* el_position_incremental_encoder_interrupt_handler */
-  #endif // defined(FEATURE_EL_POSITION_INCREMENTAL_ENCODER) && defined(FEATURE_ELEVATION_CONTROL)
+#endif // defined(FEATURE_EL_POSITION_INCREMENTAL_ENCODER) && defined(FEATURE_ELEVATION_CONTROL)
 
 // --------------------------------------------------------------
 
@@ -13411,9 +15888,28 @@ int analogReadEnhanced(uint8_t pin){
     analogReadResolution(12);
   #endif
 
+  #ifdef FEATURE_ADC_RESOLUTION14
+    analogReadResolution(14);
+  #endif
+
   #ifdef OPTION_EXTERNAL_ANALOG_REFERENCE
     analogReference(EXTERNAL);
   #endif //OPTION_EXTERNAL_ANALOG_REFERENCE
+
+  #if defined(OPTION_POTENTIOMETER_ADC_OVERSAMPLING) && (defined(FEATURE_AZ_POSITION_POTENTIOMETER) || defined(FEATURE_EL_POSITION_POTENTIOMETER)) && defined(__AVR__)
+    // the ADC interrupt is busy sampling the pots; hold it off for this conversion
+    if (potentiometer_sampler_running){
+      int analog_read;
+      potentiometer_sampler_running = 0;
+      ADCSRA &= ~(1 << ADIE);
+      while (ADCSRA & (1 << ADSC)){}
+      analog_read = analogRead(pin);
+      potentiometer_sampler_running = 1;
+      potentiometer_sampler_start_conversion();
+      return analog_read;
+    }
+  #endif
+
   return analogRead(pin);
 
 }
@@ -13733,19 +16229,6 @@ void update_sun_position(){
   c_time.dSeconds = current_clock.seconds;
 
 
-  #else //OPTION_USE_OLD_TIME_CODE
-  time_t temp_t = now();
-
-  c_time.iYear = year(temp_t);
-  c_time.iMonth = month(temp_t);
-  c_time.iDay = day(temp_t);
-
-  c_time.dHours = hour(temp_t);
-  c_time.dMinutes = minute(temp_t);
-  c_time.dSeconds = second(temp_t);
-
-  #endif //OPTION_USE_OLD_TIME_CODE
-
   c_loc.dLongitude = longitude;
   c_loc.dLatitude  = latitude;
 
@@ -13758,6 +16241,16 @@ void update_sun_position(){
   sun_elevation = 90. - c_sposn.dZenithAngle;
   sun_azimuth = c_sposn.dAzimuth;
 
+  #else //OPTION_USE_OLD_TIME_CODE
+
+  double position_azimuth, position_elevation;
+
+  sun_position_at(astro_now.epoch, position_azimuth, position_elevation);
+  sun_elevation = position_elevation;
+  sun_azimuth = position_azimuth;
+
+  #endif //OPTION_USE_OLD_TIME_CODE
+
 
   #ifdef DEBUG_PROCESSES
     service_process_debug(DEBUG_PROCESSES_PROCESS_EXIT,PROCESS_UPDATE_SUN_POSITION);
@@ -13765,6 +16258,39 @@ void update_sun_position(){
 
 } /* update_sun_position */
 #endif // FEATURE_SUN_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SUN_TRACKING) && !defined(OPTION_USE_OLD_TIME_CODE)
+byte sun_position_at(time_t when, double &position_azimuth, double &position_elevation){
+
+  return ephemeris_cache_position(sun_ephemeris, sun_position_calculated_at, when, position_azimuth, position_elevation);
+
+}
+#endif // FEATURE_SUN_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_SUN_TRACKING) && !defined(OPTION_USE_OLD_TIME_CODE)
+byte sun_position_calculated_at(time_t when, double &position_azimuth, double &position_elevation){
+
+  // the full sunpos() calculation; sun_position_at() gets it from the daily fit instead
+
+  astro_time& position_time = astro_time_at(when);
+  cLocation position_location;
+  cSunCoordinates position_sun;
+
+  position_location.dLongitude = longitude;
+  position_location.dLatitude = latitude;
+
+  position_sun.dZenithAngle = 0;
+  position_sun.dAzimuth = 0;
+
+  sunpos_elapsed(((double)(position_time.julian_day - 2451545L) - 0.5) + position_time.day_fraction, position_time.lst * DEG_TO_RAD, position_location, &position_sun);
+
+  position_elevation = 90. - position_sun.dZenithAngle;
+  position_azimuth = position_sun.dAzimuth;
+
+  return 1;
+
+}
+#endif // FEATURE_SUN_TRACKING
 
 // --------------------------------------------------------------
 
@@ -13777,28 +16303,375 @@ void update_sun_position(){
       control_port->flush();
     #endif // DEBUG_LOOP     
 
-    #ifdef DEBUG_PROCESSES
-      service_process_debug(DEBUG_PROCESSES_PROCESS_ENTER,PROCESS_UPDATE_MOON_POSITION);
-    #endif      
+    #ifdef DEBUG_PROCESSES
+      service_process_debug(DEBUG_PROCESSES_PROCESS_ENTER,PROCESS_UPDATE_MOON_POSITION);
+    #endif      
+
+
+
+    double RA, Dec, topRA, topDec, LST, HA, dist;
+
+    #if defined(OPTION_USE_OLD_TIME_CODE)
+    moon2(current_clock.year, current_clock.month, current_clock.day, (current_clock.hours + (current_clock.minutes / 60.0) + (current_clock.seconds / 3600.0)), longitude, latitude, &RA, &Dec, &topRA, &topDec, &LST, &HA, &moon_azimuth, &moon_elevation, &dist);
+    #else
+    moon_position_at(astro_now.epoch, moon_azimuth, moon_elevation);
+    #endif
+
+    #ifdef DEBUG_PROCESSES
+      service_process_debug(DEBUG_PROCESSES_PROCESS_EXIT,PROCESS_UPDATE_MOON_POSITION);
+    #endif      
+
+
+  }
+#endif // FEATURE_MOON_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_MOON_TRACKING) && !defined(OPTION_USE_OLD_TIME_CODE)
+  byte moon_position_at(time_t when, double &position_azimuth, double &position_elevation){
+
+    return ephemeris_cache_position(moon_ephemeris, moon_position_calculated_at, when, position_azimuth, position_elevation);
+
+  }
+#endif // FEATURE_MOON_TRACKING
+// --------------------------------------------------------------
+#if defined(FEATURE_MOON_TRACKING) && !defined(OPTION_USE_OLD_TIME_CODE)
+  byte moon_position_calculated_at(time_t when, double &position_azimuth, double &position_elevation){
+
+    // the full moon2() calculation; moon_position_at() gets it from the daily fit instead
+
+    double RA, Dec, topRA, topDec, HA, dist;
+    astro_time& position_time = astro_time_at(when);
+
+    moon2_days((double)(position_time.julian_day - 2451544L) + position_time.day_fraction, position_time.lst / 15.0, latitude, &RA, &Dec, &topRA, &topDec, &HA, &position_azimuth, &position_elevation, &dist);
+
+    return 1;
+
+  }
+#endif // FEATURE_MOON_TRACKING
+// --------------------------------------------------------------
+#if (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING) || defined(FEATURE_SATELLITE_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
+void set_astro_time(astro_time &time_to_set, time_t when){
+
+  // straight from the seconds, no calendar.  1970-01-01 is Julian day 2440588.
+  // GMST = 280.46061837 + 360.98564736629 * (JD - 2451545.0) degrees, with the whole days done as
+  // days - (0.01435263371 * days) so it holds up where double is only float
+
+  long days = when / 86400L;
+  long days_from_j2000 = days + 2440588L - 2451545L;    // to noon of this UTC date
+
+  time_to_set.epoch = when;
+  time_to_set.julian_day = days + 2440588L;
+  time_to_set.day_fraction = (when % 86400L) / 86400.0;
+  time_to_set.gmst = (days_from_j2000 % 360L) - (0.01435263371 * days_from_j2000) + 280.46061837 - 180.49282368 + (360.98564736629 * time_to_set.day_fraction);
+  time_to_set.gmst = fmod(time_to_set.gmst,360.0);
+  if (time_to_set.gmst < 0){time_to_set.gmst = time_to_set.gmst + 360.0;}
+  time_to_set.lst = fmod(time_to_set.gmst + longitude + 360.0,360.0);
+  time_to_set.lst_longitude = longitude;
+
+}
+#endif // (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING) || defined(FEATURE_SATELLITE_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
+// --------------------------------------------------------------
+#if (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING) || defined(FEATURE_SATELLITE_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
+void update_astro_time(){
+
+  time_t time_now = now();
+
+  if ((time_now != astro_now.epoch) || (astro_now.lst_longitude != longitude)){
+    set_astro_time(astro_now, time_now);
+  }
+
+}
+#endif // (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING) || defined(FEATURE_SATELLITE_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
+// --------------------------------------------------------------
+#if (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING) || defined(FEATURE_SATELLITE_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
+astro_time& astro_time_at(time_t when){
+
+  // astro_now if it's for right now, otherwise worked out for when
+
+  static astro_time other_time;
+
+  if ((when == astro_now.epoch) && (astro_now.lst_longitude == longitude)){return astro_now;}
+  set_astro_time(other_time, when);
+  return other_time;
+
+}
+#endif // (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING) || defined(FEATURE_SATELLITE_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
+// --------------------------------------------------------------
+#if (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
+byte ephemeris_cache_position(ephemeris_cache &cache, byte (*position_calculated_at)(time_t, double&, double&), time_t when, double &position_azimuth, double &position_elevation){
+
+  // az and el of the sun or moon from the daily Chebyshev fit in cache, refitting it from position_calculated_at() first
+  // if when is outside the day it covers or the observer has moved.  The direction unit vector is fitted rather than
+  // az and el, so the fit doesn't care about the azimuth wrapping around or the sun or moon passing near the zenith.
+
+  double x, east, north, up;
+
+  if ((cache.start == 0) || (when < cache.start) || ((when - cache.start) >= EPHEMERIS_CACHE_SPAN_SECS) || (observer_moved_from(cache.latitude, cache.longitude))){
+    fit_ephemeris_cache(cache, position_calculated_at, when - (when % 86400L));
+  }
+
+  x = ((2.0 * (when - cache.start)) / EPHEMERIS_CACHE_SPAN_SECS) - 1.0;
+  east = chebyshev_sum(cache.east, x);
+  north = chebyshev_sum(cache.north, x);
+  up = chebyshev_sum(cache.up, x);
+
+  position_azimuth = atan2(east,north) * RAD_TO_DEG;
+  if (position_azimuth < 0){position_azimuth = position_azimuth + 360.0;}
+  position_elevation = atan2(up,sqrt((east * east) + (north * north))) * RAD_TO_DEG;
+
+  return 1;
+
+}
+#endif // (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
+// --------------------------------------------------------------
+#if (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
+void fit_ephemeris_cache(ephemeris_cache &cache, byte (*position_calculated_at)(time_t, double&, double&), time_t start){
+
+  // sample the position at the Chebyshev nodes across start to start + EPHEMERIS_CACHE_SPAN_SECS and work out the
+  // coefficients; EPHEMERIS_CACHE_TERMS full calculations once a day.  The node times get rounded to the second, which
+  // is a few thousandths of a degree at the most.
+
+  double node_azimuth, node_elevation, angle, weight;
+  float node_east[EPHEMERIS_CACHE_TERMS];
+  float node_north[EPHEMERIS_CACHE_TERMS];
+  float node_up[EPHEMERIS_CACHE_TERMS];
+
+  for (int node = 0; node < EPHEMERIS_CACHE_TERMS; node++){
+    angle = (PI * (node + 0.5)) / EPHEMERIS_CACHE_TERMS;
+    position_calculated_at(start + (time_t)(((cos(angle) + 1.0) * EPHEMERIS_CACHE_SPAN_SECS / 2.0) + 0.5), node_azimuth, node_elevation);
+    node_east[node] = cos(node_elevation * DEG_TO_RAD) * sin(node_azimuth * DEG_TO_RAD);
+    node_north[node] = cos(node_elevation * DEG_TO_RAD) * cos(node_azimuth * DEG_TO_RAD);
+    node_up[node] = sin(node_elevation * DEG_TO_RAD);
+  }
+
+  for (int term = 0; term < EPHEMERIS_CACHE_TERMS; term++){
+    cache.east[term] = 0;
+    cache.north[term] = 0;
+    cache.up[term] = 0;
+    for (int node = 0; node < EPHEMERIS_CACHE_TERMS; node++){
+      weight = cos((PI * term * (node + 0.5)) / EPHEMERIS_CACHE_TERMS);
+      cache.east[term] = cache.east[term] + (node_east[node] * weight);
+      cache.north[term] = cache.north[term] + (node_north[node] * weight);
+      cache.up[term] = cache.up[term] + (node_up[node] * weight);
+    }
+    weight = (term == 0) ? (1.0 / EPHEMERIS_CACHE_TERMS) : (2.0 / EPHEMERIS_CACHE_TERMS);  // first term is halved
+    cache.east[term] = cache.east[term] * weight;
+    cache.north[term] = cache.north[term] * weight;
+    cache.up[term] = cache.up[term] * weight;
+  }
+
+  cache.start = start;
+  cache.latitude = latitude;
+  cache.longitude = longitude;
+
+}
+#endif // (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
+// --------------------------------------------------------------
+#if (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
+double chebyshev_sum(float coefficients[], double x){
+
+  // Clenshaw's recurrence, x from -1 to 1
+
+  double b1 = 0;
+  double b2 = 0;
+  double temp;
+
+  for (int term = EPHEMERIS_CACHE_TERMS - 1; term > 0; term--){
+    temp = (2.0 * x * b1) - b2 + coefficients[term];
+    b2 = b1;
+    b1 = temp;
+  }
+
+  return (x * b1) - b2 + coefficients[0];
+
+}
+#endif // (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
+// --------------------------------------------------------------
+#if (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
+byte observer_moved_from(double fit_latitude, double fit_longitude){
+
+  // has the observer moved far enough from where a fit or search was made to be worth redoing it?  With
+  // SYNC_COORDINATES_WITH_GPS, latitude and longitude get rewritten with every fix and wander in the last digits.
+
+  if ((fabs(latitude - fit_latitude) > OBSERVER_MOVED_TOLERANCE_DEGREES) || (fabs(longitude - fit_longitude) > OBSERVER_MOVED_TOLERANCE_DEGREES)){
+    return 1;
+  }
+  return 0;
+
+}
+#endif // (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
+// --------------------------------------------------------------
+#if (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
+void service_sun_moon_events(sun_moon_events &events, byte (*position_calculated_at)(time_t, double&, double&), float elevation_minimum){
+
+  // Find the next rise, set, and transit of the sun or moon, one position calculation per call (two while narrowing
+  // down a transit) so it doesn't hold up loop().  The elevation is stepped SUN_MOON_EVENT_SEARCH_STEP_SECS at a time
+  // out to SUN_MOON_EVENT_SEARCH_HOURS, and each time the elevation minimum is crossed, or the elevation stops going up,
+  // the step is bisected down to the second (transit to SUN_MOON_EVENT_TRANSIT_RESOLUTION_SECS).  The search starts
+  // over when one of the events has gone by, the observer moves, or the events are no longer known 24 hours ahead.
+
+  double position_azimuth, position_elevation, elevation_before;
+  time_t time_now = astro_now.epoch;
+  time_t middle;
+
+  if ((events.search_start == 0) || (time_now < events.search_start) || (observer_moved_from(events.latitude, events.longitude)) ||
+    ((events.rise) && (events.rise <= time_now)) || ((events.set) && (events.set <= time_now)) || ((events.transit) && (events.transit <= time_now)) ||
+    ((time_now - events.search_start) >= ((SUN_MOON_EVENT_SEARCH_HOURS - 24) * 3600L))){
+    position_calculated_at(time_now, position_azimuth, position_elevation);
+    events.rise = 0;
+    events.set = 0;
+    events.transit = 0;
+    events.transit_elevation = 0;
+    events.search_start = time_now;
+    events.search_time = time_now;
+    events.bisect_event = SUN_MOON_EVENT_NONE;
+    events.complete = 0;
+    events.last_elevation = position_elevation;
+    events.last_slope = 0;
+    events.latitude = latitude;
+    events.longitude = longitude;
+    return;
+  }
+
+  if (events.complete){return;}
+
+  switch(events.bisect_event){
+    case SUN_MOON_EVENT_NONE:
+      if (((events.search_time - events.search_start) >= (SUN_MOON_EVENT_SEARCH_HOURS * 3600L)) || ((events.rise) && (events.set) && (events.transit))){
+        events.complete = 1;
+        return;
+      }
+      position_calculated_at(events.search_time + SUN_MOON_EVENT_SEARCH_STEP_SECS, position_azimuth, position_elevation);
+      if ((!events.rise) && (events.last_elevation < elevation_minimum) && (position_elevation >= elevation_minimum)){
+        events.bisect_event = SUN_MOON_EVENT_RISE;
+      } else if ((!events.set) && (events.last_elevation >= elevation_minimum) && (position_elevation < elevation_minimum)){
+        events.bisect_event = SUN_MOON_EVENT_SET;
+      } else if ((!events.transit) && (events.last_slope > 0) && ((position_elevation - events.last_elevation) <= 0)){
+        events.bisect_event = SUN_MOON_EVENT_TRANSIT;
+      }
+      if (events.bisect_event == SUN_MOON_EVENT_NONE){
+        events.last_slope = position_elevation - events.last_elevation;
+        events.last_elevation = position_elevation;
+        events.search_time = events.search_time + SUN_MOON_EVENT_SEARCH_STEP_SECS;
+      } else {  // this step gets done over once the event is pinned down, in case there's another one in it
+        events.bisect_low = events.search_time;
+        events.bisect_high = events.search_time + SUN_MOON_EVENT_SEARCH_STEP_SECS;
+        if (events.bisect_event == SUN_MOON_EVENT_TRANSIT){events.bisect_low = events.bisect_low - SUN_MOON_EVENT_SEARCH_STEP_SECS;}
+      }
+      break;
+    case SUN_MOON_EVENT_RISE:
+    case SUN_MOON_EVENT_SET:
+      middle = events.bisect_low + ((events.bisect_high - events.bisect_low) / 2);
+      position_calculated_at(middle, position_azimuth, position_elevation);
+      if ((position_elevation >= elevation_minimum) == (events.bisect_event == SUN_MOON_EVENT_RISE)){
+        events.bisect_high = middle;
+      } else {
+        events.bisect_low = middle;
+      }
+      if ((events.bisect_high - events.bisect_low) <= 1){
+        if (events.bisect_event == SUN_MOON_EVENT_RISE){
+          events.rise = events.bisect_high;
+        } else {
+          events.set = events.bisect_high;
+        }
+        events.bisect_event = SUN_MOON_EVENT_NONE;
+      }
+      break;
+    case SUN_MOON_EVENT_TRANSIT:
+      middle = events.bisect_low + ((events.bisect_high - events.bisect_low) / 2);
+      if ((events.bisect_high - events.bisect_low) <= SUN_MOON_EVENT_TRANSIT_RESOLUTION_SECS){
+        position_calculated_at(middle, position_azimuth, position_elevation);
+        events.transit = middle;
+        events.transit_elevation = position_elevation;
+        events.bisect_event = SUN_MOON_EVENT_NONE;
+        break;
+      }
+      position_calculated_at(middle - (SUN_MOON_EVENT_TRANSIT_RESOLUTION_SECS / 2), position_azimuth, elevation_before);
+      position_calculated_at(middle + (SUN_MOON_EVENT_TRANSIT_RESOLUTION_SECS / 2), position_azimuth, position_elevation);
+      if (position_elevation > elevation_before){  // still going up
+        events.bisect_low = middle;
+      } else {
+        events.bisect_high = middle;
+      }
+      break;
+  }
+
+}
+#endif // (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
+// --------------------------------------------------------------
+#if (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
+byte sun_moon_waiting_for_rise(sun_moon_events &events, double elevation_now, float elevation_minimum){
+
+  // returns
+  // 1 = below the elevation minimum and the search says it won't be up before events.rise (or at all in the search window)
+  // 0 = up, or the search isn't done
 
+  if (!events.complete){return 0;}
+  if (events.rise){
+    return ((events.set == 0) || (events.rise < events.set));
+  }
+  if (events.set){return 0;}
+  return (elevation_now < elevation_minimum);
 
+}
+#endif // (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
+// --------------------------------------------------------------
+#if (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
+char* sun_moon_event_string(time_t event_time){
 
-    double RA, Dec, topRA, topDec, LST, HA, dist;
+  // "YYYY-MM-DD HH:MM" UTC, or an empty string if there's no event
 
-    #if defined(OPTION_USE_OLD_TIME_CODE)
-    moon2(current_clock.year, current_clock.month, current_clock.day, (current_clock.hours + (current_clock.minutes / 60.0) + (current_clock.seconds / 3600.0)), longitude, latitude, &RA, &Dec, &topRA, &topDec, &LST, &HA, &moon_azimuth, &moon_elevation, &dist);
-    #else
-    time_t temp_t = now();
-    moon2(year(temp_t), month(temp_t), day(temp_t), (hour(temp_t) + (minute(temp_t) / 60.0) + (second(temp_t) / 3600.0)), longitude, latitude, &RA, &Dec, &topRA, &topDec, &LST, &HA, &moon_azimuth, &moon_elevation, &dist);
-    #endif
+  static char return_string[17];
 
-    #ifdef DEBUG_PROCESSES
-      service_process_debug(DEBUG_PROCESSES_PROCESS_EXIT,PROCESS_UPDATE_MOON_POSITION);
-    #endif      
+  strcpy(return_string, "");
+  if (event_time){
+    strcpy(return_string, tm_date_string(&event_time));
+    strcat(return_string, " ");
+    strcat(return_string, tm_time_string_short(&event_time));
+  }
+  return return_string;
 
+}
+#endif // (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
+// --------------------------------------------------------------
+#if (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
+void sun_moon_event_not_found_string(char * return_string, sun_moon_events &events){
 
+  if (events.complete){
+    strcat_P(return_string, (const char*) F("none"));
+  } else {
+    strcat_P(return_string, (const char*) F("searching"));
   }
-#endif // FEATURE_MOON_TRACKING
+
+}
+#endif // (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
+// --------------------------------------------------------------
+#if (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
+void sun_moon_events_string(char * return_string, sun_moon_events &events){
+
+  // appends " Rise: YYYY-MM-DD HH:MM Set: YYYY-MM-DD HH:MM Transit: YYYY-MM-DD HH:MM EL:xx.x" for \ME and \UE
+
+  // This only reports what service_sun_moon_events() has found so far; running the rest of the search here would hold up
+  // loop() for seconds on AVR.  The search goes forward in time, so an event that's been found stays put, and one that
+  // hasn't shows "searching" until the search gets past it ("none" once the search is done).
+
+  char temp_string[8];
+
+  strcat_P(return_string, (const char*) F(" Rise: "));
+  if (events.rise){strcat(return_string, sun_moon_event_string(events.rise));} else {sun_moon_event_not_found_string(return_string, events);}
+  strcat_P(return_string, (const char*) F(" Set: "));
+  if (events.set){strcat(return_string, sun_moon_event_string(events.set));} else {sun_moon_event_not_found_string(return_string, events);}
+  strcat_P(return_string, (const char*) F(" Transit: "));
+  if (events.transit){
+    strcat(return_string, sun_moon_event_string(events.transit));
+    strcat_P(return_string, (const char*) F(" EL:"));
+    dtostrf(events.transit_elevation,0,1,temp_string);
+    strcat(return_string, temp_string);
+  } else {
+    sun_moon_event_not_found_string(return_string, events);
+  }
+
+}
+#endif // (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
 // --------------------------------------------------------------
 #if defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING)
 byte calibrate_az_el(float new_az, float new_el){
@@ -14685,12 +17558,30 @@ byte process_backslash_command(byte input_buffer[], int input_buffer_index, byte
     byte tle_line_number;
     byte line_char_counter;
     byte last_tle_char_read = 0;    
+    byte packed_record[TLE_FILE_PACKED_RECORD_SIZE(SATELLITE_NAME_LENGTH-1)];
+    byte packed_record_position = 0;
+    byte packed_record_write_position = 0;
+    byte packed_record_write_length = 0;
+    byte packed_record_checksum;
+    byte packed_upload_status;
+    unsigned int packed_record_count = 0;
+    unsigned long tle_upload_first_byte_time = 0;
+    unsigned long tle_upload_last_write_time = 0;
+    unsigned long tle_upload_bytes_received = 0;
+    byte tle_upload_sender_stopped = 0;
+    unsigned long new_satellite_calc_budget_us;
   #endif
 
   #if defined(FEATURE_AUTOPARK)
     byte valid_input_autopark = 0;
   #endif  
 
+  #if defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+    byte correction_table = 0;
+    long correction_from_centidegrees;
+    long correction_to_centidegrees;
+  #endif
+
   [[maybe_unused]] float new_azimuth_starting_point;
 
   byte brake_az_disabled;
@@ -14755,6 +17646,42 @@ byte process_backslash_command(byte input_buffer[], int input_buffer_index, byte
       break;
    #endif // defined(FEATURE_AZ_POSITION_ROTARY_ENCODER) || defined(FEATURE_AZ_POSITION_PULSE_INPUT)
 
+  #if defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+    case '>':      // \>A / \>E - show the azimuth / elevation calibration table, \>Axxx[.xx] yyy[.yy] - add or change a point in EEPROM,
+                   // \>AC - empty the EEPROM table, \>AD - go back to the compiled in table
+      switch (input_buffer[2]) {
+        #if defined(FEATURE_AZIMUTH_CORRECTION)
+          case 'A': correction_table = CORRECTION_TABLE_AZIMUTH; break;
+        #endif
+        #if defined(FEATURE_ELEVATION_CORRECTION)
+          case 'E': correction_table = CORRECTION_TABLE_ELEVATION; break;
+        #endif
+        default: correction_table = 255; break;
+      }
+      if ((input_buffer_index < 3) || (correction_table == 255)){
+        strcpy_P(return_string, (const char*) F("Error."));
+      } else if (input_buffer_index == 3){
+        print_correction_table(correction_table);
+      } else if ((input_buffer_index == 4) && (input_buffer[3] == 'C')){
+        clear_correction_table(correction_table, KEEP_EEPROM_CORRECTION_TABLE);
+        strcpy_P(return_string, (const char*) F("Calibration table cleared"));
+      } else if ((input_buffer_index == 4) && (input_buffer[3] == 'D')){
+        clear_correction_table(correction_table, REVERT_TO_COMPILED_CORRECTION_TABLE);
+        strcpy_P(return_string, (const char*) F("Using compiled in calibration table"));
+      } else if (!parse_correction_table_point(input_buffer, input_buffer_index, &correction_from_centidegrees, &correction_to_centidegrees)){
+        strcpy_P(return_string, (const char*) F("Error.  Format: \\>Axxx[.xx] yyy[.yy]"));
+      } else if (!add_correction_table_point(correction_table, correction_from_centidegrees, correction_to_centidegrees)){
+        strcpy_P(return_string, (const char*) F("Error.  Calibration table full"));
+      } else {
+        dtostrf(centidegrees_to_degrees(correction_from_centidegrees), 0, 2, temp_string);
+        strcpy(return_string, temp_string);
+        strcat_P(return_string, (const char*) F(" -> "));
+        dtostrf(centidegrees_to_degrees(correction_to_centidegrees), 0, 2, temp_string);
+        strcat(return_string, temp_string);
+      }
+      break;
+  #endif // defined(FEATURE_AZIMUTH_CORRECTION) || defined(FEATURE_ELEVATION_CORRECTION)
+
     case 'I':        // \Ix[x][x] - set az starting point
       tempfloat = 0;
       for (int x = 2;x < input_buffer_index;x++){
@@ -15116,6 +18043,14 @@ byte process_backslash_command(byte input_buffer[], int input_buffer_index, byte
           change_tracking(ACTIVATE_MOON_TRACKING);          
           strcpy_P(return_string, (const char*) F("Moon tracking activated."));
           break;
+        #if !defined(OPTION_USE_OLD_TIME_CODE)
+          case 'E':  // next moon rise, set, and transit
+            if (input_buffer_index == 3){
+              strcpy_P(return_string, (const char*) F("Moon:"));
+              sun_moon_events_string(return_string, moon_events);
+              break;
+            }  // otherwise it's left over in the buffer, fall through to the position
+        #endif
         default: //strcpy(return_string, "Error."); 
           update_moon_position();
           strcpy_P(return_string, (const char*) F("Moon: AZ:"));
@@ -15199,7 +18134,16 @@ byte process_backslash_command(byte input_buffer[], int input_buffer_index, byte
           change_tracking(ACTIVATE_SUN_TRACKING);
           strcpy_P(return_string, (const char*) F("Sun tracking activated."));       
           break;
+        #if !defined(OPTION_USE_OLD_TIME_CODE)
+          case 'E':  // next sun rise, set, and transit
+            if (input_buffer_index == 3){
+              strcpy_P(return_string, (const char*) F("Sun:"));
+              sun_moon_events_string(return_string, sun_events);
+              break;
+            }  // otherwise it's left over in the buffer, fall through to the position
+        #endif
         default: //strcpy(return_string, "Error."); 
+          update_sun_position();
           strcpy_P(return_string, (const char*) F("Sun: AZ:"));
           dtostrf(sun_azimuth,0,2,temp_string);
           strcat(return_string, temp_string);
@@ -15676,7 +18620,11 @@ byte process_backslash_command(byte input_buffer[], int input_buffer_index, byte
         case '#':
           change_tracking(DEACTIVATE_ALL);
           control_port->println(F("Paste bare TLE file text now; double return to end."));
+          invalidate_tle_file_directory();
+          invalidate_satellite_element_cache();
           write_char_to_tle_file_area_eeprom(0,1); // initialize   
+          tle_catalog_bytes_written = 0;
+          tle_catalog_bytes_unchanged = 0;
           tle_upload_start_time = millis();
           tle_line_number = 0;  // 0 = sat name line, 1 = tle line 1, 2 = tle line 2
           line_char_counter = 0;
@@ -15686,6 +18634,8 @@ byte process_backslash_command(byte input_buffer[], int input_buffer_index, byte
             while ((control_port->available()) && ((tle_serial_buffer_in_pointer+1) != tle_serial_buffer_out_pointer) &&
               (!((tle_serial_buffer_in_pointer == 2000) && (tle_serial_buffer_out_pointer == 0)))){    
               tle_char_read = toupper(control_port->read());   
+              if (tle_upload_bytes_received == 0){tle_upload_first_byte_time = millis();}
+              tle_upload_bytes_received++;
               if ((tle_line_number != 1) || (tle_char_read == '\r') || ((tle_line_number == 1) && (line_char_counter < 44))) {  // truncate TLE line 1 
                 if ((tle_char_read == '\n') || (tle_char_read == '\r')){
                   if (last_tle_char_read != 254){  // use 254 to mark end of a line
@@ -15722,9 +18672,11 @@ byte process_backslash_command(byte input_buffer[], int input_buffer_index, byte
               }
               tle_upload_start_time = millis();              
             }
+            tle_upload_sender_stopped = tle_upload_flow_control(tle_serial_buffer_in_pointer,tle_serial_buffer_out_pointer,2001,tle_upload_sender_stopped);
             // outgoing data written to eeprom
             if (tle_serial_buffer_in_pointer != tle_serial_buffer_out_pointer){
               write_char_to_tle_file_area_result = write_char_to_tle_file_area_eeprom(tle_serial_buffer[tle_serial_buffer_out_pointer],0);
+              tle_upload_last_write_time = millis();
               if (write_char_to_tle_file_area_result == 0){
                 if (end_of_eeprom_was_hit == 0){
                   end_of_eeprom_was_hit = 1;
@@ -15742,16 +18694,137 @@ byte process_backslash_command(byte input_buffer[], int input_buffer_index, byte
             }
           }    
           write_char_to_tle_file_area_eeprom(0xFF,0); // write terminating FF
+          if (tle_upload_sender_stopped){control_port->write(0x11);}  // XON
           control_port->println(F("\r\nFile stored."));
           if (end_of_eeprom_was_hit == 2){
             control_port->println(F("File was truncated.")); 
           } 
+          print_tle_upload_statistics(tle_upload_bytes_received,tle_upload_first_byte_time,tle_upload_last_write_time);
 
+          write_tle_file_directory();
           populate_satellite_list_array();
 
           pull_satellite_tle_and_activate(satellite[0].name,_VERBOSE_,MAKE_IT_THE_CURRENT_SATELLITE);
 
           break;          
+
+        case '=':  // satellite calculation time budget
+          if (input_buffer_index > 2){
+            new_satellite_calc_budget_us = 0;
+            for (x = 2;x < input_buffer_index;x++){
+              if ((input_buffer[x] < '0') || (input_buffer[x] > '9') || (new_satellite_calc_budget_us > 100000)){
+                strcpy_P(return_string,(const char*) F("Error."));
+                x = input_buffer_index;
+              } else {
+                new_satellite_calc_budget_us = (new_satellite_calc_budget_us * 10) + (input_buffer[x] - 48);
+              }
+            }
+            if (strlen(return_string) == 0){
+              satellite_calc_budget_us = new_satellite_calc_budget_us;
+            }
+          }
+          if (strlen(return_string) == 0){
+            strcpy_P(return_string,(const char*) F("Satellite calculation budget: "));
+            dtostrf(satellite_calc_budget_us, 0, 0, temp_string);
+            strcat(return_string, temp_string);
+            strcat_P(return_string,(const char*) F(" uS"));
+          }
+          break;
+
+        case '*':  // packed TLE file upload, records as written by lib/tle/tle_to_packed.py followed by 0xFF
+          change_tracking(DEACTIVATE_ALL);
+          control_port->println(F("Send packed TLE file now."));
+          invalidate_tle_file_directory();
+          invalidate_satellite_element_cache();
+          write_char_to_tle_file_area_eeprom(0,1); // initialize   
+          tle_catalog_bytes_written = 0;
+          tle_catalog_bytes_unchanged = 0;
+          tle_upload_start_time = millis();
+          packed_upload_status = 0;  // 0 = receiving, 1 = got the end of the file, 2 = bad record, 3 = hit the end of eeprom
+          // same circular buffer as the text upload, but a record is only written to eeprom once it's all in and checks out,
+          // one byte per pass so the serial port still gets serviced
+          while (((millis() - tle_upload_start_time) < 20000) && (packed_upload_status == 0)){
+            // incoming serial data
+            while ((control_port->available()) && ((tle_serial_buffer_in_pointer+1) != tle_serial_buffer_out_pointer) &&
+              (!((tle_serial_buffer_in_pointer == 2000) && (tle_serial_buffer_out_pointer == 0)))){    
+              tle_serial_buffer[tle_serial_buffer_in_pointer] = control_port->read();
+              if (tle_upload_bytes_received == 0){tle_upload_first_byte_time = millis();}
+              tle_upload_bytes_received++;
+              if (tle_serial_buffer_in_pointer < 2000){
+                tle_serial_buffer_in_pointer++;
+              } else {
+                tle_serial_buffer_in_pointer = 0; // buffer roll over
+              }
+              tle_upload_start_time = millis();
+            }
+            tle_upload_sender_stopped = tle_upload_flow_control(tle_serial_buffer_in_pointer,tle_serial_buffer_out_pointer,2001,tle_upload_sender_stopped);
+            if (packed_record_write_position < packed_record_write_length){
+              // outgoing record written to eeprom
+              if (write_char_to_tle_file_area_eeprom(packed_record[packed_record_write_position],0) == 0){
+                packed_upload_status = 3;
+              }
+              tle_upload_last_write_time = millis();
+              packed_record_write_position++;
+              if (packed_record_write_position == packed_record_write_length){
+                packed_record_count++;
+              }
+            } else if (tle_serial_buffer_in_pointer != tle_serial_buffer_out_pointer){
+              // next byte of the record coming in
+              tle_char_read = tle_serial_buffer[tle_serial_buffer_out_pointer];
+              if (tle_serial_buffer_out_pointer < 2000){
+                tle_serial_buffer_out_pointer++;
+              } else {
+                tle_serial_buffer_out_pointer = 0; 
+              }
+              if ((packed_record_position == 0) && (tle_char_read == 0xFF)){
+                packed_upload_status = 1;
+              } else {
+                packed_record[packed_record_position] = tle_char_read;
+                packed_record_position++;
+                if ((packed_record[0] != TLE_FILE_PACKED_RECORD_MARKER) || ((packed_record_position == 2) && ((packed_record[1] == 0) || (packed_record[1] > (SATELLITE_NAME_LENGTH-1))))){
+                  packed_upload_status = 2;
+                } else if ((packed_record_position > 2) && (packed_record_position == TLE_FILE_PACKED_RECORD_SIZE(packed_record[1]))){
+                  packed_record_checksum = 0;
+                  for (x = packed_record_position - SAT_ELEMENTS_PACKED_SIZE - 1;x < (packed_record_position - 1);x++){
+                    packed_record_checksum = packed_record_checksum + packed_record[x];
+                  }
+                  if (packed_record_checksum == packed_record[packed_record_position - 1]){
+                    packed_record_write_position = 0;
+                    packed_record_write_length = packed_record_position;
+                    packed_record_position = 0;
+                  } else {
+                    packed_upload_status = 2;
+                  }
+                }
+              }
+            }
+          }
+          write_char_to_tle_file_area_eeprom(0xFF,0); // write terminating FF
+          if (tle_upload_sender_stopped){control_port->write(0x11);}  // XON
+          if (packed_upload_status != 1){
+            tle_upload_start_time = millis();
+            while ((millis() - tle_upload_start_time) < 1000){  // throw away whatever else is coming so it isn't taken as commands
+              if (control_port->available()){
+                control_port->read();
+                tle_upload_start_time = millis();
+              }
+            }
+          }
+          switch(packed_upload_status){
+            case 0: control_port->println(F("Timed out.")); break;
+            case 2: control_port->println(F("Bad record.")); break;
+            case 3: control_port->println(F("End of eeprom file area hit.")); break;
+          }
+          control_port->print(packed_record_count);
+          control_port->println(F(" satellites stored."));
+          print_tle_upload_statistics(tle_upload_bytes_received,tle_upload_first_byte_time,tle_upload_last_write_time);
+
+          write_tle_file_directory();
+          populate_satellite_list_array();
+
+          pull_satellite_tle_and_activate(satellite[0].name,_VERBOSE_,MAKE_IT_THE_CURRENT_SATELLITE);
+
+          break;
       
 
         case '$':
@@ -15785,6 +18858,15 @@ byte process_backslash_command(byte input_buffer[], int input_buffer_index, byte
               }
             }
           }
+          #if !defined(OPTION_USE_OLD_TIME_CODE)
+            if (current_satellite_position_in_array < SATELLITE_LIST_LENGTH){
+              expire_satellite_passes(current_satellite_position_in_array);
+              if (satellite_pass_count[current_satellite_position_in_array] >= x){  // already have them in the pass table
+                print_satellite_passes(current_satellite_position_in_array,x);
+                break;
+              }
+            }
+          #endif
           service_calc_satellite_data(current_satellite_position_in_array,x,PRINT_AOS_LOS_TABULAR_REPORT,SERVICE_CALC_PRINT_HEADER,SERVICE_CALC_INITIALIZE,SERVICE_CALC_PRINT_DONE,0);
           break;
 
@@ -16001,6 +19083,20 @@ byte process_backslash_command(byte input_buffer[], int input_buffer_index, byte
             strcpy(return_string, "\\!??ES");
           #endif //FEATURE_ELEVATION_CONTROL              
         }   
+        if ((input_buffer[2] == 'A') && (input_buffer[3] == 'V')) {  // \?AV - AZ velocity, degrees per second
+          strconditionalcpy(return_string, "\\!OKAV", include_response_code);
+          dtostrf(azimuth_estimate.velocity, 0, 2, temp_string);
+          strcat(return_string, temp_string); 
+        }  
+        if ((input_buffer[2] == 'E') && (input_buffer[3] == 'V')) {  // \?EV - EL velocity, degrees per second
+          #ifdef FEATURE_ELEVATION_CONTROL
+            strconditionalcpy(return_string, "\\!OKEV", include_response_code);        
+            dtostrf(elevation_estimate.velocity, 0, 2, temp_string);
+            strcat(return_string, temp_string);
+          #else // FEATURE_ELEVATION_CONTROL  
+            strcpy(return_string, "\\!??EV");
+          #endif //FEATURE_ELEVATION_CONTROL              
+        }   
         if ((input_buffer[2] == 'P') && (input_buffer[3] == 'G')) {  // \?PG - Ping        
           strcpy(return_string, "\\!OKPG");     
         }    
@@ -16852,7 +19948,7 @@ Not implemented yet:
 #endif //FEATURE_SATELLITE_TRACKING
 //-----------------------------------------------------------------------
 
-#if defined(FEATURE_SATELLITE_TRACKING)
+#if defined(FEATURE_SATELLITE_TRACKING) && defined(OPTION_USE_OLD_TIME_CODE)
   void update_satellite_array_order(){
 
 
@@ -16875,6 +19971,9 @@ Not implemented yet:
     long aos_time_diff;
     byte last_assigned_order_value;
     byte found_an_aos_sat = 0;
+    #if !defined(OPTION_USE_OLD_TIME_CODE)
+      time_t time_now = now();
+    #endif
 
     // populate array with the next event time in seconds
     for (int z = 0;z < SATELLITE_LIST_LENGTH;z++){
@@ -16884,10 +19983,8 @@ Not implemented yet:
         los_time_diff = difftime(&satellite[z].next_los,&current_clock,&dummyint1,&dummyint2,&dummyint3,&dummyint4);
         aos_time_diff = difftime(&satellite[z].next_aos,&current_clock,&dummyint1,&dummyint2,&dummyint3,&dummyint4);
         #else //OPTION_USE_OLD_TIME_CODE
-        tmElements_t current_clock;
-        breakTime(now(), current_clock); 
-        los_time_diff = difftime(&satellite[z].next_los,&current_clock,&dummyint1,&dummyint2,&dummyint3,&dummyint4);
-        aos_time_diff = difftime(&satellite[z].next_aos,&current_clock,&dummyint1,&dummyint2,&dummyint3,&dummyint4);
+        los_time_diff = satellite[z].next_los - time_now;
+        aos_time_diff = satellite[z].next_aos - time_now;
         #endif           
         if (aos_time_diff < los_time_diff){
           satellite_next_event_seconds[z] = aos_time_diff;
@@ -17045,9 +20142,97 @@ Not implemented yet:
 
 #endif //FEATURE_SATELLITE_TRACKING
 //-----------------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING) && !defined(OPTION_USE_OLD_TIME_CODE)
+  void update_satellite_array_order(){
+
+    // put the whole array in order from scratch; after this place_satellite_in_order() keeps it that way as
+    // satellites are calculated and go in and out of AOS
+
+    #if defined(DEBUG_SATELLITE_ARRAY_ORDER)
+      debug.println(F("update_satellite_array_order: entered"));
+    #endif
+
+    satellite_order_list_count = 0;
+
+    for (int z = 0;z < SATELLITE_LIST_LENGTH;z++){
+      if ((satellite[z].order != 255) && (strlen(satellite[z].name) > 2)){
+        satellite_order_list[satellite_order_list_count] = z;
+        satellite[z].order = satellite_order_list_count;
+        satellite_order_list_count++;
+        place_satellite_in_order(z);
+      }
+    }
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+//-----------------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING) && !defined(OPTION_USE_OLD_TIME_CODE)
+  byte satellite_goes_before(byte satellite_a, byte satellite_b){
+
+    // returns
+    // 1 = satellite_a goes ahead of satellite_b in the order: it's in AOS and satellite_b isn't, or its next AOS / LOS is sooner,
+    //     or satellite_b doesn't have one (never or always visible, or the search timed out)
+    // 0 = it doesn't
+
+    time_t next_event_a;
+    time_t next_event_b;
+
+    if ((satellite[satellite_a].status & 1) != (satellite[satellite_b].status & 1)){
+      return ((satellite[satellite_a].status & 1) == 1);
+    }
+
+    next_event_a = min(satellite[satellite_a].next_aos,satellite[satellite_a].next_los);
+    next_event_b = min(satellite[satellite_b].next_aos,satellite[satellite_b].next_los);
+
+    if ((next_event_a == 0) != (next_event_b == 0)){
+      return (next_event_b == 0);
+    }
+
+    return (next_event_a < next_event_b);
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+//-----------------------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING) && !defined(OPTION_USE_OLD_TIME_CODE)
+  void place_satellite_in_order(byte satellite_array_position){
+
+    // a satellite's next AOS / LOS or AOS status changed, move it up or down satellite_order_list to where it belongs now
+
+    byte place = satellite[satellite_array_position].order;
+
+    if ((place >= satellite_order_list_count) || (satellite_order_list[place] != satellite_array_position)){return;}  // not in the order
+
+    while ((place > 0) && (satellite_goes_before(satellite_array_position,satellite_order_list[place-1]))){
+      satellite_order_list[place] = satellite_order_list[place-1];
+      satellite[satellite_order_list[place]].order = place;
+      place--;
+    }
+
+    while ((place < (satellite_order_list_count-1)) && (satellite_goes_before(satellite_order_list[place+1],satellite_array_position))){
+      satellite_order_list[place] = satellite_order_list[place+1];
+      satellite[satellite_order_list[place]].order = place;
+      place++;
+    }
+
+    satellite_order_list[place] = satellite_array_position;
+    satellite[satellite_array_position].order = place;
+
+    #if defined(DEBUG_SATELLITE_ARRAY_ORDER)
+      debug.print(F("place_satellite_in_order: "));
+      debug.print(satellite[satellite_array_position].name);
+      debug.print(F(": "));
+      debug.print(place);
+      debug.println("");
+    #endif
+
+  }
+#endif //FEATURE_SATELLITE_TRACKING
+//-----------------------------------------------------------------------
 #if defined(FEATURE_SATELLITE_TRACKING)
   void print_aos_los_satellite_status_line(byte satellite_array_position){ 
 
+    int display_azimuth = (satellite[satellite_array_position].azimuth + 50) / 100;
+    int display_elevation = (satellite[satellite_array_position].elevation + ((satellite[satellite_array_position].elevation < 0) ? -50 : 50)) / 100;
 
     if (strcmp(satellite[satellite_array_position].name,configuration.current_satellite) == 0){
       send_vt100_code((char*)VT100_BOLD); 
@@ -17055,15 +20240,15 @@ Not implemented yet:
     control_port->print(satellite[satellite_array_position].name);
     control_port->print("\t");
     if (strlen(satellite[satellite_array_position].name)<8){control_port->print("\t");}
-    if (satellite[satellite_array_position].azimuth >= 0){control_port->print(" ");}
-    if (abs(satellite[satellite_array_position].azimuth) < 10){control_port->print(" ");}
-    if (abs(satellite[satellite_array_position].azimuth) < 100){control_port->print(" ");}
-    control_port->print(satellite[satellite_array_position].azimuth);
+    control_port->print(" ");
+    if (display_azimuth < 10){control_port->print(" ");}
+    if (display_azimuth < 100){control_port->print(" ");}
+    control_port->print(display_azimuth);
     control_port->print("  ");
-    if (satellite[satellite_array_position].elevation >= 0){control_port->print(" ");}
-    if (abs(satellite[satellite_array_position].elevation) < 10){control_port->print(" ");} 
-    if (abs(satellite[satellite_array_position].elevation) < 100){control_port->print(" ");}            
-    control_port->print(satellite[satellite_array_position].elevation);                        
+    if (display_elevation >= 0){control_port->print(" ");}
+    if (abs(display_elevation) < 10){control_port->print(" ");} 
+    if (abs(display_elevation) < 100){control_port->print(" ");}            
+    control_port->print(display_elevation);                        
     control_port->print("\t");
     if (satellite[satellite_array_position].latitude >= 0){control_port->print(" ");}
     if (abs(satellite[satellite_array_position].latitude) < 10){control_port->print(" ");} 
@@ -17090,12 +20275,12 @@ Not implemented yet:
     control_port->print(satellite[satellite_array_position].next_pass_max_el);  
     control_port->print("  ");
     #if defined(OPTION_USE_OLD_TIME_CODE)
-    if (satellite[satellite_array_position].next_los.year > 0){
+    if ((satellite[satellite_array_position].next_los.year > 0) || (satellite[satellite_array_position].status & B00011000)){
       control_port->print("\t");
       control_port->print(satellite_aos_los_string(satellite_array_position));
     }
     #else //OPTION_USE_OLD_TIME_CODE
-    if (satellite[satellite_array_position].next_los.Year > 0){
+    if ((satellite[satellite_array_position].next_los != 0) || (satellite[satellite_array_position].status & B00011000)){
       control_port->print("\t");
       control_port->print(satellite_aos_los_string(satellite_array_position));
     }
@@ -17118,6 +20303,14 @@ Not implemented yet:
 
       if ((satellite[satellite_array_position].status & 2) == 2){control_port->print(F("CALC_TOUT "));}
       if ((satellite[satellite_array_position].status & 4) == 4){control_port->print(F("STATE_CHANGE "));}
+      #if !defined(OPTION_USE_OLD_TIME_CODE)
+        control_port->print(F("refreshes:"));
+        control_port->print(satellite_refresh[satellite_array_position].refreshes);
+        control_port->print(F(" every:"));
+        control_port->print((satellite_refresh[satellite_array_position].interval * (unsigned long)SATELLITE_ARRAY_AZ_EL_REFRESH_MS) / 1000);
+        control_port->print(F("s calcs:"));
+        control_port->print(satellite_refresh[satellite_array_position].calcs);
+      #endif
     #endif
 
 
@@ -17146,6 +20339,8 @@ Not implemented yet:
 
 
     control_port->flush();
+
+    #if defined(OPTION_USE_OLD_TIME_CODE)
     update_satellite_array_order();
 
     // sort by next event time / satellite[z].order
@@ -17158,6 +20353,13 @@ Not implemented yet:
       //2021-10-08 Goody - added this to lessen GPS failed_checksum
       check_serial();
     }
+    #else //OPTION_USE_OLD_TIME_CODE
+    // satellite_order_list is always in order
+    for (int x = 0;x < satellite_order_list_count;x++){
+      print_aos_los_satellite_status_line(satellite_order_list[x]);
+      check_serial();
+    }
+    #endif //OPTION_USE_OLD_TIME_CODE
 
     control_port->println();
 
@@ -17234,13 +20436,21 @@ Not implemented yet:
 
     if (which_satellite >= SATELLITE_LIST_LENGTH){return tempstring;}
 
+    if ((satellite[which_satellite].status & 8) == 8){
+      strcpy_P(tempstring,(const char*) F("Never visible"));
+      return tempstring;
+    }
+    if ((satellite[which_satellite].status & 16) == 16){
+      strcpy_P(tempstring,(const char*) F("Always visible"));
+      return tempstring;
+    }
+
     // if ((float)satellite[which_satellite].elevation >= SATELLITE_AOS_ELEVATION_MIN) {
 
     #if !defined(OPTION_USE_OLD_TIME_CODE)
 
-    tmElements_t temp_datetime;
-    tmElements_t current_clock;
-    breakTime(now(), current_clock);
+    time_t temp_datetime;
+    time_t current_clock = now();
 
     #endif
       
@@ -19026,6 +22236,125 @@ void change_tracking(byte action){
 
 
 
+//-------------------------------------------------------
+
+#if (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING) || defined(FEATURE_SATELLITE_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
+void measure_tracking_lead_axis(tracking_lead_axis &axis, byte rotating, byte at_speed, struct heading_estimate &estimate){
+
+  // slew rate from the estimated velocity while at full speed; start up latency from how long a rotation takes to get a degree in,
+  // less the time that degree would take at full speed
+
+  float rate;
+  float latency;
+
+  if (!rotating){
+    axis.was_idle = 1;
+    axis.starting = 0;
+  } else {
+    if (axis.was_idle){
+      axis.was_idle = 0;
+      axis.starting = 1;
+      axis.start_time = millis();
+      axis.start_heading = estimate.position;
+    }
+    if ((axis.starting) && (abs(estimate.position - axis.start_heading) >= 1.0)){
+      axis.starting = 0;
+      if (axis.slew_rate > 0){
+        latency = ((millis() - axis.start_time) / 1000.0) - (1.0 / axis.slew_rate);
+        if (latency < 0){latency = 0;}
+        axis.start_latency = axis.start_latency + ((latency - axis.start_latency) * TRACKING_LEAD_SMOOTHING);
+      }
+    }
+  }
+
+  if ((millis() - axis.last_sample_time) >= TRACKING_LEAD_SAMPLE_MS){
+    if ((at_speed) && (axis.last_sample_at_speed)){
+      rate = abs(estimate.velocity);
+      if (axis.slew_rate == 0){
+        axis.slew_rate = rate;
+      } else {
+        axis.slew_rate = axis.slew_rate + ((rate - axis.slew_rate) * TRACKING_LEAD_SMOOTHING);
+      }
+    }
+    axis.last_sample_time = millis();
+    axis.last_sample_at_speed = at_speed;
+  }
+
+} /* measure_tracking_lead_axis */
+#endif
+// --------------------------------------------------------------
+#if (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING) || defined(FEATURE_SATELLITE_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
+void service_tracking_lead(){
+
+  measure_tracking_lead_axis(tracking_lead_az,(az_state != IDLE),((az_state == NORMAL_CW) || (az_state == NORMAL_CCW)),azimuth_estimate);
+
+  #if defined(FEATURE_ELEVATION_CONTROL)
+    measure_tracking_lead_axis(tracking_lead_el,(el_state != IDLE),((el_state == NORMAL_UP) || (el_state == NORMAL_DOWN)),elevation_estimate);
+  #endif
+
+} /* service_tracking_lead */
+#endif
+// --------------------------------------------------------------
+#if (defined(FEATURE_MOON_TRACKING) || defined(FEATURE_SUN_TRACKING) || defined(FEATURE_SATELLITE_TRACKING)) && !defined(OPTION_USE_OLD_TIME_CODE)
+byte tracking_lead_position(byte (*position_at)(time_t, double&, double&), double &target_azimuth, double &target_elevation){
+
+  // Move a tracking target ahead to where it will be by the time the rotator gets there: start up latency plus
+  // the travel at the measured slew rate, whichever axis is slower.  position_at() works out the target at a given time.
+
+  // returns
+  // 1 = target_azimuth and target_elevation moved ahead
+  // 0 = left alone (lead disabled, slew rate not measured yet, or less than a second)
+
+  double lead_azimuth = target_azimuth;
+  double lead_elevation = target_elevation;
+  float distance;
+  float lead_seconds;
+  float axis_lead_seconds;
+
+  if ((TRACKING_LEAD_MAX_SECS == 0) || (tracking_lead_az.slew_rate == 0)){return 0;}
+
+  for (byte x = 0;x < 2;x++){  // once from where the target is now, and once more from where it's going to be
+
+    distance = abs(lead_azimuth - azimuth);
+    if (distance > 180){distance = 360 - distance;}
+    lead_seconds = tracking_lead_az.start_latency + (distance / tracking_lead_az.slew_rate);
+
+    #if defined(FEATURE_ELEVATION_CONTROL)
+      if (tracking_lead_el.slew_rate > 0){
+        axis_lead_seconds = tracking_lead_el.start_latency + (abs(lead_elevation - elevation) / tracking_lead_el.slew_rate);
+        if (axis_lead_seconds > lead_seconds){lead_seconds = axis_lead_seconds;}
+      }
+    #endif
+
+    if (lead_seconds > TRACKING_LEAD_MAX_SECS){lead_seconds = TRACKING_LEAD_MAX_SECS;}
+    if (lead_seconds < 1){return 0;}
+
+    if (!position_at(now() + (long)(lead_seconds + 0.5),lead_azimuth,lead_elevation)){return 0;}
+
+  }
+
+  #if defined(DEBUG_TRACKING_LEAD)
+    debug.print(F("tracking_lead_position: lead:"));
+    debug.print(lead_seconds);
+    debug.print(F("s az:"));
+    debug.print(target_azimuth);
+    debug.print(F("->"));
+    debug.print(lead_azimuth);
+    debug.print(F(" el:"));
+    debug.print(target_elevation);
+    debug.print(F("->"));
+    debug.print(lead_elevation);
+    debug.println("");
+  #endif
+
+  target_azimuth = lead_azimuth;
+  target_elevation = lead_elevation;
+  if (target_elevation < 0){target_elevation = 0;}  // don't lead into the ground at LOS
+
+  return 1;
+
+} /* tracking_lead_position */
+#endif
 //-------------------------------------------------------
 
 
@@ -19067,6 +22396,14 @@ void service_moon_tracking(){
     }
   }
 
+  #if !defined(OPTION_USE_OLD_TIME_CODE)
+    service_sun_moon_events(moon_events, moon_position_calculated_at, MOON_AOS_ELEVATION_MIN);
+    if (sun_moon_waiting_for_rise(moon_events, moon_elevation, MOON_AOS_ELEVATION_MIN)){  // nothing to do until moon_events.rise
+      moon_visible = 0;
+      return;
+    }
+  #endif
+
   if ((millis() - last_update_moon_position) > MOON_UPDATE_POSITION_INTERVAL_MS){
     update_moon_position();
     last_update_moon_position = millis();
@@ -19103,11 +22440,17 @@ void service_moon_tracking(){
 
 
 
+    double moon_target_azimuth = moon_azimuth;
+    double moon_target_elevation = moon_elevation;
+    #if !defined(OPTION_USE_OLD_TIME_CODE)
+      tracking_lead_position(moon_position_at,moon_target_azimuth,moon_target_elevation);  // aim where the moon will be when we get there
+    #endif
+
     if ((moon_visible) && ((millis() - last_tracking_submit_request) >= configuration.tracking_moon_minimum_rotation_interval_ms)
-      && ((abs(azimuth-moon_azimuth)>configuration.tracking_moon_degrees_difference_threshold) || 
-      (abs(elevation-moon_elevation)>configuration.tracking_moon_degrees_difference_threshold))) {
-      submit_request(AZ, REQUEST_AZIMUTH, moon_azimuth, DBG_SERVICE_MOON_TRACKING);
-      submit_request(EL, REQUEST_ELEVATION, moon_elevation, DBG_SERVICE_MOON_TRACKING);
+      && ((abs(azimuth-moon_target_azimuth)>configuration.tracking_moon_degrees_difference_threshold) || 
+      (abs(elevation-moon_target_elevation)>configuration.tracking_moon_degrees_difference_threshold))) {
+      submit_request(AZ, REQUEST_AZIMUTH, moon_target_azimuth, DBG_SERVICE_MOON_TRACKING);
+      submit_request(EL, REQUEST_ELEVATION, moon_target_elevation, DBG_SERVICE_MOON_TRACKING);
       last_tracking_submit_request = millis();
     }
 
@@ -19158,6 +22501,14 @@ void service_sun_tracking(){
     }
   }
 
+  #if !defined(OPTION_USE_OLD_TIME_CODE)
+    service_sun_moon_events(sun_events, sun_position_calculated_at, SUN_AOS_ELEVATION_MIN);
+    if (sun_moon_waiting_for_rise(sun_events, sun_elevation, SUN_AOS_ELEVATION_MIN)){  // nothing to do until sun_events.rise
+      sun_visible = 0;
+      return;
+    }
+  #endif
+
   if ((millis() - last_update_sun_position) > SUN_UPDATE_POSITION_INTERVAL_MS){
     update_sun_position();
     last_update_sun_position = millis();
@@ -19192,11 +22543,17 @@ void service_sun_tracking(){
       debug.println(longitude);
     #endif // DEBUG_SUN_TRACKING
 
+    double sun_target_azimuth = sun_azimuth;
+    double sun_target_elevation = sun_elevation;
+    #if !defined(OPTION_USE_OLD_TIME_CODE)
+      tracking_lead_position(sun_position_at,sun_target_azimuth,sun_target_elevation);  // aim where the sun will be when we get there
+    #endif
+
     if ((sun_visible) && ((millis() - last_tracking_submit_request) >= configuration.tracking_sun_minimum_rotation_interval_ms)
-      && ((abs(azimuth-sun_azimuth)>configuration.tracking_sun_degrees_difference_threshold) || 
-      (abs(elevation-sun_elevation)>configuration.tracking_sun_degrees_difference_threshold))) {
-      submit_request(AZ, REQUEST_AZIMUTH, sun_azimuth, DBG_SERVICE_SUN_TRACKING);
-      submit_request(EL, REQUEST_ELEVATION, sun_elevation, DBG_SERVICE_SUN_TRACKING);
+      && ((abs(azimuth-sun_target_azimuth)>configuration.tracking_sun_degrees_difference_threshold) || 
+      (abs(elevation-sun_target_elevation)>configuration.tracking_sun_degrees_difference_threshold))) {
+      submit_request(AZ, REQUEST_AZIMUTH, sun_target_azimuth, DBG_SERVICE_SUN_TRACKING);
+      submit_request(EL, REQUEST_ELEVATION, sun_target_elevation, DBG_SERVICE_SUN_TRACKING);
       last_tracking_submit_request = millis();
     }
 
@@ -19505,6 +22862,7 @@ void service_process_debug(byte action,byte process_id){
                 case PROCESS_CHECK_BUTTONS: control_port->print(F("check_buttons\t\t")); break;
                 case PROCESS_MISC_ADMIN: control_port->print("misc_admin\t\t"); break;
                 case PROCESS_DEBUG: control_port->print("debug\t\t\t"); break;
+                case PROCESS_SATELLITE_CALC: control_port->print(F("satellite_calc\t\t")); break;
               }
               control_port->print("\t");
               control_port->print(((float)process_cumulative_time[x]/(float)micros())*100.0,0);
@@ -19514,6 +22872,22 @@ void service_process_debug(byte action,byte process_id){
             }
             
           }
+          #if defined(FEATURE_SATELLITE_TRACKING)
+            control_port->print(F("satellite_calc budget:"));
+            control_port->print(satellite_calc_budget_us);
+            control_port->print(F(" uS  predictions/call:"));
+            if (satellite_calc_budget_calls > 0){
+              control_port->print((float)satellite_calc_budget_steps / (float)satellite_calc_budget_calls,1);
+            } else {
+              control_port->print("-");
+            }
+            control_port->print(F("  longest call:"));
+            control_port->print(satellite_calc_budget_max_us);
+            control_port->println(F(" uS"));
+            satellite_calc_budget_calls = 0;
+            satellite_calc_budget_steps = 0;
+            satellite_calc_budget_max_us = 0;
+          #endif
           control_port->println("\r\n");
           last_output = millis();
         }
@@ -19586,7 +22960,7 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
 #endif //FEATURE_NEXTION_DISPLAY
 //------------------------------------------------------
 #if defined(FEATURE_SATELLITE_TRACKING)
-  void load_satellite_tle_into_P13(const char *name_in, const char *tle_line1, const char *tle_line2,byte load_hardcoded_tle,byte what_to_do){
+  void load_satellite_tle_into_P13(const char *name_in, const SatElements *elements,byte load_hardcoded_tle,byte what_to_do){
 
     #ifdef DEBUG_LOOP
       control_port->println(F("load_satellite_tle_into_P13()"));
@@ -19615,6 +22989,7 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
       strcpy(satellite[0].name,name);
 
       // bootstrap the EEPROM
+      invalidate_satellite_element_cache();
       write_char_to_tle_file_area_eeprom(0,1); // initialize 
       for (int z = 0;z < strlen(name);z++){
         write_char_to_tle_file_area_eeprom(name[z],0);
@@ -19629,10 +23004,11 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
       }
       write_char_to_tle_file_area_eeprom(254,0);
       write_char_to_tle_file_area_eeprom(255,0);
+      write_tle_file_directory();
 
     } else {  // DO_NOT_LOAD_HARDCODED_TLE
       strcpy(name,name_in);
-      sat.tle(name,tle_line1,tle_line2);
+      sat.elements(name,*elements);
       #if defined(DEBUG_SATELLITE_TRACKING_LOAD)
         debug.println(name);
       #endif         
@@ -19651,10 +23027,12 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
         #endif   
 
       } else {
+        byte found_it = 0;
         for (int z = 0;z < SATELLITE_LIST_LENGTH;z++){
           if (strlen(satellite[z].name) > 2){
             if (strcmp(satellite[z].name,configuration.current_satellite) == 0){
               current_satellite_position_in_array = z;        
+              found_it = 1;
               #if defined(DEBUG_SATELLITE_TRACKING_LOAD)
                 debug.print(F("load_satellite_tle_into_P13: "));
                 debug.print(satellite[z].name);
@@ -19666,6 +23044,9 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
           } 
         }
 
+        if (!found_it){  // it's further down the TLE file than the array goes
+          current_satellite_position_in_array = put_satellite_in_array(configuration.current_satellite);
+        }
 
       }
       satellite[current_satellite_position_in_array].status = satellite[current_satellite_position_in_array].status  & B11111000;
@@ -19690,7 +23071,9 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
 
     static unsigned long last_tracking_check = 0;
     static unsigned long last_tracking_submit_request = 0;
-    static unsigned long last_update_satellite_array_order = 0;
+    #if defined(OPTION_USE_OLD_TIME_CODE)
+      static unsigned long last_update_satellite_array_order = 0;
+    #endif
     static byte satellite_tracking_activated_by_activate_line = 0;
     static byte satellite_tracking_pin_state = 0;
     static byte satellite_initialized = 0;
@@ -19698,6 +23081,13 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
     static unsigned long last_periodic_aos_los_satellite_status_print = 0;
     static byte current_satellite_aos_los_update_needed = 0;
     static byte satellite_array_refresh_position = 0;
+    static unsigned long last_satellite_array_positions_refresh = 0;
+    #if !defined(OPTION_USE_OLD_TIME_CODE)
+      static byte satellite_array_calc_scan_needed = 1;
+      static unsigned long last_satellite_array_calc_retry = 0;
+      byte satellite_array_calc_slot;
+      byte satellite_array_calc_task;
+    #endif
 
     #define CALC_SEQUENTIAL 0
     #define CALC_SEQUENTIAL_INTELLIGENT 1
@@ -19729,14 +23119,14 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
       #endif
 
       if (strcmp(configuration.current_satellite,"-") == 0){
-        load_satellite_tle_into_P13(NULL,NULL,NULL,LOAD_HARDCODED_TLE,MAKE_IT_THE_CURRENT_SATELLITE);  // if there is no current satellite in the configuration, load a hardcode TLE
+        load_satellite_tle_into_P13(NULL,NULL,LOAD_HARDCODED_TLE,MAKE_IT_THE_CURRENT_SATELLITE);  // if there is no current satellite in the configuration, load a hardcode TLE
       } else {
         satellite_initialized = pull_satellite_tle_and_activate(configuration.current_satellite,NOT_VERBOSE,MAKE_IT_THE_CURRENT_SATELLITE);
         if (satellite_initialized == 0){
           #if defined(DEBUG_SATELLITE_SERVICE)
             debug.print(F("service_satellite_tracking: couldn't find TLE for last current satellite stored in the config"));
           #endif             
-          load_satellite_tle_into_P13(NULL,NULL,NULL,LOAD_HARDCODED_TLE,MAKE_IT_THE_CURRENT_SATELLITE);  // couldn't find a TLE for the last current satellite stored in the configuration, load a hardcoded one
+          load_satellite_tle_into_P13(NULL,NULL,LOAD_HARDCODED_TLE,MAKE_IT_THE_CURRENT_SATELLITE);  // couldn't find a TLE for the last current satellite stored in the configuration, load a hardcoded one
         }
       }
       satellite_initialized = 1;
@@ -19815,12 +23205,18 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
       }
     }
 
+    #if defined(OPTION_USE_OLD_TIME_CODE)
     if ((((millis() - last_update_satellite_array_order) > SATELLITE_UPDATE_ARRAY_ORDER_INTERVAL_MS) 
        && (service_calc_satellite_data(0,0,0,0,SERVICE_CALC_REPORT_STATE,0,0) == SERVICE_IDLE)) 
        || (push_update)) {
       update_satellite_array_order();
       last_update_satellite_array_order = millis();
     } 
+    #else //OPTION_USE_OLD_TIME_CODE
+    if (push_update){  // otherwise place_satellite_in_order() keeps the order up as satellites change
+      update_satellite_array_order();
+    }
+    #endif //OPTION_USE_OLD_TIME_CODE
 
  
 
@@ -19834,11 +23230,22 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
 
 
 
+    // precomputing the pass of the satellite we're tracking goes ahead of the array updates
+    byte satellite_track_busy = 0;
+    #if !defined(OPTION_USE_OLD_TIME_CODE)
+      if (service_calc_satellite_data(0,0,0,0,SERVICE_CALC_REPORT_STATE,0,0) == SERVICE_IDLE){
+        satellite_track_busy = service_satellite_track();
+      }
+    #endif
+
     // let's update data for satellites in the array
-    if ((service_calc_satellite_data(0,0,0,0,SERVICE_CALC_REPORT_STATE,0,0) == SERVICE_IDLE) && (!current_satellite_aos_los_update_needed)){
+    if ((service_calc_satellite_data(0,0,0,0,SERVICE_CALC_REPORT_STATE,0,0) == SERVICE_IDLE) && (!current_satellite_aos_los_update_needed) && (!satellite_track_busy)){
       if (service_calc_satellite_data_current_mode == CALC_SEQUENTIAL){  // service the list sequentially
         if (strlen(satellite[satellite_array_refresh_position].name) > 2){
           service_calc_satellite_data(satellite_array_refresh_position,1,UPDATE_SAT_ARRAY_SLOT_AZ_EL_NEXT_AOS_LOS,SERVICE_CALC_DO_NOT_PRINT_HEADER,SERVICE_CALC_INITIALIZE,SERVICE_CALC_DO_NOT_PRINT_DONE,0);
+          #if !defined(OPTION_USE_OLD_TIME_CODE)
+            satellite_refresh[satellite_array_refresh_position].calcs++;
+          #endif
           #if defined(DEBUG_SATELLITE_SERVICE)
             debug.print("service_satellite_tracking: CALC_SEQUENTIAL:");
             debug.println(satellite_array_refresh_position);
@@ -19850,7 +23257,14 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
           service_calc_satellite_data_current_mode = CALC_SEQUENTIAL_INTELLIGENT;
           satellite_array_data_ready = 1;
         }
-      } else {  // do refreshing of the array only where needed: az, el, lat, and long (quick calculations) all the time; next aos/los only when satellite is within 5 degrees of the horizon
+      } else if ((millis() - last_satellite_array_positions_refresh) >= SATELLITE_ARRAY_AZ_EL_REFRESH_MS){  // az, el, lat, and long (quick calculations) for the satellites that are due, in one go
+        refresh_satellite_array_positions();
+        last_satellite_array_positions_refresh = millis();
+        #if !defined(OPTION_USE_OLD_TIME_CODE)
+          satellite_array_calc_scan_needed = 1;
+        #endif
+      } else {  // do refreshing of the array only where needed: next aos/los only when a satellite has an AOS/LOS state change, and topping up the pass tables
+        #if defined(OPTION_USE_OLD_TIME_CODE)
         if (strlen(satellite[satellite_array_refresh_position].name) > 2){   // valid sat?
           #if defined(DEBUG_SATELLITE_SERVICE)
             debug.print(F("service_satellite_tracking: CALC_SEQUENTIAL_INTELLIGENT:"));
@@ -19858,36 +23272,44 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
             debug.println("");
           #endif 
 
-          #if defined(OPTION_USE_OLD_TIME_CODE)
-
-          if (((satellite[satellite_array_refresh_position].status & 2) == 1) || ((satellite[satellite_array_refresh_position].next_aos.year == 0)) || ((satellite[satellite_array_refresh_position].status & 4) == 4)){  
-            // satellite was flagged for calculation timeout or for some reason is unpopulated or there is an AOS/LOS state change flag, do a full calc
-            satellite[satellite_array_refresh_position].status = satellite[satellite_array_refresh_position].status & B11111001; // clear the timeout flag and the AOS/LOS state change flag
-            service_calc_satellite_data(satellite_array_refresh_position,1,UPDATE_SAT_ARRAY_SLOT_AZ_EL_NEXT_AOS_LOS,SERVICE_CALC_DO_NOT_PRINT_HEADER,SERVICE_CALC_INITIALIZE,SERVICE_CALC_DO_NOT_PRINT_DONE,0);
-          } else {
-            // just update az and el
-            service_calc_satellite_data(satellite_array_refresh_position,1,UPDATE_SAT_ARRAY_SLOT_JUST_AZ_EL,SERVICE_CALC_DO_NOT_PRINT_HEADER,SERVICE_CALC_INITIALIZE,SERVICE_CALC_DO_NOT_PRINT_DONE,0);
-          }
-
-          #else //OPTION_USE_OLD_TIME_CODE
-
-          if (((satellite[satellite_array_refresh_position].status & 2) == 1) || ((satellite[satellite_array_refresh_position].next_aos.Year == 0)) || ((satellite[satellite_array_refresh_position].status & 4) == 4)){  
+          if (((satellite[satellite_array_refresh_position].status & 2) == 1) || ((satellite[satellite_array_refresh_position].next_aos.year == 0)) || ((satellite[satellite_array_refresh_position].status & 4) == 4)){  
             // satellite was flagged for calculation timeout or for some reason is unpopulated or there is an AOS/LOS state change flag, do a full calc
             satellite[satellite_array_refresh_position].status = satellite[satellite_array_refresh_position].status & B11111001; // clear the timeout flag and the AOS/LOS state change flag
             service_calc_satellite_data(satellite_array_refresh_position,1,UPDATE_SAT_ARRAY_SLOT_AZ_EL_NEXT_AOS_LOS,SERVICE_CALC_DO_NOT_PRINT_HEADER,SERVICE_CALC_INITIALIZE,SERVICE_CALC_DO_NOT_PRINT_DONE,0);
-          } else {
-            // just update az and el
-            service_calc_satellite_data(satellite_array_refresh_position,1,UPDATE_SAT_ARRAY_SLOT_JUST_AZ_EL,SERVICE_CALC_DO_NOT_PRINT_HEADER,SERVICE_CALC_INITIALIZE,SERVICE_CALC_DO_NOT_PRINT_DONE,0);
           }
 
-          #endif //OPTION_USE_OLD_TIME_CODE
-
         }
         satellite_array_refresh_position++;
         if (satellite_array_refresh_position >= SATELLITE_LIST_LENGTH){
           satellite_array_refresh_position = 0;
         }
-      } //if (strlen(satellite[satellite_array_refresh_position].name) > 2){   // valid sat?
+
+        #else //OPTION_USE_OLD_TIME_CODE
+
+        // rather than going around the array, calculate whatever has the soonest AOS / LOS coming up; nothing
+        // changes between az / el refreshes unless a calculation ran, so there's no need to look every time through
+        if (satellite_array_calc_scan_needed){
+          satellite_array_calc_slot = next_satellite_array_slot_to_calc(satellite_array_calc_task,((millis() - last_satellite_array_calc_retry) >= SATELLITE_ARRAY_AZ_EL_REFRESH_MAX_MS));
+          if (satellite_array_calc_slot < SATELLITE_LIST_LENGTH){
+            #if defined(DEBUG_SATELLITE_SERVICE)
+              debug.print(F("service_satellite_tracking: CALC_SEQUENTIAL_INTELLIGENT:"));
+              debug.print(satellite_array_calc_slot);
+              debug.println("");
+            #endif 
+            if (satellite_array_calc_task == UPDATE_SAT_ARRAY_SLOT_AZ_EL_NEXT_AOS_LOS){
+              if ((satellite[satellite_array_calc_slot].status & 2) == 2){last_satellite_array_calc_retry = millis();}
+              satellite[satellite_array_calc_slot].status = satellite[satellite_array_calc_slot].status & B11111001; // clear the timeout flag and the AOS/LOS state change flag
+              satellite_refresh[satellite_array_calc_slot].countdown = 0;  // new AOS / LOS, reschedule its az / el refreshes
+            }
+            service_calc_satellite_data(satellite_array_calc_slot,1,satellite_array_calc_task,SERVICE_CALC_DO_NOT_PRINT_HEADER,SERVICE_CALC_INITIALIZE,SERVICE_CALC_DO_NOT_PRINT_DONE,0);
+            satellite_refresh[satellite_array_calc_slot].calcs++;
+          } else {
+            satellite_array_calc_scan_needed = 0;
+          }
+        }
+
+        #endif //OPTION_USE_OLD_TIME_CODE
+      } 
     }
     // END -let's update data for satellites in the array
 
@@ -19895,6 +23317,10 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
 
     if ((satellite_tracking_active) && ((millis() - last_tracking_check) > configuration.tracking_sat_check_frequency_ms)) {
 
+      #if !defined(OPTION_USE_OLD_TIME_CODE)
+        satellite_track_position(0,current_satellite_azimuth,current_satellite_elevation);  // from the precomputed pass if we have it, otherwise it's what the array refresh last calculated
+      #endif
+
       #ifdef DEBUG_SATELLITE_TRACKING
         debug.print(F("service_satellite_tracking: AZ: "));
         debug.print(current_satellite_azimuth);
@@ -19909,11 +23335,17 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
       //if ((satellite[current_satellite_position_in_array].status & 1) == 1){
 
 
+      double satellite_target_azimuth = current_satellite_azimuth;
+      double satellite_target_elevation = current_satellite_elevation;
+      #if !defined(OPTION_USE_OLD_TIME_CODE)
+        tracking_lead_position(satellite_position_at,satellite_target_azimuth,satellite_target_elevation);  // aim where the satellite will be when we get there
+      #endif
+
     if (((satellite[current_satellite_position_in_array].status & 1) == 1) && ((millis() - last_tracking_submit_request) >= configuration.tracking_sat_minimum_rotation_interval_ms)
-      && ((abs(azimuth-current_satellite_azimuth)>configuration.tracking_sat_degrees_difference_threshold) || 
-      (abs(elevation-current_satellite_elevation)>configuration.tracking_sat_degrees_difference_threshold))) {
-        submit_request(AZ, REQUEST_AZIMUTH, current_satellite_azimuth, DBG_SERVICE_SATELLITE_TRACKING);
-        submit_request(EL, REQUEST_ELEVATION, current_satellite_elevation, DBG_SERVICE_SATELLITE_TRACKING);
+      && ((abs(azimuth-satellite_target_azimuth)>configuration.tracking_sat_degrees_difference_threshold) || 
+      (abs(elevation-satellite_target_elevation)>configuration.tracking_sat_degrees_difference_threshold))) {
+        submit_request(AZ, REQUEST_AZIMUTH, satellite_target_azimuth, DBG_SERVICE_SATELLITE_TRACKING);
+        submit_request(EL, REQUEST_ELEVATION, satellite_target_elevation, DBG_SERVICE_SATELLITE_TRACKING);
         last_tracking_submit_request = millis();
       }
 
@@ -20046,6 +23478,123 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
 
 #endif //FEATURE_SATELLITE_TRACKING 
 
+//------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING)
+
+  void service_calc_satellite_data_within_budget(){
+
+    // service_calc_satellite_data() does one prediction each call.  While the rotator is sitting idle, keep calling it
+    // until satellite_calc_budget_us is used up so AOS / LOS searches get done sooner; while it's moving, stick to one
+    // so the rest of loop() isn't held up.  Either way, a call can only run over by one prediction.
+
+    unsigned long start_time = micros();
+    byte rotator_idle = (az_state == IDLE);
+    #if defined(DEBUG_PROCESSES)
+      unsigned long call_time;
+    #endif
+
+    #if defined(FEATURE_ELEVATION_CONTROL)
+      if (el_state != IDLE){rotator_idle = 0;}
+    #endif
+
+    #if defined(DEBUG_PROCESSES)
+      if (service_calc_satellite_data_service_state == SERVICE_CALC_IN_PROGRESS){satellite_calc_budget_calls++;}
+    #endif
+
+    do {
+      #if defined(DEBUG_PROCESSES)
+        if (service_calc_satellite_data_service_state == SERVICE_CALC_IN_PROGRESS){satellite_calc_budget_steps++;}
+      #endif
+      service_calc_satellite_data(0,0,0,SERVICE_CALC_DO_NOT_PRINT_HEADER,SERVICE_CALC_SERVICE,SERVICE_CALC_DO_NOT_PRINT_DONE,0);
+    } while ((rotator_idle) && (service_calc_satellite_data_service_state == SERVICE_CALC_IN_PROGRESS) && ((micros() - start_time) < satellite_calc_budget_us));
+
+    #if defined(DEBUG_PROCESSES)
+      call_time = micros() - start_time;
+      if (call_time > satellite_calc_budget_max_us){satellite_calc_budget_max_us = call_time;}
+    #endif
+
+  }
+
+#endif //FEATURE_SATELLITE_TRACKING 
+
+//------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING)
+
+  byte satellite_visibility(double elevation_now){
+
+    // A quick look at whether the satellite loaded in sat can have an AOS or LOS at all, so the AOS / LOS search can be
+    // skipped for ones that can't.
+    //
+    // The sub-satellite point never gets further from the equator than the inclination, and even from apogee the
+    // satellite is only above the horizon within acos(RE / apogee radius) of central angle, so from a latitude further
+    // out than those two together it never rises.  A geostationary satellite stays where it is, give or take what its
+    // inclination and eccentricity let it wander, so if it's well up (or well down) now, it always will be.
+
+    // returns
+    // SATELLITE_VISIBILITY_PASSES = it has passes, or we can't tell
+    // SATELLITE_VISIBILITY_NEVER
+    // SATELLITE_VISIBILITY_ALWAYS
+
+    const double margin = 1.0;  // degrees, for earth flattening, observer altitude, and drift between checks
+
+    SatElements elements;
+    double inclination;
+    double semi_major_axis;
+    double cos_horizon_central_angle;
+    double horizon_central_angle;
+    double wander;
+
+    sat.get_elements(elements);
+
+    if (elements.MM <= 0){return SATELLITE_VISIBILITY_PASSES;}
+
+    inclination = elements.IN;
+    if (inclination > (M_PI / 2.0)){inclination = M_PI - inclination;}  // retrograde
+    semi_major_axis = pow(GM / pow(elements.MM / 86400.0, 2), 1.0 / 3.0);
+    cos_horizon_central_angle = (RE / (semi_major_axis * (1.0 + elements.EC))) * cos(radians(SATELLITE_AOS_ELEVATION_MIN));
+    if (cos_horizon_central_angle >= 1.0){return SATELLITE_VISIBILITY_PASSES;}
+    horizon_central_angle = acos(cos_horizon_central_angle) - radians(SATELLITE_AOS_ELEVATION_MIN);
+
+    if (degrees(fabs(obs.LA) - inclination - horizon_central_angle) > margin){
+      return SATELLITE_VISIBILITY_NEVER;
+    }
+
+    if (fabs((elements.MM / WE) - 1.0) < 0.01){  // geostationary, or near enough
+      // eccentricity swings it up to 2e radians in longitude; elevation can change a bit faster than central angle
+      wander = (1.2 * degrees(inclination + (2.0 * elements.EC))) + margin;
+      if ((elevation_now - wander) > SATELLITE_AOS_ELEVATION_MIN){return SATELLITE_VISIBILITY_ALWAYS;}
+      if ((elevation_now + wander) < SATELLITE_AOS_ELEVATION_MIN){return SATELLITE_VISIBILITY_NEVER;}
+    }
+
+    return SATELLITE_VISIBILITY_PASSES;
+
+  }
+
+#endif //FEATURE_SATELLITE_TRACKING 
+
+//------------------------------------------------------
+#if defined(FEATURE_SATELLITE_TRACKING)
+
+  long satellite_calc_search_step(double max_angular_rate, byte in_pass){
+
+    // How many seconds we can step ahead from the last sat.predict() without jumping over a horizon crossing
+    // (see Satellite::horizon_step() in P13), within the search step limits
+
+    double step = sat.horizon_step(obs, max_angular_rate, SATELLITE_AOS_ELEVATION_MIN, in_pass);
+    long max_step = SATELLITE_CALC_SEARCH_MAX_STEP_SECS;
+
+    if (in_pass){
+      max_step = SATELLITE_CALC_IN_PASS_MAX_STEP_SECS;  // sample the pass often enough to catch the max elevation
+    }
+
+    if (step > max_step){return max_step;}
+    if (step < SATELLITE_CALC_SEARCH_MIN_STEP_SECS){return SATELLITE_CALC_SEARCH_MIN_STEP_SECS;}
+    return (long)step;
+
+  }
+
+#endif //FEATURE_SATELLITE_TRACKING 
+
 
 //------------------------------------------------------
 #if defined(FEATURE_SATELLITE_TRACKING)
@@ -20097,10 +23646,27 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
     #if defined(OPTION_USE_OLD_TIME_CODE)
     static tm temp_aos, temp_los;
     #else
-    static tmElements_t temp_aos, temp_los;
+    static time_t temp_aos, temp_los;
+    static time_t calc_start_time;
+    satellite_pass* last_pass;
     #endif
 
-    static byte increment_seconds;
+    static long pass_aos_time;            // the pass we're working on, in seconds from the start
+    static long pass_los_time;
+    static long pass_max_elevation_time;
+    static double pass_aos_az;
+    static double pass_los_az;
+
+    static long probe_time;               // seconds from the start of the calculation
+    static long calc_time_offset;         // where calc_years, calc_months, etc. currently are, in seconds from the start
+    static long bracket_low;              // last time on the near side of the horizon crossing we're looking for
+    static long bracket_high;             // first time found on the far side of it
+    static double bracket_low_el;
+    static double bracket_high_el;
+    static double bracket_high_az;
+    static double max_angular_rate;
+    static byte refine_iterations;
+    static unsigned int predictions;
 
     static byte stage_1_aos_and_los_collection_state;
       #define JUST_GETTING_STARTED 0
@@ -20112,17 +23678,16 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
 
     static byte calculation_stage_state;  
       #define FINISHED 0
-      #define STAGE_1_CALC 1
-      #define STAGE_2_CALC 2
-      #define STAGE_2_CALC_AOS 3
-      #define STAGE_2_CALC_LOS 4
-      #define STAGE_3_CALC 5
-      #define STAGE_3_CALC_AOS 6
-      #define STAGE_3_CALC_LOS 7      
+      #define SEARCH_CALC 1
+      #define REFINE_CALC 2
+      #define MAX_EL_CALC 3
       #define FINISH_UP 99
       
 
     byte pull_result = 0;
+    byte visibility;
+    byte in_aos = 0;
+    byte looking_for_los = 0;
 
 
     // #if !defined(DEBUG_SATELLITE_USE_OLD_OBSERVER_OBJECT)
@@ -20131,12 +23696,12 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
     //   obs.update_location("",latitude,longitude,altitude_m);
     // #endif
 
-    obs.update_location("",latitude,longitude,altitude_m);
-
     if (service_action == SERVICE_CALC_REPORT_STATE){return service_calc_satellite_data_service_state;}
 
     if (service_action == SERVICE_CALC_INITIALIZE){  // initialize calculation
 
+      obs.update_location("",latitude,longitude,altitude_m);
+
       calculation_start_time = millis();
 
       #if defined(DEBUG_SATELLITE_TRACKING_CALC)     
@@ -20148,6 +23713,9 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
           case UPDATE_SAT_ARRAY_SLOT_JUST_AZ_EL:
             debug.print(F("UPDATE_SAT_ARRAY_SLOT_JUST_AZ_EL"));
             break;                                    
+          case UPDATE_SAT_ARRAY_SLOT_NEXT_PASS:
+            debug.print(F("UPDATE_SAT_ARRAY_SLOT_NEXT_PASS"));
+            break;
         }
         debug.print(F(" sat:"));
         if (do_this_satellite >= SATELLITE_LIST_LENGTH){
@@ -20176,6 +23744,9 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
       progress_dots = 0;
       number_of_passes = run_this_many_passes;
       pass_max_elevation = 0;
+      pass_max_elevation_time = 0;
+      pass_aos_time = 0;
+      pass_los_time = 0;
       service_calc_satellite_data_task = do_this_task;
       print_header = do_this_print_header;
 
@@ -20190,7 +23761,8 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
 
       #else //OPTION_USE_OLD_TIME_CODE
 
-      time_t temp_t = now();
+      time_t temp_t = astro_now.epoch;
+      calc_start_time = temp_t;
 
       calc_years = year(temp_t);
       calc_months = month(temp_t);
@@ -20205,8 +23777,10 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
       stage_1_aos_and_los_collection_state = JUST_GETTING_STARTED;
       service_calc_satellite_data_service_state = SERVICE_CALC_IN_PROGRESS;
       service_calc_current_sat = do_this_satellite;
-      increment_seconds = SATELLITE_CALC_STAGE_1_RESOLUTION_SECS;
-      calculation_stage_state = STAGE_1_CALC;
+      probe_time = 0;
+      calc_time_offset = 0;
+      predictions = 0;
+      calculation_stage_state = SEARCH_CALC;
 
       
 
@@ -20215,12 +23789,12 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
           control_port->println(F("invalid satellite"));
           return 0;
         } else {                    // get the current satellite
-          pull_satellite_tle_and_activate(satellite[service_calc_current_sat].name,NOT_VERBOSE,DO_NOT_MAKE_IT_THE_CURRENT_SATELLITE);
+          load_satellite_from_element_cache(service_calc_current_sat);
         }
       }
 
       // calculate az and el for satellite in the array - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
-      if ((service_calc_satellite_data_task == UPDATE_SAT_ARRAY_SLOT_AZ_EL_NEXT_AOS_LOS) || (service_calc_satellite_data_task == UPDATE_SAT_ARRAY_SLOT_JUST_AZ_EL)){
+      if ((service_calc_satellite_data_task == UPDATE_SAT_ARRAY_SLOT_AZ_EL_NEXT_AOS_LOS) || (service_calc_satellite_data_task == UPDATE_SAT_ARRAY_SLOT_JUST_AZ_EL) || (service_calc_satellite_data_task == UPDATE_SAT_ARRAY_SLOT_NEXT_PASS)){
         if (service_calc_current_sat>= SATELLITE_LIST_LENGTH){
           #if defined(DEBUG_SATELLITE_TRACKING_CALC)
             debug.print(F("service_calc_satellite_data: exiting - invalid sat array position:"));
@@ -20230,39 +23804,72 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
           return 0;          
         }
         sat_datetime.settime(calc_years, calc_months, calc_days, calc_hours, calc_minutes, calc_seconds);
-        pull_result = pull_satellite_tle_and_activate(satellite[service_calc_current_sat].name,NOT_VERBOSE,DO_NOT_MAKE_IT_THE_CURRENT_SATELLITE);
+        pull_result = load_satellite_from_element_cache(service_calc_current_sat);
         if (pull_result == 1){
+          max_angular_rate = sat.max_ground_rate();
           sat.predict(sat_datetime);
           sat.LL(calc_satellite_latitude,calc_satellite_longitude);
           sat.altaz(obs, calc_satellite_elevation, calc_satellite_azimuth);  
-          satellite[service_calc_current_sat].azimuth = calc_satellite_azimuth;       
-          satellite[service_calc_current_sat].elevation = calc_satellite_elevation;
-          satellite[service_calc_current_sat].latitude = calc_satellite_latitude;
-          satellite[service_calc_current_sat].longitude = calc_satellite_longitude;  
-          if (current_satellite_position_in_array == service_calc_current_sat){
-            current_satellite_elevation = calc_satellite_elevation;
-            current_satellite_azimuth = calc_satellite_azimuth;
-            current_satellite_latitude = calc_satellite_latitude;
-            current_satellite_longitude = calc_satellite_longitude;                   
-          }
-        }
-        if (calc_satellite_elevation >= SATELLITE_AOS_ELEVATION_MIN){  // are we in AOS?
-          if ((satellite[service_calc_current_sat].status & 1) != 1){ // we were not in AOS before, set the state change flag
-            satellite[service_calc_current_sat].status = satellite[service_calc_current_sat].status | 4;
-          }
-          satellite[service_calc_current_sat].status = satellite[service_calc_current_sat].status | 1; // set AOS flag
-        } else { //no, we're in LOS
-          if ((satellite[service_calc_current_sat].status & 1) != 0){ // we were not in LOS before, set the state change flag
-            satellite[service_calc_current_sat].status = satellite[service_calc_current_sat].status | 4;
-          }
-          satellite[service_calc_current_sat].status = satellite[service_calc_current_sat].status & B11111110; // unset AOS flag
-        }             
+          update_satellite_array_slot_position(service_calc_current_sat,calc_satellite_elevation,calc_satellite_azimuth,calc_satellite_latitude,calc_satellite_longitude);
+        }
       }
       // END - calculate az and el for satellite in the array - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
 
       if (service_calc_satellite_data_task == UPDATE_SAT_ARRAY_SLOT_JUST_AZ_EL){  // No need to calculate next AOS/LOS, we end this session
         service_calc_satellite_data_service_state = SERVICE_IDLE;
       }
+
+      // don't bother searching for an AOS / LOS that can't happen - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+      if ((service_calc_satellite_data_service_state == SERVICE_CALC_IN_PROGRESS) && (service_calc_current_sat < SATELLITE_LIST_LENGTH)){
+        if ((service_calc_satellite_data_task == PRINT_AOS_LOS_MULTILINE_REPORT) || (service_calc_satellite_data_task == PRINT_AOS_LOS_TABULAR_REPORT)){
+          sat_datetime.settime(calc_years, calc_months, calc_days, calc_hours, calc_minutes, calc_seconds);
+          sat.predict(sat_datetime);
+          sat.altaz(obs, calc_satellite_elevation, calc_satellite_azimuth);
+        } else {
+          satellite[service_calc_current_sat].status = satellite[service_calc_current_sat].status & B11100111; // unset never / always visible flags
+        }
+        if ((pull_result == 1) || (service_calc_satellite_data_task == PRINT_AOS_LOS_MULTILINE_REPORT) || (service_calc_satellite_data_task == PRINT_AOS_LOS_TABULAR_REPORT)){
+          visibility = satellite_visibility(calc_satellite_elevation);
+          if (visibility != SATELLITE_VISIBILITY_PASSES){
+            service_calc_satellite_data_service_state = SERVICE_IDLE;
+            if ((service_calc_satellite_data_task == UPDATE_SAT_ARRAY_SLOT_AZ_EL_NEXT_AOS_LOS) || (service_calc_satellite_data_task == UPDATE_SAT_ARRAY_SLOT_NEXT_PASS)){
+              // same as a search that timed out, there's no AOS / LOS, but we know why
+              satellite[service_calc_current_sat].status = satellite[service_calc_current_sat].status | 2 | ((visibility == SATELLITE_VISIBILITY_NEVER) ? 8 : 16);
+            } else {
+              control_port->print(sat.name);
+              if (visibility == SATELLITE_VISIBILITY_NEVER){
+                control_port->println(F(": Never visible."));
+              } else {
+                control_port->println(F(": Always visible."));
+              }
+            }
+            #if defined(DEBUG_SATELLITE_TRACKING_CALC)
+              debug.print(F("service_calc_satellite_data: visibility:"));
+              debug.print(visibility);
+              debug.print(F(" "));
+              debug.println(satellite[service_calc_current_sat].name);
+            #endif
+            return 0;
+          }
+        }
+      }
+      // END - don't bother searching - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+
+      #if !defined(OPTION_USE_OLD_TIME_CODE)
+      if ((service_calc_satellite_data_task == UPDATE_SAT_ARRAY_SLOT_NEXT_PASS) && (service_calc_satellite_data_service_state == SERVICE_CALC_IN_PROGRESS)){
+        // pick up the search where the last pass in the table left off
+        last_pass = get_satellite_pass(service_calc_current_sat,satellite_pass_count[service_calc_current_sat]-1);
+        if (last_pass != NULL){
+          calc_start_time = last_pass->aos + last_pass->los + 1;
+          calc_years = year(calc_start_time);
+          calc_months = month(calc_start_time);
+          calc_days = day(calc_start_time);
+          calc_hours = hour(calc_start_time);
+          calc_minutes = minute(calc_start_time);
+          calc_seconds = second(calc_start_time);
+        }
+      }
+      #endif //OPTION_USE_OLD_TIME_CODE
       satellite[service_calc_current_sat].status = satellite[service_calc_current_sat].status & B11011111; // unset CALC_THROTTLE flag
       return 0; // exit for now, when we come back it's time to do some calculatin'
     } //if (service_action == SERVICE_CALC_INITIALIZE){  // initialize calculation
@@ -20272,12 +23879,12 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
     // Calculation Timeout - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
     if ((service_action == SERVICE_CALC_SERVICE) && (service_calc_satellite_data_service_state == SERVICE_CALC_IN_PROGRESS)){
       if ((millis() - calculation_start_time) > SATELLITE_CALC_TIMEOUT_MS){
-        if (service_calc_satellite_data_task != UPDATE_SAT_ARRAY_SLOT_AZ_EL_NEXT_AOS_LOS){
+        if ((service_calc_satellite_data_task != UPDATE_SAT_ARRAY_SLOT_AZ_EL_NEXT_AOS_LOS) && (service_calc_satellite_data_task != UPDATE_SAT_ARRAY_SLOT_NEXT_PASS)){
           control_port->print(sat.name);
           control_port->println(F(": No visible pass found."));
         }
         service_calc_satellite_data_service_state = SERVICE_IDLE;  // end this calculation
-        if (service_calc_satellite_data_task == UPDATE_SAT_ARRAY_SLOT_AZ_EL_NEXT_AOS_LOS){
+        if ((service_calc_satellite_data_task == UPDATE_SAT_ARRAY_SLOT_AZ_EL_NEXT_AOS_LOS) || (service_calc_satellite_data_task == UPDATE_SAT_ARRAY_SLOT_NEXT_PASS)){
           // tag this calculation as timing out
           satellite[service_calc_current_sat].status = satellite[service_calc_current_sat].status | 2;
           #if defined(DEBUG_SATELLITE_TRACKING_CALC)
@@ -20290,355 +23897,93 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
       // END - calculation timeout
 
       // Update a position in the satellite array  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
-      if (service_calc_satellite_data_task == UPDATE_SAT_ARRAY_SLOT_AZ_EL_NEXT_AOS_LOS){
-
-        if (calculation_stage_state == STAGE_1_CALC){
+      if ((service_calc_satellite_data_task == UPDATE_SAT_ARRAY_SLOT_AZ_EL_NEXT_AOS_LOS) || (service_calc_satellite_data_task == UPDATE_SAT_ARRAY_SLOT_NEXT_PASS)){
+
+        // Each pass through here does one prediction.  In SEARCH_CALC we step ahead as far as we safely can without
+        // jumping over a horizon crossing (see satellite_calc_search_step()) until we land on the far side of one, which
+        // gives us a bracket around it.  In REFINE_CALC we alternate secant and bisection steps inside the bracket
+        // (Satellite::crossing_probe()) until it's down to SATELLITE_CALC_RESOLUTION_SECS.  test/native/test_aos_los
+        // runs the same search on the PC.
+
+        if (calculation_stage_state == MAX_EL_CALC){
+          // passes are close to symmetric, so the middle of the pass is a better shot at the max elevation than the search samples
+          probe_time = (pass_aos_time + pass_los_time) / 2;
+          add_time(calc_years,calc_months,calc_days,calc_hours,calc_minutes,calc_seconds,0,(int)(probe_time - calc_time_offset),0);
+          calc_time_offset = probe_time;
+          sat_datetime.settime(calc_years, calc_months, calc_days, calc_hours, calc_minutes, calc_seconds);
+          sat.predict(sat_datetime);
+          sat.LL(calc_satellite_latitude,calc_satellite_longitude);
+          sat.altaz(obs, calc_satellite_elevation, calc_satellite_azimuth);
+          predictions++;
+          if (calc_satellite_elevation > pass_max_elevation){
+            pass_max_elevation = calc_satellite_elevation;
+            pass_max_elevation_time = probe_time;
+          }
+          if (service_calc_satellite_data_task == UPDATE_SAT_ARRAY_SLOT_AZ_EL_NEXT_AOS_LOS){
+            satellite[service_calc_current_sat].next_pass_max_el = (byte)pass_max_elevation;
+          }
+          calculation_stage_state = FINISH_UP;
+        } else if ((calculation_stage_state == SEARCH_CALC) || (calculation_stage_state == REFINE_CALC)){
+          if (calculation_stage_state == REFINE_CALC){
+            probe_time = Satellite::crossing_probe(bracket_low,bracket_low_el,bracket_high,bracket_high_el,SATELLITE_AOS_ELEVATION_MIN,refine_iterations);
+            refine_iterations++;
+          }
+          add_time(calc_years,calc_months,calc_days,calc_hours,calc_minutes,calc_seconds,0,(int)(probe_time - calc_time_offset),0);
+          calc_time_offset = probe_time;
           sat_datetime.settime(calc_years, calc_months, calc_days, calc_hours, calc_minutes, calc_seconds);
           sat.predict(sat_datetime);
           sat.LL(calc_satellite_latitude,calc_satellite_longitude);
           sat.altaz(obs, calc_satellite_elevation, calc_satellite_azimuth);
+          predictions++;
+
           if (calc_satellite_elevation >= SATELLITE_AOS_ELEVATION_MIN){
-            // in AOS
-            if (calc_satellite_elevation > pass_max_elevation){
+            in_aos = 1;
+            if ((calc_satellite_elevation > pass_max_elevation) && (stage_1_aos_and_los_collection_state != GOT_LOS_NEED_AOS)){  // (not the start of the next pass)
               pass_max_elevation = calc_satellite_elevation;
-            }              
-            if (stage_1_aos_and_los_collection_state == JUST_GETTING_STARTED){
+              pass_max_elevation_time = probe_time;
+            }
+          } else {
+            in_aos = 0;
+          }
+          if (stage_1_aos_and_los_collection_state == JUST_GETTING_STARTED){
+            if (in_aos){
               // we're in AOS already, we need to get LOS first, then AOS
               stage_1_aos_and_los_collection_state = GET_LOS_THEN_AOS;
-              //in_aos_right_now = 1;
-            }
-            if (!AOS){
-              if ((stage_1_aos_and_los_collection_state == GET_AOS_THEN_LOS) || (stage_1_aos_and_los_collection_state == GOT_LOS_NEED_AOS)){
-                temp_next_aos_az = calc_satellite_azimuth;
-                temp_next_aos_el = calc_satellite_elevation;  
-                #if defined(OPTION_USE_OLD_TIME_CODE)                 
-                temp_aos.year = calc_years;
-                temp_aos.month = calc_months;
-                temp_aos.day = calc_days;
-                temp_aos.hours = calc_hours;
-                temp_aos.minutes = calc_minutes;       
-                temp_aos.seconds = calc_seconds; 
-                #else //OPTION_USE_OLD_TIME_CODE
-                temp_aos.Year = calc_years-1970;
-                temp_aos.Month = calc_months;
-                temp_aos.Day = calc_days;
-                temp_aos.Hour = calc_hours;
-                temp_aos.Minute = calc_minutes;       
-                temp_aos.Second = calc_seconds; 
-                #endif //OPTION_USE_OLD_TIME_CODE          
-                if (stage_1_aos_and_los_collection_state == GET_AOS_THEN_LOS){
-                  stage_1_aos_and_los_collection_state = GOT_AOS_NEED_LOS;
-                } else {
-                  calculation_stage_state = STAGE_2_CALC;
-                  if (pass_max_elevation > satellite[service_calc_current_sat].next_pass_max_el){
-                    satellite[service_calc_current_sat].next_pass_max_el = (byte)pass_max_elevation;
-                  }
-                }
-              }
-              LOS = 0;
-              AOS = 1;
-              calculation_start_time = millis();
-            }
-          } else { //if (calc_satellite_elevation >= SATELLITE_AOS_ELEVATION_MIN){
-            // in LOS
-            if (stage_1_aos_and_los_collection_state == JUST_GETTING_STARTED){
+              pass_aos_time = probe_time;
+              pass_aos_az = calc_satellite_azimuth;
+            } else {
               // we're starting in LOS, so we get AOS then LOS
               stage_1_aos_and_los_collection_state = GET_AOS_THEN_LOS;
             }
-            if (!LOS){
-              if ((stage_1_aos_and_los_collection_state == GOT_AOS_NEED_LOS) || (stage_1_aos_and_los_collection_state == GET_LOS_THEN_AOS)){
-                temp_next_los_az = calc_satellite_azimuth;
-                temp_next_los_el = calc_satellite_elevation;  
-                #if defined(OPTION_USE_OLD_TIME_CODE)                
-                temp_los.year = calc_years;
-                temp_los.month = calc_months;
-                temp_los.day = calc_days;
-                temp_los.hours = calc_hours;
-                temp_los.minutes = calc_minutes;      
-                temp_los.seconds = calc_seconds;   
-                #else //OPTION_USE_OLD_TIME_CODE
-                temp_los.Year = calc_years-1970;
-                temp_los.Month = calc_months;
-                temp_los.Day = calc_days;
-                temp_los.Hour = calc_hours;
-                temp_los.Minute = calc_minutes;      
-                temp_los.Second = calc_seconds; 
-                #endif //OPTION_USE_OLD_TIME_CODE         
-                if (stage_1_aos_and_los_collection_state == GOT_AOS_NEED_LOS){
-                  calculation_stage_state = STAGE_2_CALC;
-                  satellite[service_calc_current_sat].next_pass_max_el = (byte)pass_max_elevation;
-                } else {
-                  stage_1_aos_and_los_collection_state = GOT_LOS_NEED_AOS; // got LOS first, will get AOS second next
-                }
-              }
-              LOS = 1;
-              AOS = 0;
-              calculation_start_time = millis();
-            }    
-          }  //if (calc_satellite_elevation >= SATELLITE_AOS_ELEVATION_MIN){
-          if (calculation_stage_state == STAGE_1_CALC){
-            add_time(calc_years,calc_months,calc_days,calc_hours,calc_minutes,calc_seconds,0,increment_seconds,0);
-          }
-        }  //if (calculation_stage_state == STAGE_1_CALC){
-
-        if (calculation_stage_state == STAGE_2_CALC){
-          #if defined(OPTION_USE_OLD_TIME_CODE) 
-          calc_years = temp_aos.year;
-          calc_months = temp_aos.month;
-          calc_days = temp_aos.day;
-          calc_hours = temp_aos.hours;
-          calc_minutes = temp_aos.minutes;       
-          calc_seconds = temp_aos.seconds; 
-          #else //OPTION_USE_OLD_TIME_CODE
-          calc_years = temp_aos.Year+1970;
-          calc_months = temp_aos.Month;
-          calc_days = temp_aos.Day;
-          calc_hours = temp_aos.Hour;
-          calc_minutes = temp_aos.Minute;       
-          calc_seconds = temp_aos.Second; 
-          #endif //OPTION_USE_OLD_TIME_CODE
-          // go back in time
-          #if defined(DEBUG_SATELLITE_TRACKING_CALC_STAGE_2)
-            debug.print(F("service_calc_satellite_data: STAGE_2_CALC 1:"));
-            debug.print(calc_years);
-            debug.print(F("-"));
-            debug.print(calc_months);
-            debug.print(F("-"));
-            debug.print(calc_days);
-            debug.print(F(" "));
-            debug.print(calc_hours);
-            debug.print(F(":"));
-            debug.print(calc_minutes);
-            debug.print(F(":"));
-            debug.println(calc_seconds); 
-          #endif         
-          // add_time(calc_years,calc_months,calc_days,calc_hours,calc_minutes,calc_seconds,0,-1*(SATELLITE_CALC_STAGE_1_RESOLUTION_SECS + (2*SATELLITE_CALC_STAGE_2_RESOLUTION_SECS)),0);
-          add_time(calc_years,calc_months,calc_days,calc_hours,calc_minutes,calc_seconds,0,-1*SATELLITE_CALC_STAGE_1_RESOLUTION_SECS,0);
-
-          #if defined(DEBUG_SATELLITE_TRACKING_CALC_STAGE_2)
-            debug.print(F("service_calc_satellite_data: STAGE_2_CALC 2:"));
-            debug.print(calc_years);
-            debug.print(F("-"));
-            debug.print(calc_months);
-            debug.print(F("-"));
-            debug.print(calc_days);
-            debug.print(F(" "));
-            debug.print(calc_hours);
-            debug.print(F(":"));
-            debug.print(calc_minutes);
-            debug.print(F(":"));
-            debug.println(calc_seconds); 
-          #endif            
-          increment_seconds = SATELLITE_CALC_STAGE_2_RESOLUTION_SECS;  // flip to high resolution, baby !
-          calculation_stage_state = STAGE_2_CALC_AOS; 
-          //calculation_stage_state = FINISH_UP;        
-        } //if (calculation_stage_state == STAGE_2_CALC){
-
-
-        if (calculation_stage_state == STAGE_2_CALC_AOS){
-          sat_datetime.settime(calc_years, calc_months, calc_days, calc_hours, calc_minutes, calc_seconds);
-          sat.predict(sat_datetime);
-          sat.LL(calc_satellite_latitude,calc_satellite_longitude);
-          sat.altaz(obs, calc_satellite_elevation, calc_satellite_azimuth);
-          if (calc_satellite_elevation >= SATELLITE_AOS_ELEVATION_MIN){  // have we found the AOS time?
-            temp_next_aos_az = calc_satellite_azimuth;
-            temp_next_aos_el = calc_satellite_elevation;   
-            #if defined(OPTION_USE_OLD_TIME_CODE)                 
-            temp_aos.year = calc_years;
-            temp_aos.month = calc_months;
-            temp_aos.day = calc_days;
-            temp_aos.hours = calc_hours;
-            temp_aos.minutes = calc_minutes;       
-            temp_aos.seconds = calc_seconds; 
-            #else //OPTION_USE_OLD_TIME_CODE
-            temp_aos.Year = calc_years-1970;
-            temp_aos.Month = calc_months;
-            temp_aos.Day = calc_days;
-            temp_aos.Hour = calc_hours;
-            temp_aos.Minute = calc_minutes;       
-            temp_aos.Second = calc_seconds; 
-            #endif //OPTION_USE_OLD_TIME_CODE
-            calculation_stage_state = STAGE_2_CALC_LOS; 
-            // get setup for stage 2 LOS calculation 
-            #if defined(OPTION_USE_OLD_TIME_CODE)
-            calc_years = temp_los.year;
-            calc_months = temp_los.month;
-            calc_days = temp_los.day;
-            calc_hours = temp_los.hours;
-            calc_minutes = temp_los.minutes;       
-            calc_seconds = temp_los.seconds; 
-            #else //OPTION_USE_OLD_TIME_CODE
-            calc_years = temp_los.Year+1970;
-            calc_months = temp_los.Month;
-            calc_days = temp_los.Day;
-            calc_hours = temp_los.Hour;
-            calc_minutes = temp_los.Minute;       
-            calc_seconds = temp_los.Second;
-            #endif //OPTION_USE_OLD_TIME_CODE
-            add_time(calc_years,calc_months,calc_days,calc_hours,calc_minutes,calc_seconds,0,-1*SATELLITE_CALC_STAGE_1_RESOLUTION_SECS,0);          
-            #if defined(DEBUG_SATELLITE_TRACKING_CALC_STAGE_2)
-              debug.print(F("service_calc_satellite_data: STAGE_2_CALC 3:"));
-              debug.print(calc_years);
-              debug.print(F("-"));
-              debug.print(calc_months);
-              debug.print(F("-"));
-              debug.print(calc_days);
-              debug.print(F(" "));
-              debug.print(calc_hours);
-              debug.print(F(":"));
-              debug.print(calc_minutes);
-              debug.print(F(":"));
-              debug.println(calc_seconds); 
-            #endif               
-          } else {
-            add_time(calc_years,calc_months,calc_days,calc_hours,calc_minutes,calc_seconds,0,increment_seconds,0);
           }
-        } //if (calculation_stage_state == STAGE_2_CALC_AOS){   
-
+          looking_for_los = ((stage_1_aos_and_los_collection_state == GOT_AOS_NEED_LOS) || (stage_1_aos_and_los_collection_state == GET_LOS_THEN_AOS));
 
-        if (calculation_stage_state == STAGE_2_CALC_LOS){
-          sat_datetime.settime(calc_years, calc_months, calc_days, calc_hours, calc_minutes, calc_seconds);
-          sat.predict(sat_datetime);
-          sat.LL(calc_satellite_latitude,calc_satellite_longitude);
-          sat.altaz(obs, calc_satellite_elevation, calc_satellite_azimuth);
-          if (calc_satellite_elevation < SATELLITE_AOS_ELEVATION_MIN){  // have we found th LOS time?
-            temp_next_los_az = calc_satellite_azimuth;
-            temp_next_los_el = calc_satellite_elevation; 
-            #if defined(OPTION_USE_OLD_TIME_CODE)                  
-            temp_los.year = calc_years;
-            temp_los.month = calc_months;
-            temp_los.day = calc_days;
-            temp_los.hours = calc_hours;
-            temp_los.minutes = calc_minutes;       
-            temp_los.seconds = calc_seconds; 
-            #else //OPTION_USE_OLD_TIME_CODE
-            temp_los.Year = calc_years-1970;
-            temp_los.Month = calc_months;
-            temp_los.Day = calc_days;
-            temp_los.Hour = calc_hours;
-            temp_los.Minute = calc_minutes;       
-            temp_los.Second = calc_seconds; 
-            #endif //OPTION_USE_OLD_TIME_CODE
-            calculation_stage_state = STAGE_3_CALC;  
-            #if defined(DEBUG_SATELLITE_TRACKING_CALC_STAGE_2)
-              debug.print(F("service_calc_satellite_data: STAGE_2_CALC 3:"));
-              debug.print(calc_years);
-              debug.print(F("-"));
-              debug.print(calc_months);
-              debug.print(F("-"));
-              debug.print(calc_days);
-              debug.print(F(" "));
-              debug.print(calc_hours);
-              debug.print(F(":"));
-              debug.print(calc_minutes);
-              debug.print(F(":"));
-              debug.println(calc_seconds); 
-            #endif               
+          if (in_aos != looking_for_los){  // on the far side of the crossing we're looking for
+            bracket_high = probe_time;
+            bracket_high_el = calc_satellite_elevation;
+            bracket_high_az = calc_satellite_azimuth;
+            if (calculation_stage_state == SEARCH_CALC){
+              calculation_stage_state = REFINE_CALC;
+              refine_iterations = 0;
+            }
           } else {
-            add_time(calc_years,calc_months,calc_days,calc_hours,calc_minutes,calc_seconds,0,increment_seconds,0);
-          }
-        } //if (calculation_stage_state == STAGE_2_CALC_LOS){  
-
-        // The code below needs to be refactored sometime and combined with the STAGE_2 code above.  
-        // It does exactly the same thing as stage 2, it just uses a different time increment
-        // I think I've easily burned up 200 hours working on this satellite code and I need a break after I got it all working.
-
-        if (calculation_stage_state == STAGE_3_CALC){
-          #if defined(OPTION_USE_OLD_TIME_CODE) 
-          calc_years = temp_aos.year;
-          calc_months = temp_aos.month;
-          calc_days = temp_aos.day;
-          calc_hours = temp_aos.hours;
-          calc_minutes = temp_aos.minutes;       
-          calc_seconds = temp_aos.seconds; 
-          #else //OPTION_USE_OLD_TIME_CODE
-          calc_years = temp_aos.Year+1970;          
-          calc_months = temp_aos.Month;
-          calc_days = temp_aos.Day;
-          calc_hours = temp_aos.Hour;
-          calc_minutes = temp_aos.Minute;       
-          calc_seconds = temp_aos.Second; 
-          #endif //OPTION_USE_OLD_TIME_CODE
-          // go back in time
-          #if defined(DEBUG_SATELLITE_TRACKING_CALC_STAGE_3)
-            debug.print(F("service_calc_satellite_data: STAGE_3_CALC 1:"));
-            debug.print(calc_years);
-            debug.print(F("-"));
-            debug.print(calc_months);
-            debug.print(F("-"));
-            debug.print(calc_days);
-            debug.print(F(" "));
-            debug.print(calc_hours);
-            debug.print(F(":"));
-            debug.print(calc_minutes);
-            debug.print(F(":"));
-            debug.println(calc_seconds); 
-          #endif         
-          add_time(calc_years,calc_months,calc_days,calc_hours,calc_minutes,calc_seconds,0,-1*SATELLITE_CALC_STAGE_2_RESOLUTION_SECS,0);
-
-          #if defined(DEBUG_SATELLITE_TRACKING_CALC_STAGE_3)
-            debug.print(F("service_calc_satellite_data: STAGE_3_CALC 2:"));
-            debug.print(calc_years);
-            debug.print(F("-"));
-            debug.print(calc_months);
-            debug.print(F("-"));
-            debug.print(calc_days);
-            debug.print(F(" "));
-            debug.print(calc_hours);
-            debug.print(F(":"));
-            debug.print(calc_minutes);
-            debug.print(F(":"));
-            debug.println(calc_seconds); 
-          #endif            
-          increment_seconds = SATELLITE_CALC_STAGE_3_RESOLUTION_SECS;  // flip to even higher resolution, baby !
-          calculation_stage_state = STAGE_3_CALC_AOS; 
-          //calculation_stage_state = FINISH_UP;        
-        } //if (calculation_stage_state == STAGE_3_CALC){
-
-
-        if (calculation_stage_state == STAGE_3_CALC_AOS){
-          sat_datetime.settime(calc_years, calc_months, calc_days, calc_hours, calc_minutes, calc_seconds);
-          sat.predict(sat_datetime);
-          sat.LL(calc_satellite_latitude,calc_satellite_longitude);
-          sat.altaz(obs, calc_satellite_elevation, calc_satellite_azimuth);
-          if (calc_satellite_elevation >= SATELLITE_AOS_ELEVATION_MIN){  // have we found the AOS time?
-            temp_next_aos_az = calc_satellite_azimuth;
-            temp_next_aos_el = calc_satellite_elevation; 
-            #if defined(OPTION_USE_OLD_TIME_CODE)                  
-            temp_aos.year = calc_years;
-            temp_aos.month = calc_months;
-            temp_aos.day = calc_days;
-            temp_aos.hours = calc_hours;
-            temp_aos.minutes = calc_minutes;       
-            temp_aos.seconds = calc_seconds; 
-            #else //OPTION_USE_OLD_TIME_CODE
-            temp_aos.Year = calc_years-1970;
-            temp_aos.Month = calc_months;
-            temp_aos.Day = calc_days;
-            temp_aos.Hour = calc_hours;
-            temp_aos.Minute = calc_minutes;       
-            temp_aos.Second = calc_seconds; 
-            #endif  //OPTION_USE_OLD_TIME_CODE
-            calculation_stage_state = STAGE_3_CALC_LOS; 
-            // get setup for stage 3 LOS calculation 
-            #if defined(OPTION_USE_OLD_TIME_CODE) 
-            calc_years = temp_los.year;
-            calc_months = temp_los.month;
-            calc_days = temp_los.day;
-            calc_hours = temp_los.hours;
-            calc_minutes = temp_los.minutes;       
-            calc_seconds = temp_los.seconds; 
-            #else //OPTION_USE_OLD_TIME_CODE
-            calc_years = temp_los.Year+1970;
-            calc_months = temp_los.Month;
-            calc_days = temp_los.Day;
-            calc_hours = temp_los.Hour;
-            calc_minutes = temp_los.Minute;       
-            calc_seconds = temp_los.Second;
-            #endif //OPTION_USE_OLD_TIME_CODE
-            add_time(calc_years,calc_months,calc_days,calc_hours,calc_minutes,calc_seconds,0,-1*SATELLITE_CALC_STAGE_2_RESOLUTION_SECS,0);          
-            #if defined(DEBUG_SATELLITE_TRACKING_CALC_STAGE_3)
-              debug.print(F("service_calc_satellite_data: STAGE_3_CALC 3:"));
+            bracket_low = probe_time;
+            bracket_low_el = calc_satellite_elevation;
+          }
+
+          if (calculation_stage_state == SEARCH_CALC){
+            probe_time = probe_time + satellite_calc_search_step(max_angular_rate,in_aos);
+          } else if ((bracket_high - bracket_low) <= SATELLITE_CALC_RESOLUTION_SECS){
+            // found it - bracket_high is the first second on the far side of the crossing
+            add_time(calc_years,calc_months,calc_days,calc_hours,calc_minutes,calc_seconds,0,(int)(bracket_high - calc_time_offset),0);
+            calc_time_offset = bracket_high;
+            #if defined(DEBUG_SATELLITE_TRACKING_CALC_SEARCH)
+              debug.print(F("service_calc_satellite_data: "));
+              if (looking_for_los){
+                debug.print(F("LOS:"));
+              } else {
+                debug.print(F("AOS:"));
+              }
               debug.print(calc_years);
               debug.print(F("-"));
               debug.print(calc_months);
@@ -20649,95 +23994,106 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
               debug.print(F(":"));
               debug.print(calc_minutes);
               debug.print(F(":"));
-              debug.println(calc_seconds); 
-            #endif               
-          } else {
-            add_time(calc_years,calc_months,calc_days,calc_hours,calc_minutes,calc_seconds,0,increment_seconds,0);
+              debug.print(calc_seconds);
+              debug.print(F(" predictions:"));
+              debug.print(predictions);
+              debug.println("");
+            #endif
+            if (!looking_for_los){
+              temp_next_aos_az = bracket_high_az;
+              temp_next_aos_el = bracket_high_el;
+              #if defined(OPTION_USE_OLD_TIME_CODE)
+              temp_aos.year = calc_years;
+              temp_aos.month = calc_months;
+              temp_aos.day = calc_days;
+              temp_aos.hours = calc_hours;
+              temp_aos.minutes = calc_minutes;
+              temp_aos.seconds = calc_seconds;
+              #else //OPTION_USE_OLD_TIME_CODE
+              temp_aos = calc_start_time + bracket_high;
+              #endif //OPTION_USE_OLD_TIME_CODE
+              if (stage_1_aos_and_los_collection_state == GET_AOS_THEN_LOS){
+                stage_1_aos_and_los_collection_state = GOT_AOS_NEED_LOS;
+                pass_aos_time = bracket_high;
+                pass_aos_az = bracket_high_az;
+              } else {
+                calculation_stage_state = FINISH_UP;
+                if (pass_max_elevation > satellite[service_calc_current_sat].next_pass_max_el){
+                  satellite[service_calc_current_sat].next_pass_max_el = (byte)pass_max_elevation;
+                }
+              }
+            } else {
+              temp_next_los_az = bracket_high_az;
+              temp_next_los_el = bracket_high_el;
+              #if defined(OPTION_USE_OLD_TIME_CODE)
+              temp_los.year = calc_years;
+              temp_los.month = calc_months;
+              temp_los.day = calc_days;
+              temp_los.hours = calc_hours;
+              temp_los.minutes = calc_minutes;
+              temp_los.seconds = calc_seconds;
+              #else //OPTION_USE_OLD_TIME_CODE
+              temp_los = calc_start_time + bracket_high;
+              #endif //OPTION_USE_OLD_TIME_CODE
+              pass_los_time = bracket_high;
+              pass_los_az = bracket_high_az;
+              if (stage_1_aos_and_los_collection_state == GOT_AOS_NEED_LOS){
+                calculation_stage_state = MAX_EL_CALC;
+              } else {
+                if (service_calc_satellite_data_task == UPDATE_SAT_ARRAY_SLOT_NEXT_PASS){
+                  calculation_stage_state = FINISH_UP;  // the pass was already underway, that's all we need
+                } else {
+                  stage_1_aos_and_los_collection_state = GOT_LOS_NEED_AOS; // got LOS first, will get AOS second next
+                }
+              }
+            }
+            if (calculation_stage_state == REFINE_CALC){
+              // go look for the other crossing, starting from this one
+              bracket_low = bracket_high;
+              bracket_low_el = bracket_high_el;
+              probe_time = bracket_high + SATELLITE_CALC_SEARCH_MIN_STEP_SECS;
+              calculation_stage_state = SEARCH_CALC;
+            }
+            calculation_start_time = millis();
           }
-        } //if (calculation_stage_state == STAGE_3_CALC_AOS){   
+        } //if ((calculation_stage_state == SEARCH_CALC) || (calculation_stage_state == REFINE_CALC)){
 
+        if (calculation_stage_state == FINISH_UP){
+          #if !defined(OPTION_USE_OLD_TIME_CODE)
+          if ((service_calc_satellite_data_task == UPDATE_SAT_ARRAY_SLOT_NEXT_PASS) || (satellite_pass_count[service_calc_current_sat] == 0)){
+            add_satellite_pass(service_calc_current_sat,calc_start_time + pass_aos_time,pass_los_time - pass_aos_time,pass_max_elevation_time - pass_aos_time,pass_aos_az,pass_los_az,pass_max_elevation);
+          }
+          #endif //OPTION_USE_OLD_TIME_CODE
 
-        if (calculation_stage_state == STAGE_3_CALC_LOS){
-          sat_datetime.settime(calc_years, calc_months, calc_days, calc_hours, calc_minutes, calc_seconds);
-          sat.predict(sat_datetime);
-          sat.LL(calc_satellite_latitude,calc_satellite_longitude);
-          sat.altaz(obs, calc_satellite_elevation, calc_satellite_azimuth);
-          if (calc_satellite_elevation < SATELLITE_AOS_ELEVATION_MIN){  // have we found th LOS time?
-            temp_next_los_az = calc_satellite_azimuth;
-            temp_next_los_el = calc_satellite_elevation;  
-            #if defined(OPTION_USE_OLD_TIME_CODE)                  
-            temp_los.year = calc_years;
-            temp_los.month = calc_months;
-            temp_los.day = calc_days;
-            temp_los.hours = calc_hours;
-            temp_los.minutes = calc_minutes;       
-            temp_los.seconds = calc_seconds; 
+          if (service_calc_satellite_data_task == UPDATE_SAT_ARRAY_SLOT_AZ_EL_NEXT_AOS_LOS){
+            #if defined(OPTION_USE_OLD_TIME_CODE)
+            satellite[service_calc_current_sat].next_aos.year = temp_aos.year;
+            satellite[service_calc_current_sat].next_aos.month = temp_aos.month;
+            satellite[service_calc_current_sat].next_aos.day = temp_aos.day;
+            satellite[service_calc_current_sat].next_aos.hours = temp_aos.hours;
+            satellite[service_calc_current_sat].next_aos.minutes = temp_aos.minutes;
+            satellite[service_calc_current_sat].next_aos.seconds = temp_aos.seconds;
+            satellite[service_calc_current_sat].next_aos_az = temp_next_aos_az;
+            satellite[service_calc_current_sat].next_los.year = temp_los.year;
+            satellite[service_calc_current_sat].next_los.month = temp_los.month;
+            satellite[service_calc_current_sat].next_los.day = temp_los.day;
+            satellite[service_calc_current_sat].next_los.hours = temp_los.hours;
+            satellite[service_calc_current_sat].next_los.minutes = temp_los.minutes;
+            satellite[service_calc_current_sat].next_los.seconds = temp_los.seconds;
             #else //OPTION_USE_OLD_TIME_CODE
-            temp_los.Year = calc_years-1970;
-            temp_los.Month = calc_months;
-            temp_los.Day = calc_days;
-            temp_los.Hour = calc_hours;
-            temp_los.Minute = calc_minutes;       
-            temp_los.Second = calc_seconds; 
+            satellite[service_calc_current_sat].next_aos = temp_aos;
+            satellite[service_calc_current_sat].next_aos_az = temp_next_aos_az;
+            satellite[service_calc_current_sat].next_los = temp_los;
+            place_satellite_in_order(service_calc_current_sat);
             #endif //OPTION_USE_OLD_TIME_CODE
-            calculation_stage_state = FINISH_UP;  
-            #if defined(DEBUG_SATELLITE_TRACKING_CALC_STAGE_3)
-              debug.print(F("service_calc_satellite_data: STAGE_3_CALC 3:"));
-              debug.print(calc_years);
-              debug.print(F("-"));
-              debug.print(calc_months);
-              debug.print(F("-"));
-              debug.print(calc_days);
-              debug.print(F(" "));
-              debug.print(calc_hours);
-              debug.print(F(":"));
-              debug.print(calc_minutes);
-              debug.print(F(":"));
-              debug.println(calc_seconds); 
-            #endif               
-          } else {
-            add_time(calc_years,calc_months,calc_days,calc_hours,calc_minutes,calc_seconds,0,increment_seconds,0);
-          }
-        } //if (calculation_stage_state == STAGE_3_CALC_LOS){  
-
-        if (calculation_stage_state == FINISH_UP){
-          #if defined(OPTION_USE_OLD_TIME_CODE)
-          satellite[service_calc_current_sat].next_aos.year = temp_aos.year;
-          satellite[service_calc_current_sat].next_aos.month = temp_aos.month;
-          satellite[service_calc_current_sat].next_aos.day = temp_aos.day;
-          satellite[service_calc_current_sat].next_aos.hours = temp_aos.hours;
-          satellite[service_calc_current_sat].next_aos.minutes = temp_aos.minutes;
-          satellite[service_calc_current_sat].next_aos.seconds = temp_aos.seconds;
-          satellite[service_calc_current_sat].next_aos_az = temp_next_aos_az;
-          satellite[service_calc_current_sat].next_los.year = temp_los.year;
-          satellite[service_calc_current_sat].next_los.month = temp_los.month;
-          satellite[service_calc_current_sat].next_los.day = temp_los.day;
-          satellite[service_calc_current_sat].next_los.hours = temp_los.hours;
-          satellite[service_calc_current_sat].next_los.minutes = temp_los.minutes;
-          satellite[service_calc_current_sat].next_los.seconds = temp_los.seconds;
-          #else //OPTION_USE_OLD_TIME_CODE
-          satellite[service_calc_current_sat].next_aos.Year = temp_aos.Year;
-          satellite[service_calc_current_sat].next_aos.Month = temp_aos.Month;
-          satellite[service_calc_current_sat].next_aos.Day = temp_aos.Day;
-          satellite[service_calc_current_sat].next_aos.Hour = temp_aos.Hour;
-          satellite[service_calc_current_sat].next_aos.Minute = temp_aos.Minute;
-          satellite[service_calc_current_sat].next_aos.Second = temp_aos.Second;
-          satellite[service_calc_current_sat].next_aos_az = temp_next_aos_az;
-          satellite[service_calc_current_sat].next_los.Year = temp_los.Year;
-          satellite[service_calc_current_sat].next_los.Month = temp_los.Month;
-          satellite[service_calc_current_sat].next_los.Day = temp_los.Day;
-          satellite[service_calc_current_sat].next_los.Hour = temp_los.Hour;
-          satellite[service_calc_current_sat].next_los.Minute = temp_los.Minute;
-          satellite[service_calc_current_sat].next_los.Second = temp_los.Second;
-
-          #endif //OPTION_USE_OLD_TIME_CODE
-          satellite[service_calc_current_sat].next_los_az = temp_next_los_az;
+            satellite[service_calc_current_sat].next_los_az = temp_next_los_az;
 
-          if (service_calc_current_sat== current_satellite_position_in_array){
-            current_satellite_next_aos_az = temp_next_aos_az;
-            current_satellite_next_aos_el = temp_next_aos_el;  
-            current_satellite_next_los_az = temp_next_los_az;
-            current_satellite_next_los_el = temp_next_los_el;
+            if (service_calc_current_sat== current_satellite_position_in_array){
+              current_satellite_next_aos_az = temp_next_aos_az;
+              current_satellite_next_aos_el = temp_next_aos_el;  
+              current_satellite_next_los_az = temp_next_los_az;
+              current_satellite_next_los_el = temp_next_los_el;
+            }
           }
 
           calculation_stage_state = FINISHED;
@@ -20747,9 +24103,9 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
             debug.print(F("service_calc_satellite_data: "));
             debug.print(F(" Sat:"));
             debug.print(sat.name);
-            debug.print(F(" Resolution:"));
-            debug.print(increment_seconds);
-            debug.print(F("s   exec_time:"));
+            debug.print(F(" Predictions:"));
+            debug.print(predictions);
+            debug.print(F("   exec_time:"));
             debug.print((millis()-calculation_start_time));
             debug.println(F("mS"));
           #endif
@@ -20757,7 +24113,7 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
         } // if (calculation_stage_state == FINISH_UP){
           
 
-      } // if (service_calc_satellite_data_task == UPDATE_SAT_ARRAY_SLOT_AZ_EL_NEXT_AOS_LOS){
+      } // if ((service_calc_satellite_data_task == UPDATE_SAT_ARRAY_SLOT_AZ_EL_NEXT_AOS_LOS) || (service_calc_satellite_data_task == UPDATE_SAT_ARRAY_SLOT_NEXT_PASS)){
 
 
 
@@ -20964,14 +24320,9 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
   }
 #else //defined(OPTION_USE_OLD_TIME_CODE)
 
-  void cleartime(tmElements_t * time1){
+  void cleartime(time_t * time1){
 
-    time1->Year = 0;
-    time1->Month = 0;
-    time1->Day = 0;
-    time1->Hour = 0;
-    time1->Minute = 0;
-    time1->Second = 0;
+    *time1 = 0;
 
   }
 
@@ -21018,43 +24369,19 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
   }
 #else //#if defined(OPTION_USE_OLD_TIME_CODE) -----------------
 
-  long difftime(tmElements_t * time1,tmElements_t * time2,int* days_diff,int* hours_diff,int* minutes_diff,int* seconds_diff){
+  long difftime(time_t * time1,time_t * time2,int* days_diff,int* hours_diff,int* minutes_diff,int* seconds_diff){
 
     // this is   time1   - time2
     //         <future>    <now>
-    //
-    // This subroutine only works for dates that are in consecutive months
-    // Beyond that some heavy math is required, but it's not needed here
-
-
-    //TODO: rewrite using TimeLib niceties
-
-    int days_diff_days = 0;
 
-    if (time1->Month == time2->Month){ 
-      days_diff_days =  time1->Day - time2->Day;
-    } else {
-      days_diff_days = days_in_month(time2->Month,time2->Year) - time2->Day + time1->Day;
-    }
-  
-    double total_diff_secs = (((double)time1->Second - (double)time2->Second) 
-                            + ((double)time1->Minute - (double)time2->Minute) * (double)60 
-                            + ((double)time1->Hour - (double)time2->Hour) * (double)3600 
-                            + ((double)days_diff_days * (double)86400));
-    
+    long total_diff_secs = *time1 - *time2;
 
-    *days_diff = int((double)total_diff_secs/((double)86400));
-    total_diff_secs = total_diff_secs - ((double)*days_diff * (double)86400);
-    *hours_diff = int((double)total_diff_secs/((double)3600));
-    total_diff_secs = total_diff_secs - ((double)*hours_diff * (double)3600);
-    *minutes_diff = int((double)total_diff_secs/(double)(60));
-    total_diff_secs = total_diff_secs - ((double)*minutes_diff * (double)60);  
-    *seconds_diff = total_diff_secs;
+    *days_diff = total_diff_secs / 86400L;
+    *hours_diff = (total_diff_secs % 86400L) / 3600L;
+    *minutes_diff = (total_diff_secs % 3600L) / 60L;
+    *seconds_diff = total_diff_secs % 60L;
 
-    return(((double)time1->Second - (double)time2->Second) 
-                            + ((double)time1->Minute - (double)time2->Minute) * (double)60 
-                            + ((double)time1->Hour - (double)time2->Hour) * (double)3600 
-                            + ((double)days_diff_days * (double)86400));
+    return total_diff_secs;
 
   }
 
@@ -21084,18 +24411,18 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
 
 #else //#if defined(OPTION_USE_OLD_TIME_CODE)
 
-  char* tm_month_and_day_string(tmElements_t * time1){
+  char* tm_month_and_day_string(time_t * time1){
 
-    static char tempstring[3];
+    static char tempstring[6];
     char tempstring2[3];
 
     strcpy(tempstring,"");
-    if (time1->Month < 10){strcat(tempstring,"0");}
-    dtostrf(time1->Month,0,0,tempstring2);
+    if (month(*time1) < 10){strcat(tempstring,"0");}
+    dtostrf(month(*time1),0,0,tempstring2);
     strcat(tempstring,tempstring2);
     strcat(tempstring,"-");
-    if (time1->Day < 10){strcat(tempstring,"0");}
-    dtostrf(time1->Day,0,0,tempstring2);
+    if (day(*time1) < 10){strcat(tempstring,"0");}
+    dtostrf(day(*time1),0,0,tempstring2);
     strcat(tempstring,tempstring2);
     return tempstring;
 
@@ -21131,25 +24458,25 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
 
 #else //#if defined(OPTION_USE_OLD_TIME_CODE)
 
-  char* tm_date_string(tmElements_t * time1){
+  char* tm_date_string(time_t * time1){
 
     static char tempstring[11];
     char tempstring2[5];
 
-    strcpy(tempstring,"");
-    if (time1->Year == 0){
-      strcat(tempstring,"0000");
-    } else {
-      dtostrf((time1->Year+1970),0,0,tempstring2);
+    if (*time1 == 0){
+      strcpy(tempstring,"0000-00-00");
+      return tempstring;
     }
+    strcpy(tempstring,"");
+    dtostrf(year(*time1),0,0,tempstring2);
     strcat(tempstring,tempstring2);
     strcat(tempstring,"-");
-    if (time1->Month < 10){strcat(tempstring,"0");}
-    dtostrf(time1->Month,0,0,tempstring2);
+    if (month(*time1) < 10){strcat(tempstring,"0");}
+    dtostrf(month(*time1),0,0,tempstring2);
     strcat(tempstring,tempstring2);
     strcat(tempstring,"-");
-    if (time1->Day < 10){strcat(tempstring,"0");}
-    dtostrf(time1->Day,0,0,tempstring2);
+    if (day(*time1) < 10){strcat(tempstring,"0");}
+    dtostrf(day(*time1),0,0,tempstring2);
     strcat(tempstring,tempstring2);
     return tempstring;
 
@@ -21178,18 +24505,18 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
 
 #else //#if defined(OPTION_USE_OLD_TIME_CODE) -----
 
-  char* tm_time_string_short(tmElements_t * time1){
+  char* tm_time_string_short(time_t * time1){
 
     static char tempstring[6];
     char tempstring2[3];
 
     strcpy(tempstring,"");
-    if (time1->Hour < 10){strcat(tempstring,"0");}
-    dtostrf(time1->Hour,0,0,tempstring2);
+    if (hour(*time1) < 10){strcat(tempstring,"0");}
+    dtostrf(hour(*time1),0,0,tempstring2);
     strcat(tempstring,tempstring2);
     strcat(tempstring,":");
-    if (time1->Minute < 10){strcat(tempstring,"0");}
-    dtostrf(time1->Minute,0,0,tempstring2);
+    if (minute(*time1) < 10){strcat(tempstring,"0");}
+    dtostrf(minute(*time1),0,0,tempstring2);
     strcat(tempstring,tempstring2);
     return tempstring;
   }
@@ -21222,22 +24549,22 @@ void convert_polar_to_cartesian(byte coordinate_conversion,double azimuth_in,dou
 
 #else //#if defined(OPTION_USE_OLD_TIME_CODE) ------
 
-  char* tm_time_string_long(tmElements_t * time1){
+  char* tm_time_string_long(time_t * time1){
 
-    static char tempstring[6];
+    static char tempstring[9];
     char tempstring2[3];
 
     strcpy(tempstring,"");
-    if (time1->Hour < 10){strcat(tempstring,"0");}
-    dtostrf(time1->Hour,0,0,tempstring2);
+    if (hour(*time1) < 10){strcat(tempstring,"0");}
+    dtostrf(hour(*time1),0,0,tempstring2);
     strcat(tempstring,tempstring2);
     strcat(tempstring,":");
-    if (time1->Minute < 10){strcat(tempstring,"0");}
-    dtostrf(time1->Minute,0,0,tempstring2);
+    if (minute(*time1) < 10){strcat(tempstring,"0");}
+    dtostrf(minute(*time1),0,0,tempstring2);
     strcat(tempstring,tempstring2);
     strcat(tempstring,":");
-    if (time1->Second < 10){strcat(tempstring,"0");}
-    dtostrf(time1->Second,0,0,tempstring2);
+    if (second(*time1) < 10){strcat(tempstring,"0");}
+    dtostrf(second(*time1),0,0,tempstring2);
     strcat(tempstring,tempstring2);    
     return tempstring;
   }
@@ -21298,7 +24625,7 @@ void send_vt100_code(char* code_to_send){
     for (int x = 0;x < SATELLITE_LIST_LENGTH;x++){
       if ((satellite[x].status != 255) && (strlen(satellite[x].name) > 2)){
         satellite[x].next_pass_max_el = 0;
-        satellite[x].status = satellite[x].status & B11111000; // clear aos (1), timeout (2), and AOS/LOS state change (4) flags
+        satellite[x].status = satellite[x].status & B11100000; // clear aos (1), timeout (2), AOS/LOS state change (4), and never / always visible (8, 16) flags
         cleartime(&satellite[x].next_aos);
         cleartime(&satellite[x].next_los);
         satellite[x].azimuth = 0;
@@ -21309,7 +24636,16 @@ void send_vt100_code(char* code_to_send){
         satellite[x].latitude = 0; 
         satellite[x].order = 254;  // 254 = valid slot, but no order placed on it yet             
       }
+      #if !defined(OPTION_USE_OLD_TIME_CODE)
+        clear_satellite_passes(x);
+        clear_satellite_refresh_schedule(x);
+      #endif
     }            
+
+    #if !defined(OPTION_USE_OLD_TIME_CODE)
+      clear_satellite_track();
+      update_satellite_array_order();
+    #endif
             
   }
 #endif //FEATURE_SATELLITE_TRACKING
@@ -0,0 +1,553 @@
+#!/usr/bin/env python3
+#
+# astro_reference.py
+#
+# Work out the reference azimuths and elevations for the native astro tests (test/native/test_astro) with code
+# written separately from the libraries under test, and write them out as test/native/test_astro/astro_reference.h
+#
+#   python3 astro_reference.py ../test_astro/astro_reference.h
+#
+#   sun        Meeus, Astronomical Algorithms 2nd ed., chapter 25 (low accuracy, about 0.01 degree)
+#   moon       Meeus chapter 47 (ELP-2000/82 truncated, about 10" in longitude, 4" in latitude)
+#   nutation   Meeus chapter 22 (low accuracy, 0.5")
+#   sidereal   Meeus chapter 12 (IAU 1982)
+#   satellite  SGP4 as in Spacetrack Report #3 (WGS-72), TEME to earth fixed with GMST, no polar motion
+#
+# Each one is checked against the worked examples in the books (Meeus 25.a, 47.a, 12.a and the Report #3 SGP4
+# test case) before anything is written, so a typo in a coefficient stops the script rather than ending up in the
+# tests.  Positions are topocentric, from the WGS-84 ellipsoid, and geometric: no refraction, which none of the
+# libraries apply either.
+#
+# No third party packages needed, plain python 3.
+
+import sys
+from math import sin, cos, tan, asin, atan2, sqrt, radians, degrees, fmod, pi, floor, hypot
+
+TWOPI = 2 * pi
+
+# ---------------------------------------------------------------- time
+
+
+def julian_day(year, month, day, hour=0, minute=0, second=0.0):
+    # Meeus 7.1, Gregorian calendar
+    if month <= 2:
+        year -= 1
+        month += 12
+    a = floor(year / 100)
+    b = 2 - a + floor(a / 4)
+    return (floor(365.25 * (year + 4716)) + floor(30.6001 * (month + 1)) + day + b - 1524.5 +
+            (hour + (minute + second / 60.0) / 60.0) / 24.0)
+
+
+def delta_t(year):
+    # TT - UT in seconds, IERS values, close enough either side (1 s is 0.00015 degree of moon)
+    table = ((2008, 65.5), (2020, 69.4), (2022, 69.2), (2026, 69.1), (2030, 70.0))
+    for y, dt in table:
+        if year <= y:
+            return dt
+    return table[-1][1]
+
+
+def gmst(jd_ut):
+    # Meeus 12.4, degrees
+    t = (jd_ut - 2451545.0) / 36525
+    return fmod(280.46061837 + 360.98564736629 * (jd_ut - 2451545.0) + 0.000387933 * t * t - t * t * t / 38710000,
+                360.0) % 360.0
+
+
+def nutation(t):
+    # Meeus chapter 22 low accuracy: delta psi, delta epsilon in degrees, and mean obliquity (22.2)
+    omega = radians(125.04452 - 1934.136261 * t)
+    l_sun = radians(280.4665 + 36000.7698 * t)
+    l_moon = radians(218.3165 + 481267.8813 * t)
+    dpsi = (-17.20 * sin(omega) - 1.32 * sin(2 * l_sun) - 0.23 * sin(2 * l_moon) + 0.21 * sin(2 * omega)) / 3600
+    deps = (9.20 * cos(omega) + 0.57 * cos(2 * l_sun) + 0.10 * cos(2 * l_moon) - 0.09 * cos(2 * omega)) / 3600
+    eps0 = 23 + 26 / 60 + (21.448 - 46.8150 * t - 0.00059 * t * t + 0.001813 * t * t * t) / 3600
+    return dpsi, deps, eps0
+
+
+def ecliptic_to_equatorial(lam, beta, eps):
+    lam, beta, eps = radians(lam), radians(beta), radians(eps)
+    alpha = atan2(sin(lam) * cos(eps) - tan(beta) * sin(eps), cos(lam))
+    delta = asin(sin(beta) * cos(eps) + cos(beta) * sin(eps) * sin(lam))
+    return degrees(alpha) % 360.0, degrees(delta)
+
+# ---------------------------------------------------------------- sun
+
+
+def sun_apparent(jde):
+    # Meeus chapter 25: apparent right ascension, declination (degrees), distance (km)
+    t = (jde - 2451545.0) / 36525
+    l0 = 280.46646 + 36000.76983 * t + 0.0003032 * t * t
+    m = 357.52911 + 35999.05029 * t - 0.0001537 * t * t
+    e = 0.016708634 - 0.000042037 * t - 0.0000001267 * t * t
+    mr = radians(m)
+    c = ((1.914602 - 0.004817 * t - 0.000014 * t * t) * sin(mr) + (0.019993 - 0.000101 * t) * sin(2 * mr) +
+         0.000289 * sin(3 * mr))
+    true_longitude = l0 + c
+    nu = radians(m + c)
+    r = 1.000001018 * (1 - e * e) / (1 + e * cos(nu))
+    omega = radians(125.04 - 1934.136 * t)
+    lam = true_longitude - 0.00569 - 0.00478 * sin(omega)
+    eps0 = nutation(t)[2]
+    eps = eps0 + 0.00256 * cos(omega)
+    alpha, delta = ecliptic_to_equatorial(lam, 0.0, eps)
+    return alpha, delta, r * 149597870.7
+
+# ---------------------------------------------------------------- moon
+
+# Meeus table 47.A: D, M, M', F, longitude (1e-6 degree), distance (0.001 km)
+MOON_LR = (
+    (0, 0, 1, 0, 6288774, -20905355), (2, 0, -1, 0, 1274027, -3699111), (2, 0, 0, 0, 658314, -2955968),
+    (0, 0, 2, 0, 213618, -569925), (0, 1, 0, 0, -185116, 48888), (0, 0, 0, 2, -114332, -3149),
+    (2, 0, -2, 0, 58793, 246158), (2, -1, -1, 0, 57066, -152138), (2, 0, 1, 0, 53322, -170733),
+    (2, -1, 0, 0, 45758, -204586), (0, 1, -1, 0, -40923, -129620), (1, 0, 0, 0, -34720, 108743),
+    (0, 1, 1, 0, -30383, 104755), (2, 0, 0, -2, 15327, 10321), (0, 0, 1, 2, -12528, 0),
+    (0, 0, 1, -2, 10980, 79661), (4, 0, -1, 0, 10675, -34782), (0, 0, 3, 0, 10034, -23210),
+    (4, 0, -2, 0, 8548, -21636), (2, 1, -1, 0, -7888, 24208), (2, 1, 0, 0, -6766, 30824),
+    (1, 0, -1, 0, -5163, -8379), (1, 1, 0, 0, 4987, -16675), (2, -1, 1, 0, 4036, -12831),
+    (2, 0, 2, 0, 3994, -10445), (4, 0, 0, 0, 3861, -11650), (2, 0, -3, 0, 3665, 14403),
+    (0, 1, -2, 0, -2689, -7003), (2, 0, -1, 2, -2602, 0), (2, -1, -2, 0, 2390, 10056),
+    (1, 0, 1, 0, -2348, 6322), (2, -2, 0, 0, 2236, -9884), (0, 1, 2, 0, -2120, 5751),
+    (0, 2, 0, 0, -2069, 0), (2, -2, -1, 0, 2048, -4950), (2, 0, 1, -2, -1773, 4130),
+    (2, 0, 0, 2, -1595, 0), (4, -1, -1, 0, 1215, -3958), (0, 0, 2, 2, -1110, 0),
+    (3, 0, -1, 0, -892, 3258), (2, 1, 1, 0, -810, 2616), (4, -1, -2, 0, 759, -1897),
+    (0, 2, -1, 0, -713, -2117), (2, 2, -1, 0, -700, 2354), (2, 1, -2, 0, 691, 0),
+    (2, -1, 0, -2, 596, 0), (4, 0, 1, 0, 549, -1423), (0, 0, 4, 0, 537, -1117),
+    (4, -1, 0, 0, 520, -1571), (1, 0, -2, 0, -487, -1739), (2, 1, 0, -2, -399, 0),
+    (0, 0, 2, -2, -381, -4421), (1, 1, 1, 0, 351, 0), (3, 0, -2, 0, -340, 0),
+    (4, 0, -3, 0, 330, 0), (2, -1, 2, 0, 327, 0), (0, 2, 1, 0, -323, 1165),
+    (1, 1, -1, 0, 299, 0), (2, 0, 3, 0, 294, 0), (2, 0, -1, -2, 0, 8752))
+
+# Meeus table 47.B: D, M, M', F, latitude (1e-6 degree)
+MOON_B = (
+    (0, 0, 0, 1, 5128122), (0, 0, 1, 1, 280602), (0, 0, 1, -1, 277693), (2, 0, 0, -1, 173237),
+    (2, 0, -1, 1, 55413), (2, 0, -1, -1, 46271), (2, 0, 0, 1, 32573), (0, 0, 2, 1, 17198),
+    (2, 0, 1, -1, 9266), (0, 0, 2, -1, 8822), (2, -1, 0, -1, 8216), (2, 0, -2, -1, 4324),
+    (2, 0, 1, 1, 4200), (2, 1, 0, -1, -3359), (2, -1, -1, 1, 2463), (2, -1, 0, 1, 2211),
+    (2, -1, -1, -1, 2065), (0, 1, -1, -1, -1870), (4, 0, -1, -1, 1828), (0, 1, 0, 1, -1794),
+    (0, 0, 0, 3, -1749), (0, 1, -1, 1, -1565), (1, 0, 0, 1, -1491), (0, 1, 1, 1, -1475),
+    (0, 1, 1, -1, -1410), (0, 1, 0, -1, -1344), (1, 0, 0, -1, -1335), (0, 0, 3, 1, 1107),
+    (4, 0, 0, -1, 1021), (4, 0, -1, 1, 833), (0, 0, 1, -3, 777), (4, 0, -2, 1, 671),
+    (2, 0, 0, -3, 607), (2, 0, 2, -1, 596), (2, -1, 1, -1, 491), (2, 0, -2, 1, -451),
+    (0, 0, 3, -1, 439), (2, 0, 2, 1, 422), (2, 0, -3, -1, 421), (2, 1, -1, 1, -366),
+    (2, 1, 0, 1, -351), (4, 0, 0, 1, 331), (2, -1, 1, 1, 315), (2, -2, 0, -1, 302),
+    (0, 0, 1, 3, -283), (2, 1, 1, -1, -229), (1, 1, 0, -1, 223), (1, 1, 0, 1, 223),
+    (0, 1, -2, -1, -220), (2, 1, -1, -1, -220), (1, 0, 1, 1, -185), (2, -1, -2, -1, 181),
+    (0, 1, 2, 1, -177), (4, 0, -2, -1, 176), (4, -1, -1, -1, 166), (1, 0, 1, -1, -164),
+    (4, 0, 1, -1, 132), (1, 0, -1, -1, -119), (4, -1, 0, -1, 115), (2, -2, 0, 1, 107))
+
+
+def moon_geometric(jde):
+    # Meeus chapter 47: geocentric ecliptic longitude, latitude (degrees, mean equinox of date), distance (km)
+    t = (jde - 2451545.0) / 36525
+    lp = 218.3164477 + 481267.88123421 * t - 0.0015786 * t ** 2 + t ** 3 / 538841 - t ** 4 / 65194000
+    d = 297.8501921 + 445267.1114034 * t - 0.0018819 * t ** 2 + t ** 3 / 545868 - t ** 4 / 113065000
+    m = 357.5291092 + 35999.0502909 * t - 0.0001536 * t ** 2 + t ** 3 / 24490000
+    mp = 134.9633964 + 477198.8675055 * t + 0.0087414 * t ** 2 + t ** 3 / 69699 - t ** 4 / 14712000
+    f = 93.2720950 + 483202.0175233 * t - 0.0036539 * t ** 2 - t ** 3 / 3526000 + t ** 4 / 863310000
+    a1 = radians(119.75 + 131.849 * t)
+    a2 = radians(53.09 + 479264.290 * t)
+    a3 = radians(313.45 + 481266.484 * t)
+    e = 1 - 0.002516 * t - 0.0000074 * t * t
+    lp_r, d, m, mp, f = radians(lp), radians(d), radians(m), radians(mp), radians(f)
+
+    sum_l = sum_r = sum_b = 0.0
+    for cd, cm, cmp, cf, cl, cr in MOON_LR:
+        arg = cd * d + cm * m + cmp * mp + cf * f
+        ecc = e ** abs(cm)
+        sum_l += cl * ecc * sin(arg)
+        sum_r += cr * ecc * cos(arg)
+    for cd, cm, cmp, cf, cb in MOON_B:
+        sum_b += cb * e ** abs(cm) * sin(cd * d + cm * m + cmp * mp + cf * f)
+
+    sum_l += 3958 * sin(a1) + 1962 * sin(lp_r - f) + 318 * sin(a2)
+    sum_b += (-2235 * sin(lp_r) + 382 * sin(a3) + 175 * sin(a1 - f) + 175 * sin(a1 + f) + 127 * sin(lp_r - mp) -
+              115 * sin(lp_r + mp))
+
+    return (lp + sum_l / 1e6) % 360.0, sum_b / 1e6, 385000.56 + sum_r / 1000
+
+
+def moon_apparent(jde):
+    t = (jde - 2451545.0) / 36525
+    lam, beta, dist = moon_geometric(jde)
+    dpsi, deps, eps0 = nutation(t)
+    alpha, delta = ecliptic_to_equatorial(lam + dpsi, beta, eps0 + deps)
+    return alpha, delta, dist
+
+# ---------------------------------------------------------------- observer
+
+
+def observer_vector(latitude, longitude, height_m, sidereal):
+    # WGS-84 geodetic to geocentric km, in the frame turned by the sidereal angle (degrees)
+    a = 6378.137
+    f = 1 / 298.257223563
+    e2 = f * (2 - f)
+    phi = radians(latitude)
+    theta = radians(sidereal + longitude)
+    n = a / sqrt(1 - e2 * sin(phi) ** 2)
+    h = height_m / 1000.0
+    return ((n + h) * cos(phi) * cos(theta), (n + h) * cos(phi) * sin(theta), (n * (1 - e2) + h) * sin(phi))
+
+
+def topocentric_az_el(target, latitude, longitude, height_m, sidereal):
+    # target in km, same frame as observer_vector(); returns azimuth (from north, 0 - 360) and elevation, degrees
+    o = observer_vector(latitude, longitude, height_m, sidereal)
+    rx, ry, rz = target[0] - o[0], target[1] - o[1], target[2] - o[2]
+    phi = radians(latitude)
+    theta = radians(sidereal + longitude)
+    east = -sin(theta) * rx + cos(theta) * ry
+    north = -sin(phi) * cos(theta) * rx - sin(phi) * sin(theta) * ry + cos(phi) * rz
+    up = cos(phi) * cos(theta) * rx + cos(phi) * sin(theta) * ry + sin(phi) * rz
+    return degrees(atan2(east, north)) % 360.0, degrees(atan2(up, hypot(east, north)))
+
+
+def equatorial_vector(alpha, delta, dist):
+    alpha, delta = radians(alpha), radians(delta)
+    return (dist * cos(delta) * cos(alpha), dist * cos(delta) * sin(alpha), dist * sin(delta))
+
+
+def sun_moon_az_el(year, month, day, hour, minute, latitude, longitude):
+    jd = julian_day(year, month, day, hour, minute)
+    jde = jd + delta_t(year) / 86400
+    t = (jde - 2451545.0) / 36525
+    dpsi, deps, eps0 = nutation(t)
+    gast = gmst(jd) + dpsi * cos(radians(eps0 + deps))
+    sun = topocentric_az_el(equatorial_vector(*sun_apparent(jde)), latitude, longitude, 0, gast)
+    moon = topocentric_az_el(equatorial_vector(*moon_apparent(jde)), latitude, longitude, 0, gast)
+    return sun, moon
+
+# ---------------------------------------------------------------- SGP4
+
+
+class Sgp4:
+    # near earth SGP4 (period under 225 minutes), Spacetrack Report #3, WGS-72 constants
+
+    XKE = 0.0743669161
+    CK2 = 5.413080e-4
+    CK4 = 0.62098875e-6
+    XJ3 = -0.253881e-5
+    QOMS2T = 1.88027916e-9
+    S = 1.01222928
+    XKMPER = 6378.135
+    XMNPDA = 1440.0
+
+    def __init__(self, l1, l2):
+        year = int(l1[18:20])
+        year += 2000 if year < 57 else 1900
+        self.epoch_jd = julian_day(year, 1, 0) + float(l1[20:32])
+        self.bstar = float(l1[53] + '.' + l1[54:59]) * 10 ** int(l1[59:61])
+        self.xincl = radians(float(l2[8:16]))
+        self.xnodeo = radians(float(l2[17:25]))
+        self.eo = float('.' + l2[26:33])
+        self.omegao = radians(float(l2[34:42]))
+        self.xmo = radians(float(l2[43:51]))
+        self.xno = float(l2[52:63]) * TWOPI / self.XMNPDA
+        self._initialize()
+
+    def _initialize(self):
+        ck2, ck4, eo, xincl = self.CK2, self.CK4, self.eo, self.xincl
+        tothrd = 2.0 / 3.0
+        a1 = (self.XKE / self.xno) ** tothrd
+        self.cosio = cosio = cos(xincl)
+        theta2 = cosio * cosio
+        self.x3thm1 = x3thm1 = 3 * theta2 - 1
+        eosq = eo * eo
+        betao2 = 1 - eosq
+        betao = sqrt(betao2)
+        del1 = 1.5 * ck2 * x3thm1 / (a1 * a1 * betao * betao2)
+        ao = a1 * (1 - del1 * (0.5 * tothrd + del1 * (1 + 134.0 / 81.0 * del1)))
+        delo = 1.5 * ck2 * x3thm1 / (ao * ao * betao * betao2)
+        self.xnodp = xnodp = self.xno / (1 + delo)
+        self.aodp = aodp = ao / (1 - delo)
+
+        self.isimp = (aodp * (1 - eo)) < (220 / self.XKMPER + 1)
+        s4 = self.S
+        qoms24 = self.QOMS2T
+        perige = (aodp * (1 - eo) - 1) * self.XKMPER
+        if perige < 156:
+            s4 = 20 if perige <= 98 else perige - 78
+            qoms24 = ((120 - s4) / self.XKMPER) ** 4
+            s4 = s4 / self.XKMPER + 1
+        pinvsq = 1 / (aodp * aodp * betao2 * betao2)
+        tsi = 1 / (aodp - s4)
+        self.eta = eta = aodp * eo * tsi
+        etasq = eta * eta
+        eeta = eo * eta
+        psisq = abs(1 - etasq)
+        coef = qoms24 * tsi ** 4
+        coef1 = coef / psisq ** 3.5
+        c2 = coef1 * xnodp * (aodp * (1 + 1.5 * etasq + eeta * (4 + etasq)) +
+                              0.75 * ck2 * tsi / psisq * x3thm1 * (8 + 3 * etasq * (8 + etasq)))
+        self.c1 = c1 = self.bstar * c2
+        self.sinio = sinio = sin(xincl)
+        a3ovk2 = -self.XJ3 / ck2
+        c3 = coef * tsi * a3ovk2 * xnodp * sinio / eo
+        self.x1mth2 = x1mth2 = 1 - theta2
+        self.c4 = 2 * xnodp * coef1 * aodp * betao2 * (
+            eta * (2 + 0.5 * etasq) + eo * (0.5 + 2 * etasq) -
+            2 * ck2 * tsi / (aodp * psisq) * (-3 * x3thm1 * (1 - 2 * eeta + etasq * (1.5 - 0.5 * eeta)) +
+                                              0.75 * x1mth2 * (2 * etasq - eeta * (1 + etasq)) * cos(2 * self.omegao)))
+        self.c5 = 2 * coef1 * aodp * betao2 * (1 + 2.75 * (etasq + eeta) + eeta * etasq)
+        theta4 = theta2 * theta2
+        temp1 = 3 * ck2 * pinvsq * xnodp
+        temp2 = temp1 * ck2 * pinvsq
+        temp3 = 1.25 * ck4 * pinvsq * pinvsq * xnodp
+        self.xmdot = xnodp + 0.5 * temp1 * betao * x3thm1 + 0.0625 * temp2 * betao * (13 - 78 * theta2 + 137 * theta4)
+        x1m5th = 1 - 5 * theta2
+        self.omgdot = (-0.5 * temp1 * x1m5th + 0.0625 * temp2 * (7 - 114 * theta2 + 395 * theta4) +
+                       temp3 * (3 - 36 * theta2 + 49 * theta4))
+        xhdot1 = -temp1 * cosio
+        self.xnodot = xhdot1 + (0.5 * temp2 * (4 - 19 * theta2) + 2 * temp3 * (3 - 7 * theta2)) * cosio
+        self.omgcof = self.bstar * c3 * cos(self.omegao)
+        self.xmcof = -tothrd * coef * self.bstar / eeta
+        self.xnodcf = 3.5 * betao2 * xhdot1 * c1
+        self.t2cof = 1.5 * c1
+        self.xlcof = 0.125 * a3ovk2 * sinio * (3 + 5 * cosio) / (1 + cosio)
+        self.aycof = 0.25 * a3ovk2 * sinio
+        self.delmo = (1 + eta * cos(self.xmo)) ** 3
+        self.sinmo = sin(self.xmo)
+        self.x7thm1 = 7 * theta2 - 1
+        if not self.isimp:
+            c1sq = c1 * c1
+            self.d2 = d2 = 4 * aodp * tsi * c1sq
+            temp = d2 * tsi * c1 / 3
+            self.d3 = d3 = (17 * aodp + s4) * temp
+            self.d4 = d4 = 0.5 * temp * aodp * tsi * (221 * aodp + 31 * s4) * c1
+            self.t3cof = d2 + 2 * c1sq
+            self.t4cof = 0.25 * (3 * d3 + c1 * (12 * d2 + 10 * c1sq))
+            self.t5cof = 0.2 * (3 * d4 + 12 * c1 * d3 + 6 * d2 * d2 + 15 * c1sq * (2 * d2 + c1sq))
+
+    def position(self, tsince):
+        # TEME position in km, tsince in minutes from the epoch
+        xmdf = self.xmo + self.xmdot * tsince
+        omgadf = self.omegao + self.omgdot * tsince
+        xnoddf = self.xnodeo + self.xnodot * tsince
+        omega = omgadf
+        xmp = xmdf
+        tsq = tsince * tsince
+        xnode = xnoddf + self.xnodcf * tsq
+        tempa = 1 - self.c1 * tsince
+        tempe = self.bstar * self.c4 * tsince
+        templ = self.t2cof * tsq
+        if not self.isimp:
+            delomg = self.omgcof * tsince
+            delm = self.xmcof * ((1 + self.eta * cos(xmdf)) ** 3 - self.delmo)
+            temp = delomg + delm
+            xmp = xmdf + temp
+            omega = omgadf - temp
+            tcube = tsq * tsince
+            tfour = tsince * tcube
+            tempa = tempa - self.d2 * tsq - self.d3 * tcube - self.d4 * tfour
+            tempe = tempe + self.bstar * self.c5 * (sin(xmp) - self.sinmo)
+            templ = templ + self.t3cof * tcube + tfour * (self.t4cof + tsince * self.t5cof)
+        a = self.aodp * tempa * tempa
+        e = self.eo - tempe
+        xl = xmp + omega + xnode + self.xnodp * templ
+        beta = sqrt(1 - e * e)
+
+        # long period periodics
+        axn = e * cos(omega)
+        temp = 1 / (a * beta * beta)
+        xll = temp * self.xlcof * axn
+        aynl = temp * self.aycof
+        xlt = xl + xll
+        ayn = e * sin(omega) + aynl
+
+        # Kepler's equation
+        capu = fmod(xlt - xnode, TWOPI)
+        temp2 = capu
+        for i in range(10):
+            sinepw = sin(temp2)
+            cosepw = cos(temp2)
+            temp3 = axn * sinepw
+            temp4 = ayn * cosepw
+            temp5 = axn * cosepw
+            temp6 = ayn * sinepw
+            epw = (capu - temp4 + temp3 - temp2) / (1 - temp5 - temp6) + temp2
+            if abs(epw - temp2) <= 1e-12:
+                break
+            temp2 = epw
+
+        # short period preliminary quantities
+        ecose = temp5 + temp6
+        esine = temp3 - temp4
+        elsq = axn * axn + ayn * ayn
+        temp = 1 - elsq
+        pl = a * temp
+        r = a * (1 - ecose)
+        temp1 = 1 / r
+        temp2 = a * temp1
+        betal = sqrt(temp)
+        temp3 = 1 / (1 + betal)
+        cosu = temp2 * (cosepw - axn + ayn * esine * temp3)
+        sinu = temp2 * (sinepw - ayn - axn * esine * temp3)
+        u = atan2(sinu, cosu)
+        sin2u = 2 * sinu * cosu
+        cos2u = 2 * cosu * cosu - 1
+        temp = 1 / pl
+        temp1 = self.CK2 * temp
+        temp2 = temp1 * temp
+
+        # short periodics
+        rk = r * (1 - 1.5 * temp2 * betal * self.x3thm1) + 0.5 * temp1 * self.x1mth2 * cos2u
+        uk = u - 0.25 * temp2 * self.x7thm1 * sin2u
+        xnodek = xnode + 1.5 * temp2 * self.cosio * sin2u
+        xinck = self.xincl + 1.5 * temp2 * self.cosio * self.sinio * cos2u
+
+        sinuk, cosuk = sin(uk), cos(uk)
+        sinik, cosik = sin(xinck), cos(xinck)
+        sinnok, cosnok = sin(xnodek), cos(xnodek)
+        xmx = -sinnok * cosik
+        xmy = cosnok * cosik
+        ux = xmx * sinuk + cosnok * cosuk
+        uy = xmy * sinuk + sinnok * cosuk
+        uz = sinik * sinuk
+        return (rk * ux * self.XKMPER, rk * uy * self.XKMPER, rk * uz * self.XKMPER)
+
+    def az_el(self, jd_ut, latitude, longitude, height_m):
+        return topocentric_az_el(self.position((jd_ut - self.epoch_jd) * self.XMNPDA), latitude, longitude, height_m,
+                                 gmst(jd_ut))
+
+# ---------------------------------------------------------------- checks against the books
+
+
+def check(what, value, expected, tolerance):
+    if abs(value - expected) > tolerance:
+        sys.exit('%s is %.9f, expected %.9f' % (what, value, expected))
+
+
+def self_test():
+    check('Meeus 7.a JD', julian_day(1957, 10, 4, 19, 26, 24), 2436116.31, 1e-9)
+    check('Meeus 12.a GMST', gmst(2446895.5), 197.693195, 1e-6)
+    alpha, delta, dist = sun_apparent(2448908.5)
+    check('Meeus 25.a sun RA', alpha, 198.38083, 1e-4)
+    check('Meeus 25.a sun dec', delta, -7.78507, 1e-4)
+    lam, beta, dist = moon_geometric(2448724.5)
+    check('Meeus 47.a moon longitude', lam, 133.162655, 1e-6)
+    check('Meeus 47.a moon latitude', beta, -3.229126, 1e-6)
+    check('Meeus 47.a moon distance', dist, 368409.7, 0.1)
+    alpha, delta, dist = moon_apparent(2448724.5)
+    check('Meeus 47.a moon RA', alpha, 134.688470, 2e-4)
+    check('Meeus 47.a moon dec', delta, 13.768368, 2e-4)
+    sgp4 = Sgp4('1 88888U          80275.98708465  .00073094  13844-3  66816-4 0    8',
+                '2 88888  72.8435 115.9689 0086731  52.6988 110.5714 16.05824518  105')
+    for tsince, expected in ((0, (2328.97048951, -5995.22076416, 1719.97067261)),
+                             (360, (2456.10705566, -6071.93853760, 1222.89727783)),
+                             (720, (2567.56195068, -6112.50384522, 713.96397400)),
+                             (1080, (2663.09078980, -6115.48229980, 196.39640427)),
+                             (1440, (2742.55133057, -6079.67144775, -326.38095856))):
+        position = sgp4.position(tsince)
+        for axis in range(3):
+            check('Report #3 SGP4 t=%d axis %d' % (tsince, axis), position[axis], expected[axis], 0.01)
+
+# ---------------------------------------------------------------- test vectors
+
+# year, month, day, hour, minute, latitude, longitude: a spread of seasons and places, both hemispheres, and
+# the sun and moon above and below the horizon
+SUN_MOON_TIMES = (
+    (2022, 3, 1, 12, 0, 40.889958, -75.585972),
+    (2026, 10, 17, 3, 20, -33.92, 18.42),
+    (2030, 6, 21, 18, 0, 64.84, -147.72),
+    (2020, 6, 21, 18, 0, 35.68, 139.77),
+    (2024, 4, 8, 18, 18, 30.0, -100.0),
+    (2026, 1, 1, 0, 0, -77.85, 166.67),
+    (2025, 9, 7, 18, 30, 51.48, 0.0),
+    (2028, 12, 21, 9, 45, 0.0, -60.0))
+
+ISS_TLE = ('1 25544U 98067A   08264.51782528 -.00002182  00000-0 -11606-4 0  2927',
+           '2 25544  51.6416 247.4627 0006703 130.5360 325.0288 15.72125391563537')
+
+# observers for the satellite vectors: latitude, longitude, height (m)
+ISS_OBSERVERS = (
+    (40.889958, -75.585972, 50),
+    (-33.92, 18.42, 10),
+    (35.68, 139.77, 40))
+
+
+def iss_pass_vectors(sgp4):
+    # for each observer, the first pass after the epoch: AOS, a quarter way through, the highest point, three
+    # quarters, and LOS, each to the second.  Returns (minutes after 2008-09-20 00:00 UTC, observer, az, el).
+    day0 = julian_day(2008, 9, 20)
+    vectors = []
+    aos_los = []
+    for latitude, longitude, height in ISS_OBSERVERS:
+        def elevation(seconds):
+            return sgp4.az_el(day0 + seconds / 86400.0, latitude, longitude, height)[1]
+
+        def crossing(low, high, rising):
+            # bisect the horizon crossing to a millisecond
+            while high - low > 0.001:
+                middle = (low + high) / 2
+                if (elevation(middle) > 0) == rising:
+                    high = middle
+                else:
+                    low = middle
+            return (low + high) / 2
+
+        seconds = (sgp4.epoch_jd - day0) * 86400
+        while elevation(seconds) > 0:
+            seconds += 10
+        while elevation(seconds) <= 0:
+            seconds += 10
+        aos = crossing(seconds - 10, seconds, True)
+        while elevation(seconds) > 0:
+            seconds += 10
+        los = crossing(seconds - 10, seconds, False)
+        highest = max(range(int(aos), int(los)), key=elevation)
+        aos_los.append((aos, los, latitude, longitude, height))
+        for seconds in (round(aos), round(aos + (highest - aos) / 2), highest, round(highest + (los - highest) / 2),
+                        round(los)):
+            az, el = sgp4.az_el(day0 + seconds / 86400.0, latitude, longitude, height)
+            vectors.append((seconds, latitude, longitude, height, az, el))
+    return vectors, aos_los
+
+
+def iss_spread_vectors(sgp4):
+    # some times well away from any pass too, on the hour over the day after the epoch
+    day0 = julian_day(2008, 9, 20)
+    vectors = []
+    for (latitude, longitude, height), hour in zip(ISS_OBSERVERS * 2, (16, 20, 25, 28, 31, 34)):
+        az, el = sgp4.az_el(day0 + hour / 24.0, latitude, longitude, height)
+        vectors.append((hour * 3600, latitude, longitude, height, az, el))
+    return vectors
+
+
+def main():
+    self_test()
+
+    out = open(sys.argv[1], 'w') if len(sys.argv) > 1 else sys.stdout
+    out.write('// generated by test/native/reference/astro_reference.py, don\'t edit\n\n')
+
+    out.write('// year, month, day, hour, minute, latitude, longitude, sun azimuth, elevation, moon azimuth, elevation\n')
+    out.write('const struct astro_reference_vector astro_reference_vectors[] = {\n')
+    for year, month, day, hour, minute, latitude, longitude in SUN_MOON_TIMES:
+        (sun_az, sun_el), (moon_az, moon_el) = sun_moon_az_el(year, month, day, hour, minute, latitude, longitude)
+        out.write('  {%d, %2d, %2d, %2d, %2d, %10.6f, %11.6f, %9.4f, %8.4f, %9.4f, %8.4f},\n' %
+                  (year, month, day, hour, minute, latitude, longitude, sun_az, sun_el, moon_az, moon_el))
+    out.write('};\n\n')
+
+    sgp4 = Sgp4(*ISS_TLE)
+    pass_vectors, aos_los = iss_pass_vectors(sgp4)
+    out.write('const char astro_reference_iss_line_1[] = "%s";\n' % ISS_TLE[0])
+    out.write('const char astro_reference_iss_line_2[] = "%s";\n\n' % ISS_TLE[1])
+    out.write('// seconds after 2008-09-20 00:00 UTC, latitude, longitude, height (m), azimuth, elevation\n')
+    out.write('// first pass after the epoch for each observer: AOS, halfway up, highest, halfway down, LOS\n')
+    out.write('const struct astro_reference_satellite_vector astro_reference_iss_pass_vectors[] = {\n')
+    for seconds, latitude, longitude, height, az, el in pass_vectors:
+        out.write('  {%6d, %10.6f, %11.6f, %3d, %9.4f, %8.4f},\n' % (seconds, latitude, longitude, height, az, el))
+    out.write('};\n\n')
+    out.write('// on the hour, mostly below the horizon\n')
+    out.write('const struct astro_reference_satellite_vector astro_reference_iss_vectors[] = {\n')
+    for seconds, latitude, longitude, height, az, el in iss_spread_vectors(sgp4):
+        out.write('  {%6d, %10.6f, %11.6f, %3d, %9.4f, %8.4f},\n' % (seconds, latitude, longitude, height, az, el))
+    out.write('};\n\n')
+    out.write('// AOS and LOS, seconds after 2008-09-20 00:00 UTC, latitude, longitude, height (m)\n')
+    out.write('const struct astro_reference_aos_los astro_reference_iss_aos_los[] = {\n')
+    for aos, los, latitude, longitude, height in aos_los:
+        out.write('  {%9.3f, %9.3f, %10.6f, %11.6f, %3d},\n' % (aos, los, latitude, longitude, height))
+    out.write('};\n')
+
+
+if __name__ == '__main__':
+    main()
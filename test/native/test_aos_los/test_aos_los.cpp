@@ -0,0 +1,331 @@
+// Native tests for the AOS / LOS search in service_calc_satellite_data(), run on the PC with
+//
+//   pio test -e native
+//
+// search_crossings() below goes through the same steps as the controller: it steps ahead with
+// Satellite::horizon_step(), held within the SATELLITE_CALC_* step limits from rotator_settings.h, until it lands
+// on the far side of a horizon crossing, then closes in on it with Satellite::crossing_probe().  Every crossing it
+// finds has to be the same second a plain one second scan finds, for a handful of satellites (low, polar,
+// eccentric, and one starting in a pass) and observers.
+//
+// The benchmark counts predictions per crossing against the fixed step scan the controller used before
+// (120 seconds, then back over the last step at 10, then at 1), which is what it costs on the Mega.
+
+#include <unity.h>
+#include <stdio.h>
+
+#include "P13.h"
+
+// from rotator_settings.h
+#define SATELLITE_AOS_ELEVATION_MIN 0.0
+#define SATELLITE_CALC_SEARCH_MAX_STEP_SECS 3600
+#define SATELLITE_CALC_IN_PASS_MAX_STEP_SECS 120
+#define SATELLITE_CALC_SEARCH_MIN_STEP_SECS 1
+#define SATELLITE_CALC_RESOLUTION_SECS 1
+
+// the fixed step scan used before
+#define OLD_SCAN_STAGE_1_SECS 120
+#define OLD_SCAN_STAGE_2_SECS 10
+#define OLD_SCAN_STAGE_3_SECS 1
+
+#define CROSSINGS_PER_CASE 6
+
+struct aos_los_test_satellite {
+  const char *name;
+  const char *line_1;
+  const char *line_2;
+  int year;               // search start
+  int month;
+  int day;
+  int hour;
+  int minute;
+};
+
+struct aos_los_test_observer {
+  double latitude;
+  double longitude;
+  int height_m;
+};
+
+// from lib/tle/nasabare.txt, and the ISS elements test_astro uses
+const struct aos_los_test_satellite aos_los_test_satellites[] = {
+  {"AO-07", "1 07530U 74089B   20205.48277872 -.00000043  00000-0  13494-4 0  9990",
+            "2 07530 101.8018 175.0260 0011861 296.2265 184.6086 12.53644244090508", 2020, 7, 23, 12, 0},
+  {"UO-11", "1 14781U 84021B   20205.45028052  .00000011  00000-0  73722-5 0  9999",
+            "2 14781 097.5894 215.6333 0010059 084.2955 275.9406 14.83179338937162", 2020, 7, 23, 12, 0},
+  {"HUBBLE", "1 20580U 90037B   20205.79346029  .00000335  00000-0  93875-5 0  9991",
+             "2 20580  28.4701  79.3049 0002843 122.0282 332.3461 15.09408263461545", 2020, 7, 23, 18, 0},
+  {"FO-29", "1 24278U 96046B   20205.54750867  .00000001  00000-0  40493-4 0  9994",
+            "2 24278 098.5868 310.6584 0349296 281.4372 074.7736 13.53098180181761", 2020, 7, 23, 12, 0},
+  {"ISS", "1 25544U 98067A   08264.51782528 -.00002182  00000-0 -11606-4 0  2927",
+          "2 25544  51.6416 247.4627 0006703 130.5360 325.0288 15.72125391563537", 2008, 9, 20, 0, 0},
+  {"ISS", "1 25544U 98067A   08264.51782528 -.00002182  00000-0 -11606-4 0  2927",       // starts in a pass over
+          "2 25544  51.6416 247.4627 0006703 130.5360 325.0288 15.72125391563537", 2008, 9, 20, 9, 8},   // the second observer
+};
+
+const struct aos_los_test_observer aos_los_test_observers[] = {
+  {40.0, -75.0, 100},
+  {35.7, 139.7, 40},
+  {-33.9, 151.2, 0},
+  {0.0, 100.0, 0},
+};
+
+#define COUNT_OF(v) ((int)(sizeof(v) / sizeof(v[0])))
+
+void setUp(){}
+
+void tearDown(){}
+
+// --------------------------------------------------------------
+
+long predictions;
+
+double elevation_at(Satellite &satellite, Observer &observer, const SatDateTime &start, long seconds){
+
+  SatDateTime time(start);
+  double azimuth, elevation;
+
+  time.add(seconds / 86400.0);
+  satellite.predict(time);
+  satellite.altaz(observer, elevation, azimuth);
+  predictions++;
+  return elevation;
+
+}
+
+// --------------------------------------------------------------
+
+long search_step(Satellite &satellite, Observer &observer, double max_ground_rate, int in_pass){
+
+  // satellite_calc_search_step()
+
+  double step = satellite.horizon_step(observer, max_ground_rate, SATELLITE_AOS_ELEVATION_MIN, in_pass);
+  long max_step = (in_pass) ? SATELLITE_CALC_IN_PASS_MAX_STEP_SECS : SATELLITE_CALC_SEARCH_MAX_STEP_SECS;
+
+  if (step > max_step){return max_step;}
+  if (step < SATELLITE_CALC_SEARCH_MIN_STEP_SECS){return SATELLITE_CALC_SEARCH_MIN_STEP_SECS;}
+  return (long)step;
+
+}
+
+// --------------------------------------------------------------
+
+void search_crossings(Satellite &satellite, Observer &observer, const SatDateTime &start, long *crossings){
+
+  // the SEARCH_CALC and REFINE_CALC stages of service_calc_satellite_data(); crossings[] gets the first second
+  // on the far side of each horizon crossing
+
+  double max_ground_rate = satellite.max_ground_rate();
+  long probe = 0;
+  long bracket_low = 0;
+  long bracket_high = 0;
+  double bracket_low_elevation = 0;
+  double bracket_high_elevation = 0;
+  int refining = 0;
+  int refine_iterations = 0;
+  int in_pass = (elevation_at(satellite, observer, start, 0) >= SATELLITE_AOS_ELEVATION_MIN);
+  int looking_for_los = in_pass;
+  int found = 0;
+
+  while (found < CROSSINGS_PER_CASE){
+    if (refining){
+      probe = Satellite::crossing_probe(bracket_low, bracket_low_elevation, bracket_high, bracket_high_elevation, SATELLITE_AOS_ELEVATION_MIN, refine_iterations);
+      refine_iterations++;
+    }
+    double elevation = elevation_at(satellite, observer, start, probe);
+    in_pass = (elevation >= SATELLITE_AOS_ELEVATION_MIN);
+    if (in_pass != looking_for_los){
+      bracket_high = probe;
+      bracket_high_elevation = elevation;
+      if (!refining){
+        refining = 1;
+        refine_iterations = 0;
+      }
+    } else {
+      bracket_low = probe;
+      bracket_low_elevation = elevation;
+    }
+    if (!refining){
+      probe = probe + search_step(satellite, observer, max_ground_rate, in_pass);
+    } else if ((bracket_high - bracket_low) <= SATELLITE_CALC_RESOLUTION_SECS){
+      crossings[found++] = bracket_high;
+      looking_for_los = !looking_for_los;
+      refining = 0;
+      bracket_low = bracket_high;
+      bracket_low_elevation = bracket_high_elevation;
+      probe = bracket_high + SATELLITE_CALC_SEARCH_MIN_STEP_SECS;
+    }
+  }
+
+}
+
+// --------------------------------------------------------------
+
+void scan_crossings(Satellite &satellite, Observer &observer, const SatDateTime &start, long *crossings){
+
+  int in_pass = (elevation_at(satellite, observer, start, 0) >= SATELLITE_AOS_ELEVATION_MIN);
+  int found = 0;
+
+  for (long seconds = 1; found < CROSSINGS_PER_CASE; seconds++){
+    if ((elevation_at(satellite, observer, start, seconds) >= SATELLITE_AOS_ELEVATION_MIN) != in_pass){
+      crossings[found++] = seconds;
+      in_pass = !in_pass;
+    }
+  }
+
+}
+
+// --------------------------------------------------------------
+
+void old_scan_crossings(Satellite &satellite, Observer &observer, const SatDateTime &start, long *crossings){
+
+  // the fixed step scan: each stage goes back to the last time on the near side and steps over it again, finer
+
+  const long step[3] = {OLD_SCAN_STAGE_1_SECS, OLD_SCAN_STAGE_2_SECS, OLD_SCAN_STAGE_3_SECS};
+  int in_pass = (elevation_at(satellite, observer, start, 0) >= SATELLITE_AOS_ELEVATION_MIN);
+  long near_side = 0;
+  int found = 0;
+
+  while (found < CROSSINGS_PER_CASE){
+    for (int stage = 0; stage < 3; stage++){
+      long seconds = near_side + step[stage];
+      while ((elevation_at(satellite, observer, start, seconds) >= SATELLITE_AOS_ELEVATION_MIN) == in_pass){
+        near_side = seconds;
+        seconds = seconds + step[stage];
+      }
+      if (stage == 2){
+        crossings[found++] = seconds;
+        near_side = seconds;
+      }
+    }
+    in_pass = !in_pass;
+  }
+
+}
+
+// --------------------------------------------------------------
+
+void test_search_finds_the_scan_crossings(){
+
+  char message[80];
+  long search[CROSSINGS_PER_CASE];
+  long scan[CROSSINGS_PER_CASE];
+  int started_in_pass = 0;
+
+  for (int s = 0; s < COUNT_OF(aos_los_test_satellites); s++){
+    const struct aos_los_test_satellite &t = aos_los_test_satellites[s];
+    Satellite satellite(t.name, t.line_1, t.line_2);
+    SatDateTime start(t.year, t.month, t.day, t.hour, t.minute, 0);
+    for (int o = 0; o < COUNT_OF(aos_los_test_observers); o++){
+      Observer observer("", aos_los_test_observers[o].latitude, aos_los_test_observers[o].longitude, aos_los_test_observers[o].height_m);
+      if (elevation_at(satellite, observer, start, 0) >= SATELLITE_AOS_ELEVATION_MIN){
+        started_in_pass++;
+      }
+      search_crossings(satellite, observer, start, search);
+      scan_crossings(satellite, observer, start, scan);
+      for (int x = 0; x < CROSSINGS_PER_CASE; x++){
+        snprintf(message, sizeof(message), "%s observer %d crossing %d", t.name, o, x);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(scan[x], search[x], message);
+      }
+    }
+  }
+  TEST_ASSERT_TRUE_MESSAGE(started_in_pass > 0, "no case starts in a pass");
+
+}
+
+// --------------------------------------------------------------
+
+void test_old_scan_finds_the_scan_crossings(){
+
+  // so the benchmark compares like with like
+
+  char message[80];
+  long old_scan[CROSSINGS_PER_CASE];
+  long scan[CROSSINGS_PER_CASE];
+
+  for (int s = 0; s < COUNT_OF(aos_los_test_satellites); s++){
+    const struct aos_los_test_satellite &t = aos_los_test_satellites[s];
+    Satellite satellite(t.name, t.line_1, t.line_2);
+    SatDateTime start(t.year, t.month, t.day, t.hour, t.minute, 0);
+    for (int o = 0; o < COUNT_OF(aos_los_test_observers); o++){
+      Observer observer("", aos_los_test_observers[o].latitude, aos_los_test_observers[o].longitude, aos_los_test_observers[o].height_m);
+      old_scan_crossings(satellite, observer, start, old_scan);
+      scan_crossings(satellite, observer, start, scan);
+      for (int x = 0; x < CROSSINGS_PER_CASE; x++){
+        snprintf(message, sizeof(message), "%s observer %d crossing %d", t.name, o, x);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(scan[x], old_scan[x], message);
+      }
+    }
+  }
+
+}
+
+// --------------------------------------------------------------
+
+void test_search_finds_a_short_pass(){
+
+  // an ISS pass of a few seconds that just grazes the horizon, far from the center of the earth along the
+  // observer's vertical, where the spherical earth horizon_step() used to work with stepped right over it
+
+  char message[80];
+  long search[CROSSINGS_PER_CASE];
+  long scan[CROSSINGS_PER_CASE];
+  const struct aos_los_test_satellite &t = aos_los_test_satellites[4];
+  Satellite satellite(t.name, t.line_1, t.line_2);
+  SatDateTime start(2008, 9, 20, 7, 50, 0);
+  Observer observer("", 55.063, -75.0, 100);
+
+  search_crossings(satellite, observer, start, search);
+  scan_crossings(satellite, observer, start, scan);
+  TEST_ASSERT_TRUE_MESSAGE((scan[1] - scan[0]) < 10, "not a short pass");
+  for (int x = 0; x < CROSSINGS_PER_CASE; x++){
+    snprintf(message, sizeof(message), "short pass crossing %d", x);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(scan[x], search[x], message);
+  }
+
+}
+
+// --------------------------------------------------------------
+
+void benchmark_search(){
+
+  char message[100];
+  long crossings[CROSSINGS_PER_CASE];
+  long search_predictions = 0;
+  long old_scan_predictions = 0;
+  int cases = 0;
+
+  for (int s = 0; s < COUNT_OF(aos_los_test_satellites); s++){
+    const struct aos_los_test_satellite &t = aos_los_test_satellites[s];
+    Satellite satellite(t.name, t.line_1, t.line_2);
+    SatDateTime start(t.year, t.month, t.day, t.hour, t.minute, 0);
+    for (int o = 0; o < COUNT_OF(aos_los_test_observers); o++){
+      Observer observer("", aos_los_test_observers[o].latitude, aos_los_test_observers[o].longitude, aos_los_test_observers[o].height_m);
+      predictions = 0;
+      search_crossings(satellite, observer, start, crossings);
+      search_predictions += predictions;
+      predictions = 0;
+      old_scan_crossings(satellite, observer, start, crossings);
+      old_scan_predictions += predictions;
+      cases++;
+    }
+  }
+  snprintf(message, sizeof(message), "predictions per crossing: search %.1f, fixed step scan %.1f",
+    (double)search_predictions / (cases * CROSSINGS_PER_CASE), (double)old_scan_predictions / (cases * CROSSINGS_PER_CASE));
+  TEST_MESSAGE(message);
+  TEST_ASSERT_TRUE(search_predictions < old_scan_predictions);
+
+}
+
+// --------------------------------------------------------------
+
+int main(int argc, char **argv){
+
+  UNITY_BEGIN();
+  RUN_TEST(test_search_finds_the_scan_crossings);
+  RUN_TEST(test_old_scan_finds_the_scan_crossings);
+  RUN_TEST(test_search_finds_a_short_pass);
+  RUN_TEST(benchmark_search);
+  return UNITY_END();
+
+}
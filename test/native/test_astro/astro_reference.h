@@ -0,0 +1,53 @@
+// generated by test/native/reference/astro_reference.py, don't edit
+
+// year, month, day, hour, minute, latitude, longitude, sun azimuth, elevation, moon azimuth, elevation
+const struct astro_reference_vector astro_reference_vectors[] = {
+  {2022,  3,  1, 12,  0,  40.889958,  -75.585972,  103.0903,   3.5522,  119.8775,   4.7832},
+  {2026, 10, 17,  3, 20, -33.920000,   18.420000,  107.8657,  -9.3695,  183.9501, -29.5400},
+  {2030,  6, 21, 18,  0,  64.840000, -147.720000,  109.0066,  34.4378,  227.4542,  17.2584},
+  {2020,  6, 21, 18,  0,  35.680000,  139.770000,   45.9725, -14.7316,   40.9474, -18.6813},
+  {2024,  4,  8, 18, 18,  30.000000, -100.000000,  164.9068,  66.9157,  165.1294,  66.8576},
+  {2026,  1,  1,  0,  0, -77.850000,  166.670000,   15.9105,  34.7537,  153.3774, -38.2178},
+  {2025,  9,  7, 18, 30,  51.480000,    0.000000,  279.8669,  -0.4690,   99.7410,  -0.8172},
+  {2028, 12, 21,  9, 45,   0.000000,  -60.000000,  113.4713,  -3.0474,  106.6281, -66.0075},
+};
+
+const char astro_reference_iss_line_1[] = "1 25544U 98067A   08264.51782528 -.00002182  00000-0 -11606-4 0  2927";
+const char astro_reference_iss_line_2[] = "2 25544  51.6416 247.4627 0006703 130.5360 325.0288 15.72125391563537";
+
+// seconds after 2008-09-20 00:00 UTC, latitude, longitude, height (m), azimuth, elevation
+// first pass after the epoch for each observer: AOS, halfway up, highest, halfway down, LOS
+const struct astro_reference_satellite_vector astro_reference_iss_pass_vectors[] = {
+  { 82169,  40.889958,  -75.585972,  50,  188.2979,   0.0139},
+  { 82293,  40.889958,  -75.585972,  50,  168.7811,   7.1802},
+  { 82418,  40.889958,  -75.585972,  50,  130.4807,  12.0522},
+  { 82543,  40.889958,  -75.585972,  50,   92.2774,   7.1910},
+  { 82668,  40.889958,  -75.585972,  50,   72.7995,  -0.0132},
+  { 47815, -33.920000,   18.420000,  10,  230.5458,   0.0160},
+  { 47966, -33.920000,   18.420000,  10,  235.8672,  13.4899},
+  { 48118, -33.920000,   18.420000,  10,  314.8459,  58.1746},
+  { 48267, -33.920000,   18.420000,  10,   32.4771,  13.5498},
+  { 48416, -33.920000,   18.420000,  10,   38.0209,  -0.0136},
+  { 50129,  35.680000,  139.770000,  40,  333.4828,   0.0065},
+  { 50216,  35.680000,  139.770000,  40,  349.8684,   2.6618},
+  { 50304,  35.680000,  139.770000,  40,   10.1251,   3.7798},
+  { 50392,  35.680000,  139.770000,  40,   30.4290,   2.6791},
+  { 50480,  35.680000,  139.770000,  40,   47.0676,  -0.0118},
+};
+
+// on the hour, mostly below the horizon
+const struct astro_reference_satellite_vector astro_reference_iss_vectors[] = {
+  { 57600,  40.889958,  -75.585972,  50,  236.2600, -46.7260},
+  { 72000, -33.920000,   18.420000,  10,    3.2689, -40.9288},
+  { 90000,  35.680000,  139.770000,  40,  267.8554, -43.4923},
+  {100800,  40.889958,  -75.585972,  50,   95.0679, -34.1223},
+  {111600, -33.920000,   18.420000,  10,  292.5076, -41.8854},
+  {122400,  35.680000,  139.770000,  40,   57.6724, -43.2384},
+};
+
+// AOS and LOS, seconds after 2008-09-20 00:00 UTC, latitude, longitude, height (m)
+const struct astro_reference_aos_los astro_reference_iss_aos_los[] = {
+  {82168.739, 82667.750,  40.889958,  -75.585972,  50},
+  {47814.743, 48415.785, -33.920000,   18.420000,  10},
+  {50128.816, 50479.666,  35.680000,  139.770000,  40},
+};
@@ -0,0 +1,353 @@
+// Native tests for the sun, moon, and satellite libraries (lib/sunpos, lib/moon2, lib/P13), run on the PC with
+//
+//   pio test -e native
+//
+// The reference positions in astro_reference.h come from test/native/reference/astro_reference.py, which works
+// them out with its own implementations of Meeus and SGP4 rather than with the code under test.  The tolerances
+// are what each library's method is good for, not what it happens to give today: sunpos is the PSA algorithm
+// (0.5 arc minute), moon2 is Schlyter's method (a couple of arc minutes), and P13 leaves out SGP4's short period
+// terms, which are several km along the track; that's over a degree on a pass close overhead, and a few seconds
+// at AOS and LOS.
+//
+// The benchmarks print the time per call on the PC, which is only good for comparing one version of a library
+// with another; the Mega is around 1000 times slower and runs double as float.
+
+#include <unity.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "sunpos.h"
+#include "moon2.h"
+#include "P13.h"
+
+#define SUN_TOLERANCE 0.02
+#define MOON_TOLERANCE 0.1
+#define SATELLITE_TOLERANCE 1.5
+#define SATELLITE_AOS_LOS_TOLERANCE_SECS 10
+#define BENCHMARK_CALLS 20000
+
+struct astro_reference_vector {
+  int year;
+  int month;
+  int day;
+  int hour;
+  int minute;
+  double latitude;
+  double longitude;
+  double sun_azimuth;
+  double sun_elevation;
+  double moon_azimuth;
+  double moon_elevation;
+};
+
+struct astro_reference_satellite_vector {
+  long seconds;             // after 2008-09-20 00:00 UTC
+  double latitude;
+  double longitude;
+  int height_m;
+  double azimuth;
+  double elevation;
+};
+
+struct astro_reference_aos_los {
+  double aos;               // seconds after 2008-09-20 00:00 UTC
+  double los;
+  double latitude;
+  double longitude;
+  int height_m;
+};
+
+#include "astro_reference.h"
+
+#define VECTOR_COUNT(v) ((int)(sizeof(v) / sizeof(v[0])))
+
+void setUp(){}
+
+void tearDown(){}
+
+// --------------------------------------------------------------
+
+void assert_az_el(double azimuth, double elevation, double expected_azimuth, double expected_elevation, double tolerance, const char *what, int vector){
+
+  char message[80];
+  double azimuth_error = azimuth - expected_azimuth;
+
+  if (azimuth_error > 180){azimuth_error = azimuth_error - 360;}
+  if (azimuth_error < -180){azimuth_error = azimuth_error + 360;}
+
+  // an azimuth error near the zenith is no error on the sky
+  azimuth_error = azimuth_error * cos(expected_elevation * DEG_TO_RAD);
+
+  snprintf(message, sizeof(message), "%s vector %d azimuth", what, vector);
+  TEST_ASSERT_FLOAT_WITHIN_MESSAGE(tolerance, 0, azimuth_error, message);
+  snprintf(message, sizeof(message), "%s vector %d elevation", what, vector);
+  TEST_ASSERT_FLOAT_WITHIN_MESSAGE(tolerance, expected_elevation, elevation, message);
+
+}
+
+// --------------------------------------------------------------
+
+void report_benchmark(const char *what, clock_t start){
+
+  char message[80];
+
+  snprintf(message, sizeof(message), "%s: %.2f uS per call", what, ((double)(clock() - start) * 1000000.0 / CLOCKS_PER_SEC) / BENCHMARK_CALLS);
+  TEST_MESSAGE(message);
+
+}
+
+// --------------------------------------------------------------
+
+void sun_az_el(const struct astro_reference_vector &v, double &azimuth, double &elevation){
+
+  cTime time;
+  cLocation location;
+  cSunCoordinates coordinates;
+
+  time.iYear = v.year;
+  time.iMonth = v.month;
+  time.iDay = v.day;
+  time.dHours = v.hour;
+  time.dMinutes = v.minute;
+  time.dSeconds = 0;
+  location.dLatitude = v.latitude;
+  location.dLongitude = v.longitude;
+  sunpos(time, location, &coordinates);
+  azimuth = coordinates.dAzimuth;
+  elevation = 90 - coordinates.dZenithAngle;
+
+}
+
+// --------------------------------------------------------------
+
+void moon_az_el(const struct astro_reference_vector &v, double &azimuth, double &elevation){
+
+  double RA, Dec, topRA, topDec, LST, HA, dist;
+
+  moon2(v.year, v.month, v.day, v.hour + (v.minute / 60.0), v.longitude, v.latitude, &RA, &Dec, &topRA, &topDec, &LST, &HA, &azimuth, &elevation, &dist);
+
+}
+
+// --------------------------------------------------------------
+
+void satellite_time(SatDateTime &time, double seconds){
+
+  time.settime(2008, 9, 20, 0, 0, 0);
+  time.add(seconds / 86400.0);
+
+}
+
+// --------------------------------------------------------------
+
+double satellite_elevation(Satellite &satellite, Observer &observer, double seconds){
+
+  SatDateTime time;
+  double azimuth, elevation;
+
+  satellite_time(time, seconds);
+  satellite.predict(time);
+  satellite.altaz(observer, elevation, azimuth);
+  return elevation;
+
+}
+
+// --------------------------------------------------------------
+
+void test_sunpos(){
+
+  double azimuth, elevation;
+
+  for (int x = 0; x < VECTOR_COUNT(astro_reference_vectors); x++){
+    sun_az_el(astro_reference_vectors[x], azimuth, elevation);
+    assert_az_el(azimuth, elevation, astro_reference_vectors[x].sun_azimuth, astro_reference_vectors[x].sun_elevation, SUN_TOLERANCE, "sunpos", x);
+  }
+
+}
+
+// --------------------------------------------------------------
+
+void test_moon2(){
+
+  double azimuth, elevation;
+
+  for (int x = 0; x < VECTOR_COUNT(astro_reference_vectors); x++){
+    moon_az_el(astro_reference_vectors[x], azimuth, elevation);
+    assert_az_el(azimuth, elevation, astro_reference_vectors[x].moon_azimuth, astro_reference_vectors[x].moon_elevation, MOON_TOLERANCE, "moon2", x);
+  }
+
+}
+
+// --------------------------------------------------------------
+
+void check_satellite_vectors(const struct astro_reference_satellite_vector *vectors, int count, const char *what){
+
+  Satellite satellite("ISS", astro_reference_iss_line_1, astro_reference_iss_line_2);
+  Observer observer("", 0, 0, 0);
+  SatDateTime time;
+  double azimuth, elevation;
+
+  for (int x = 0; x < count; x++){
+    observer.update_location("", vectors[x].latitude, vectors[x].longitude, vectors[x].height_m);
+    satellite_time(time, vectors[x].seconds);
+    satellite.predict(time);
+    satellite.altaz(observer, elevation, azimuth);
+    assert_az_el(azimuth, elevation, vectors[x].azimuth, vectors[x].elevation, SATELLITE_TOLERANCE, what, x);
+  }
+
+}
+
+// --------------------------------------------------------------
+
+void test_p13_pass(){
+
+  check_satellite_vectors(astro_reference_iss_pass_vectors, VECTOR_COUNT(astro_reference_iss_pass_vectors), "P13 pass");
+
+}
+
+// --------------------------------------------------------------
+
+void test_p13_below_horizon(){
+
+  check_satellite_vectors(astro_reference_iss_vectors, VECTOR_COUNT(astro_reference_iss_vectors), "P13");
+
+}
+
+// --------------------------------------------------------------
+
+void test_p13_aos_los(){
+
+  // bisect P13's own horizon crossings either side of the reference AOS and LOS
+
+  Satellite satellite("ISS", astro_reference_iss_line_1, astro_reference_iss_line_2);
+  Observer observer("", 0, 0, 0);
+  char message[80];
+
+  for (int x = 0; x < VECTOR_COUNT(astro_reference_iss_aos_los); x++){
+    observer.update_location("", astro_reference_iss_aos_los[x].latitude, astro_reference_iss_aos_los[x].longitude, astro_reference_iss_aos_los[x].height_m);
+    for (int event = 0; event < 2; event++){
+      double reference = (event == 0) ? astro_reference_iss_aos_los[x].aos : astro_reference_iss_aos_los[x].los;
+      double low = reference - 120;
+      double high = reference + 120;
+      snprintf(message, sizeof(message), "P13 %s %d not bracketed", (event == 0) ? "AOS" : "LOS", x);
+      TEST_ASSERT_TRUE_MESSAGE((satellite_elevation(satellite, observer, low) > 0) == (event != 0), message);
+      TEST_ASSERT_TRUE_MESSAGE((satellite_elevation(satellite, observer, high) > 0) == (event == 0), message);
+      while ((high - low) > 0.1){
+        double middle = (low + high) / 2;
+        if ((satellite_elevation(satellite, observer, middle) > 0) == (event == 0)){
+          high = middle;
+        } else {
+          low = middle;
+        }
+      }
+      snprintf(message, sizeof(message), "P13 %s %d time", (event == 0) ? "AOS" : "LOS", x);
+      TEST_ASSERT_FLOAT_WITHIN_MESSAGE(SATELLITE_AOS_LOS_TOLERANCE_SECS, reference, low, message);
+    }
+  }
+
+}
+
+// --------------------------------------------------------------
+
+double predict_all_azimuth[3];
+double predict_all_elevation[3];
+
+void predict_all_result(int n, double alt, double az, double lat, double lng){
+
+  predict_all_azimuth[n] = az;
+  predict_all_elevation[n] = alt;
+
+}
+
+void test_p13_predict_all(){
+
+  // Satellite::predict_all() with elements from SatElements::tle() and packed() gives the same as predict(),
+  // and leaves any other Satellite alone
+
+  Satellite satellite("ISS", astro_reference_iss_line_1, astro_reference_iss_line_2);
+  Satellite bystander("ISS", astro_reference_iss_line_1, astro_reference_iss_line_2);
+  Observer observer("", astro_reference_iss_pass_vectors[2].latitude, astro_reference_iss_pass_vectors[2].longitude, astro_reference_iss_pass_vectors[2].height_m);
+  SatElements elements[3];
+  SatDateTime time;
+  double azimuth, elevation;
+
+  elements[0].tle(astro_reference_iss_line_1, astro_reference_iss_line_2);
+  satellite.get_elements(elements[1]);
+  elements[2] = elements[0];
+  satellite_time(time, astro_reference_iss_pass_vectors[2].seconds);
+  Satellite::predict_all(time, observer, elements, NULL, 3, predict_all_result);
+  satellite.predict(time);
+  satellite.altaz(observer, elevation, azimuth);
+  for (int x = 0; x < 3; x++){
+    TEST_ASSERT_FLOAT_WITHIN(0.0001, azimuth, predict_all_azimuth[x]);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001, elevation, predict_all_elevation[x]);
+  }
+  TEST_ASSERT_TRUE(strcmp(bystander.name, "ISS") == 0);
+
+}
+
+// --------------------------------------------------------------
+
+void benchmark_sunpos(){
+
+  double azimuth, elevation;
+  clock_t start = clock();
+
+  for (long x = 0; x < BENCHMARK_CALLS; x++){
+    sun_az_el(astro_reference_vectors[x % VECTOR_COUNT(astro_reference_vectors)], azimuth, elevation);
+  }
+  report_benchmark("sunpos()", start);
+
+}
+
+// --------------------------------------------------------------
+
+void benchmark_moon2(){
+
+  double azimuth, elevation;
+  clock_t start = clock();
+
+  for (long x = 0; x < BENCHMARK_CALLS; x++){
+    moon_az_el(astro_reference_vectors[x % VECTOR_COUNT(astro_reference_vectors)], azimuth, elevation);
+  }
+  report_benchmark("moon2()", start);
+
+}
+
+// --------------------------------------------------------------
+
+void benchmark_p13(){
+
+  Satellite satellite("ISS", astro_reference_iss_line_1, astro_reference_iss_line_2);
+  Observer observer("", astro_reference_iss_pass_vectors[0].latitude, astro_reference_iss_pass_vectors[0].longitude, astro_reference_iss_pass_vectors[0].height_m);
+  SatDateTime time;
+  double azimuth, elevation;
+  clock_t start;
+
+  satellite_time(time, astro_reference_iss_pass_vectors[0].seconds);
+  start = clock();
+  for (long x = 0; x < BENCHMARK_CALLS; x++){
+    time.add(1 / 86400.0);
+    satellite.predict(time);
+    satellite.altaz(observer, elevation, azimuth);
+  }
+  report_benchmark("Satellite::predict() and altaz()", start);
+
+}
+
+// --------------------------------------------------------------
+
+int main(int argc, char **argv){
+
+  UNITY_BEGIN();
+  RUN_TEST(test_sunpos);
+  RUN_TEST(test_moon2);
+  RUN_TEST(test_p13_pass);
+  RUN_TEST(test_p13_below_horizon);
+  RUN_TEST(test_p13_aos_los);
+  RUN_TEST(test_p13_predict_all);
+  RUN_TEST(benchmark_sunpos);
+  RUN_TEST(benchmark_moon2);
+  RUN_TEST(benchmark_p13);
+  return UNITY_END();
+
+}
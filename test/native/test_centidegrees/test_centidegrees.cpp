@@ -0,0 +1,305 @@
+// Native tests for the integer heading pipeline in lib/centidegrees, run on the PC with
+//
+//   pio test -e native
+//
+// The reference is the float pipeline read_azimuth() and read_elevation() had for potentiometers before:
+// float_map(), the azimuth or elevation offset, the AZIMUTH_SMOOTHING_FACTOR blend, and the 0 - 359 wrap, all
+// in float as on the Mega.  Over random calibrations, offsets, smoothing factors and readings the integer
+// pipeline has to come out within a centidegree of it, give or take float rounding.
+//
+// The benchmark is per sample on the PC, which does float in hardware; on the Mega every float step in the
+// old pipeline is a software routine, so there the difference is much bigger.
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#include "centidegrees.h"
+
+#define PIPELINE_TOLERANCE 0.011       // degrees: one centidegree, and the float reference's own rounding
+#define PIPELINE_TRIALS 1000000L
+#define BENCHMARK_SAMPLES 2000000L
+#define ADC_FULL_SCALE 1024L
+
+// from rotator.h
+#define SMOOTHING_WEIGHT(factor) ((long)(((factor) * 83886.08) + 0.5))
+
+void setUp(){}
+
+void tearDown(){}
+
+// --------------------------------------------------------------
+
+unsigned long random_state = 12345;
+
+long random_between(long low, long high){
+
+  // a fixed sequence, so a failure can be repeated
+
+  random_state = (random_state * 1103515245UL + 12345UL) & 0x7fffffffUL;
+  return low + (long)(random_state % (unsigned long)(high - low + 1));
+
+}
+
+// --------------------------------------------------------------
+
+float float_map(float x, float in_min, float in_max, float out_min, float out_max){
+
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+
+}
+
+// --------------------------------------------------------------
+
+float float_azimuth(int analog, int full_ccw, int full_cw, int starting_point, int rotation_capability, float offset, float smoothing_factor, unsigned int previous_raw_azimuth){
+
+  float raw_azimuth = float_map(analog, full_ccw, full_cw, starting_point, (starting_point + rotation_capability));
+
+  if (offset < 0){
+    raw_azimuth = raw_azimuth + (2.0 * offset);
+  }
+  if (smoothing_factor > 0){
+    if (raw_azimuth < 0){raw_azimuth = 0;}
+    raw_azimuth = (raw_azimuth * ((float)1 - (smoothing_factor / (float)100))) + ((float)previous_raw_azimuth * (smoothing_factor / (float)100));
+  }
+  if (raw_azimuth >= 360){
+    return raw_azimuth - float(int(raw_azimuth / 360) * 360.0);
+  }
+  if (raw_azimuth < 0){
+    return raw_azimuth + 360.0;
+  }
+  return raw_azimuth;
+
+}
+
+// --------------------------------------------------------------
+
+int32_t azimuth_offset_centidegrees(float offset){
+
+  // as apply_azimuth_offset_centidegrees()
+
+  if (offset < 0){
+    return degrees_to_centidegrees(2.0 * offset);
+  }
+  return 0;
+
+}
+
+// --------------------------------------------------------------
+
+float integer_azimuth(analog_heading_map &map, int analog, int full_ccw, int full_cw, int starting_point, int rotation_capability, int32_t offset_centidegrees, long smoothing_weight, unsigned int previous_raw_azimuth){
+
+  // offset_centidegrees is worked out from the offset when it changes, as apply_azimuth_offset_centidegrees() does
+
+  int32_t raw_centidegrees = map_analog_to_centidegrees(map, analog, full_ccw, full_cw, starting_point * 100L, (starting_point + rotation_capability) * 100L, ADC_FULL_SCALE);
+
+  raw_centidegrees = raw_centidegrees + offset_centidegrees;
+  if (smoothing_weight > 0){
+    raw_centidegrees = smooth_centidegrees(raw_centidegrees, previous_raw_azimuth * 100L, smoothing_weight);
+  }
+  return centidegrees_to_degrees(wrap_centidegrees(raw_centidegrees));
+
+}
+
+// --------------------------------------------------------------
+
+float float_elevation(int analog, int analog_0_degrees, int analog_max_elevation, int maximum_degrees, float offset, float smoothing_factor, unsigned int previous_elevation){
+
+  float elevation = float_map(analog, analog_0_degrees, analog_max_elevation, 0, maximum_degrees);
+
+  elevation = elevation + offset;
+  if (smoothing_factor > 0){
+    if (elevation < 0){elevation = 0;}
+    elevation = (elevation * ((float)1 - (smoothing_factor / (float)100))) + ((float)previous_elevation * (smoothing_factor / (float)100));
+  }
+  if (elevation < 0){
+    elevation = 0;
+  }
+  return elevation;
+
+}
+
+// --------------------------------------------------------------
+
+float integer_elevation(analog_heading_map &map, int analog, int analog_0_degrees, int analog_max_elevation, int maximum_degrees, int32_t offset_centidegrees, long smoothing_weight, unsigned int previous_elevation){
+
+  int32_t centidegrees = map_analog_to_centidegrees(map, analog, analog_0_degrees, analog_max_elevation, 0, maximum_degrees * 100L, ADC_FULL_SCALE);
+
+  centidegrees = centidegrees + offset_centidegrees;
+  if (smoothing_weight > 0){
+    centidegrees = smooth_centidegrees(centidegrees, previous_elevation * 100L, smoothing_weight);
+  }
+  if (centidegrees < 0){
+    centidegrees = 0;
+  }
+  return centidegrees_to_degrees(centidegrees);
+
+}
+
+// --------------------------------------------------------------
+
+double heading_difference(double a, double b){
+
+  double difference = fabs(a - b);
+
+  if (difference > 180){difference = 360 - difference;}
+  return difference;
+
+}
+
+// --------------------------------------------------------------
+
+void test_azimuth_pipeline(){
+
+  analog_heading_map map = {0, 0, 0, 0, 0, 0, 0};
+  double worst = 0;
+  char message[160];
+
+  for (long trial = 0; trial < PIPELINE_TRIALS; trial++){
+    int full_ccw = random_between(0, 200);
+    int full_cw = random_between(800, ADC_FULL_SCALE - 1);
+    if (random_between(0, 3) == 0){  // wired backwards
+      int swap = full_ccw;
+      full_ccw = full_cw;
+      full_cw = swap;
+    }
+    int starting_point = random_between(0, 359);
+    int rotation_capability = random_between(180, 450);
+    float offset = (random_between(0, 2) == 0) ? random_between(-1000, 1000) / 100.0 : 0;
+    float smoothing_factor = (random_between(0, 1) == 0) ? random_between(1, 99) : 0;
+    int analog = random_between(0, ADC_FULL_SCALE - 1);
+    unsigned int previous = random_between(0, 450);
+    double expected = float_azimuth(analog, full_ccw, full_cw, starting_point, rotation_capability, offset, smoothing_factor, previous);
+    double got = integer_azimuth(map, analog, full_ccw, full_cw, starting_point, rotation_capability, azimuth_offset_centidegrees(offset), SMOOTHING_WEIGHT(smoothing_factor), previous);
+    double difference = heading_difference(expected, got);
+    if (difference > worst){worst = difference;}
+    if (difference > PIPELINE_TOLERANCE){
+      snprintf(message, sizeof(message), "analog %d calibration %d-%d start %d rotation %d offset %.2f smoothing %.0f previous %u: float %.4f integer %.4f",
+        analog, full_ccw, full_cw, starting_point, rotation_capability, offset, smoothing_factor, previous, expected, got);
+      TEST_ASSERT_TRUE_MESSAGE(0, message);
+    }
+  }
+  snprintf(message, sizeof(message), "azimuth: worst difference from the float pipeline %.4f degrees", worst);
+  TEST_MESSAGE(message);
+
+}
+
+// --------------------------------------------------------------
+
+void test_elevation_pipeline(){
+
+  analog_heading_map map = {0, 0, 0, 0, 0, 0, 0};
+  double worst = 0;
+  char message[160];
+
+  for (long trial = 0; trial < PIPELINE_TRIALS; trial++){
+    int analog_0_degrees = random_between(0, 200);
+    int analog_max_elevation = random_between(800, ADC_FULL_SCALE - 1);
+    int maximum_degrees = (random_between(0, 1) == 0) ? 90 : 180;
+    float offset = (random_between(0, 2) == 0) ? random_between(-500, 500) / 100.0 : 0;
+    float smoothing_factor = (random_between(0, 1) == 0) ? random_between(1, 99) : 0;
+    int analog = random_between(0, ADC_FULL_SCALE - 1);
+    unsigned int previous = random_between(0, maximum_degrees);
+    double expected = float_elevation(analog, analog_0_degrees, analog_max_elevation, maximum_degrees, offset, smoothing_factor, previous);
+    double got = integer_elevation(map, analog, analog_0_degrees, analog_max_elevation, maximum_degrees, degrees_to_centidegrees(offset), SMOOTHING_WEIGHT(smoothing_factor), previous);
+    double difference = fabs(expected - got);
+    if (difference > worst){worst = difference;}
+    if (difference > PIPELINE_TOLERANCE){
+      snprintf(message, sizeof(message), "analog %d calibration %d-%d maximum %d offset %.2f smoothing %.0f previous %u: float %.4f integer %.4f",
+        analog, analog_0_degrees, analog_max_elevation, maximum_degrees, offset, smoothing_factor, previous, expected, got);
+      TEST_ASSERT_TRUE_MESSAGE(0, message);
+    }
+  }
+  snprintf(message, sizeof(message), "elevation: worst difference from the float pipeline %.4f degrees", worst);
+  TEST_MESSAGE(message);
+
+}
+
+// --------------------------------------------------------------
+
+void test_map_full_adc_range(){
+
+  // from a plain 10 bit ADC to the widest readings the controller can have (14 bit ADC with three bits from
+  // oversampling), and down to calibrations only a count wide, the map stays within a centidegree
+
+  const int32_t full_scales[] = {1L << 10, 1L << 13, 1L << 14, 1L << 17};
+  const int32_t spans[] = {9000, 18000, 36000, 45000};
+  char message[120];
+
+  for (unsigned int f = 0; f < sizeof(full_scales) / sizeof(full_scales[0]); f++){
+    int32_t full_scale = full_scales[f];
+    const int32_t calibrations[][2] = {{0, full_scale - 1}, {full_scale - 1, 0}, {full_scale / 10, full_scale - (full_scale / 10)}, {0, 1}, {full_scale / 2, (full_scale / 2) - 3}};
+    for (unsigned int c = 0; c < sizeof(calibrations) / sizeof(calibrations[0]); c++){
+      for (unsigned int s = 0; s < sizeof(spans) / sizeof(spans[0]); s++){
+        analog_heading_map map = {0, 0, 0, 0, 0, 0, 0};
+        for (long analog = 0; analog < full_scale; analog = analog + 1 + (full_scale / 4096)){
+          double exact = ((double)(analog - calibrations[c][0]) * spans[s]) / (calibrations[c][1] - calibrations[c][0]);
+          int32_t got = map_analog_to_centidegrees(map, analog, calibrations[c][0], calibrations[c][1], 0, spans[s], full_scale);
+          if (fabs(exact) < 2000000000.0){  // (a calibration a few counts wide maps the far end of the ADC off the end of 32 bits)
+            snprintf(message, sizeof(message), "full scale %ld calibration %ld-%ld span %ld analog %ld", (long)full_scale, (long)calibrations[c][0], (long)calibrations[c][1], (long)spans[s], analog);
+            TEST_ASSERT_FLOAT_WITHIN_MESSAGE(1.000001, exact, got, message);
+          }
+        }
+      }
+    }
+  }
+
+}
+
+// --------------------------------------------------------------
+
+void test_smoothing_wild_reading(){
+
+  // a reading far from the previous one (over 655 degrees) takes the long long path, and still comes out right
+
+  int32_t got = smooth_centidegrees(0, 100000, SMOOTHING_WEIGHT(50));
+
+  TEST_ASSERT_EQUAL_INT(50000, got);
+  TEST_ASSERT_EQUAL_INT(0, smooth_centidegrees(-500, 0, SMOOTHING_WEIGHT(50)));
+  TEST_ASSERT_EQUAL_INT(35999, wrap_centidegrees(-1));
+  TEST_ASSERT_EQUAL_INT(500, wrap_centidegrees(72500));
+
+}
+
+// --------------------------------------------------------------
+
+void benchmark_pipeline(){
+
+  analog_heading_map map = {0, 0, 0, 0, 0, 0, 0};
+  int32_t offset_centidegrees = azimuth_offset_centidegrees(-1.5);
+  volatile float sink = 0;
+  double float_us, integer_us;
+  char message[120];
+  clock_t start;
+
+  start = clock();
+  for (long x = 0; x < BENCHMARK_SAMPLES; x++){
+    sink = float_azimuth(x & 1023, 50, 970, 180, 450, -1.5, 50, 200);
+  }
+  float_us = ((double)(clock() - start) * 1000000.0 / CLOCKS_PER_SEC) / BENCHMARK_SAMPLES;
+  start = clock();
+  for (long x = 0; x < BENCHMARK_SAMPLES; x++){
+    sink = integer_azimuth(map, x & 1023, 50, 970, 180, 450, offset_centidegrees, SMOOTHING_WEIGHT(50), 200);
+  }
+  integer_us = ((double)(clock() - start) * 1000000.0 / CLOCKS_PER_SEC) / BENCHMARK_SAMPLES;
+  (void)sink;
+  snprintf(message, sizeof(message), "azimuth per sample: float pipeline %.4f uS, integer pipeline %.4f uS", float_us, integer_us);
+  TEST_MESSAGE(message);
+
+}
+
+// --------------------------------------------------------------
+
+int main(int argc, char **argv){
+
+  UNITY_BEGIN();
+  RUN_TEST(test_azimuth_pipeline);
+  RUN_TEST(test_elevation_pipeline);
+  RUN_TEST(test_map_full_adc_range);
+  RUN_TEST(test_smoothing_wild_reading);
+  RUN_TEST(benchmark_pipeline);
+  return UNITY_END();
+
+}
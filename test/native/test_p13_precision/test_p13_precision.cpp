@@ -0,0 +1,183 @@
+// Native tests for the P13_SINGLE_PRECISION build of lib/P13 against the double one, run on the PC with
+//
+//   pio test -e native
+//
+// The library P13.h is the double build; P13.cpp is included again below in a namespace of its own with
+// P13_SINGLE_PRECISION defined, so both are in the same program.  Each satellite is predicted every 30 seconds
+// for the week after its TLE epoch, and above the horizon the single precision pointing has to stay within
+// 0.1 degrees of the double one, which is what the uno_r4_minima_fast build relies on.
+//
+// The benchmark is only good for seeing the two are in the same league: the PC does double in hardware, the
+// UNO R4 only does float.
+
+#include <unity.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "P13.h"
+
+namespace p13_single {
+  #define P13_SINGLE_PRECISION
+  #include "P13.cpp"
+  #undef P13_SINGLE_PRECISION
+}
+
+#define PRECISION_TOLERANCE 0.1
+#define PRECISION_STEP_SECS 30
+#define PRECISION_DAYS 7
+#define BENCHMARK_CALLS 200000
+
+struct precision_test_satellite {
+  const char *name;
+  const char *line_1;
+  const char *line_2;
+  int year;               // TLE epoch day
+  int month;
+  int day;
+};
+
+struct precision_test_observer {
+  double latitude;
+  double longitude;
+  int height_m;
+};
+
+// from lib/tle/nasabare.txt, and the ISS elements test_astro uses
+const struct precision_test_satellite precision_test_satellites[] = {
+  {"AO-07", "1 07530U 74089B   20205.48277872 -.00000043  00000-0  13494-4 0  9990",
+            "2 07530 101.8018 175.0260 0011861 296.2265 184.6086 12.53644244090508", 2020, 7, 23},
+  {"UO-11", "1 14781U 84021B   20205.45028052  .00000011  00000-0  73722-5 0  9999",
+            "2 14781 097.5894 215.6333 0010059 084.2955 275.9406 14.83179338937162", 2020, 7, 23},
+  {"HUBBLE", "1 20580U 90037B   20205.79346029  .00000335  00000-0  93875-5 0  9991",
+             "2 20580  28.4701  79.3049 0002843 122.0282 332.3461 15.09408263461545", 2020, 7, 23},
+  {"FO-29", "1 24278U 96046B   20205.54750867  .00000001  00000-0  40493-4 0  9994",
+            "2 24278 098.5868 310.6584 0349296 281.4372 074.7736 13.53098180181761", 2020, 7, 23},
+  {"ISS", "1 25544U 98067A   08264.51782528 -.00002182  00000-0 -11606-4 0  2927",
+          "2 25544  51.6416 247.4627 0006703 130.5360 325.0288 15.72125391563537", 2008, 9, 20},
+};
+
+const struct precision_test_observer precision_test_observers[] = {
+  {40.0, -75.0, 100},
+  {35.7, 139.7, 40},
+  {-33.9, 151.2, 0},
+  {0.0, 100.0, 0},
+};
+
+#define COUNT_OF(v) ((int)(sizeof(v) / sizeof(v[0])))
+
+void setUp(){}
+
+void tearDown(){}
+
+// --------------------------------------------------------------
+
+double angle_difference(double a, double b){
+
+  double difference = a - b;
+
+  if (difference > 180){difference = difference - 360;}
+  if (difference < -180){difference = difference + 360;}
+  return fabs(difference);
+
+}
+
+// --------------------------------------------------------------
+
+void test_single_precision_pointing(){
+
+  char message[100];
+  double worst_pointing = 0;
+  double worst_ground_track = 0;
+
+  for (int s = 0; s < COUNT_OF(precision_test_satellites); s++){
+    const struct precision_test_satellite &t = precision_test_satellites[s];
+    Satellite satellite(t.name, t.line_1, t.line_2);
+    p13_single::Satellite single_satellite(t.name, t.line_1, t.line_2);
+    for (int o = 0; o < COUNT_OF(precision_test_observers); o++){
+      const struct precision_test_observer &p = precision_test_observers[o];
+      Observer observer("", p.latitude, p.longitude, p.height_m);
+      p13_single::Observer single_observer("", p.latitude, p.longitude, p.height_m);
+      for (long seconds = 0; seconds < (PRECISION_DAYS * 86400L); seconds = seconds + PRECISION_STEP_SECS){
+        SatDateTime time(t.year, t.month, t.day, 0, 0, 0);
+        p13_single::SatDateTime single_time(t.year, t.month, t.day, 0, 0, 0);
+        double azimuth, elevation, latitude, longitude;
+        double single_azimuth, single_elevation, single_latitude, single_longitude;
+        time.add(seconds / 86400.0);
+        single_time.add(seconds / 86400.0);
+        satellite.predict(time);
+        single_satellite.predict(single_time);
+        satellite.altaz(observer, elevation, azimuth);
+        single_satellite.altaz(single_observer, single_elevation, single_azimuth);
+        if (o == 0){
+          satellite.LL(latitude, longitude);
+          single_satellite.LL(single_latitude, single_longitude);
+          double ground_track = fabs(latitude - single_latitude);
+          if ((angle_difference(longitude, single_longitude) * cos(latitude * DEG_TO_RAD)) > ground_track){
+            ground_track = angle_difference(longitude, single_longitude) * cos(latitude * DEG_TO_RAD);
+          }
+          if (ground_track > worst_ground_track){worst_ground_track = ground_track;}
+          snprintf(message, sizeof(message), "%s ground track at %ld seconds", t.name, seconds);
+          TEST_ASSERT_TRUE_MESSAGE(ground_track < PRECISION_TOLERANCE, message);
+        }
+        if (elevation > 0){
+          // an azimuth difference near the zenith is no difference on the sky
+          double pointing = angle_difference(azimuth, single_azimuth) * cos(elevation * DEG_TO_RAD);
+          if (fabs(elevation - single_elevation) > pointing){pointing = fabs(elevation - single_elevation);}
+          if (pointing > worst_pointing){worst_pointing = pointing;}
+          snprintf(message, sizeof(message), "%s observer %d pointing at %ld seconds", t.name, o, seconds);
+          TEST_ASSERT_TRUE_MESSAGE(pointing < PRECISION_TOLERANCE, message);
+        }
+      }
+    }
+  }
+  snprintf(message, sizeof(message), "worst single precision difference: pointing %.4f, ground track %.4f degrees", worst_pointing, worst_ground_track);
+  TEST_MESSAGE(message);
+
+}
+
+// --------------------------------------------------------------
+
+void benchmark_precision(){
+
+  const struct precision_test_satellite &t = precision_test_satellites[4];
+  const struct precision_test_observer &p = precision_test_observers[0];
+  Satellite satellite(t.name, t.line_1, t.line_2);
+  p13_single::Satellite single_satellite(t.name, t.line_1, t.line_2);
+  Observer observer("", p.latitude, p.longitude, p.height_m);
+  p13_single::Observer single_observer("", p.latitude, p.longitude, p.height_m);
+  SatDateTime time(t.year, t.month, t.day, 0, 0, 0);
+  p13_single::SatDateTime single_time(t.year, t.month, t.day, 0, 0, 0);
+  double azimuth, elevation;
+  double double_us, single_us;
+  char message[100];
+  clock_t start;
+
+  start = clock();
+  for (long x = 0; x < BENCHMARK_CALLS; x++){
+    time.add(1 / 86400.0);
+    satellite.predict(time);
+    satellite.altaz(observer, elevation, azimuth);
+  }
+  double_us = ((double)(clock() - start) * 1000000.0 / CLOCKS_PER_SEC) / BENCHMARK_CALLS;
+  start = clock();
+  for (long x = 0; x < BENCHMARK_CALLS; x++){
+    single_time.add(1 / 86400.0);
+    single_satellite.predict(single_time);
+    single_satellite.altaz(single_observer, elevation, azimuth);
+  }
+  single_us = ((double)(clock() - start) * 1000000.0 / CLOCKS_PER_SEC) / BENCHMARK_CALLS;
+  snprintf(message, sizeof(message), "predict() and altaz(): double %.3f uS, single precision %.3f uS per call", double_us, single_us);
+  TEST_MESSAGE(message);
+
+}
+
+// --------------------------------------------------------------
+
+int main(int argc, char **argv){
+
+  UNITY_BEGIN();
+  RUN_TEST(test_single_precision_pointing);
+  RUN_TEST(benchmark_precision);
+  return UNITY_END();
+
+}